@@ -7,6 +7,9 @@
 #include "Cherry/Core/Log.h"
 
 #include "Cherry/Core/TimeStep.h"
+#include "Cherry/Core/Clock.h"
+#include "Cherry/Core/JobSystem.h"
+#include "Cherry/Core/FrameAllocator.h"
 
 
 #include "Cherry/Core/Input.h"
@@ -15,14 +18,19 @@
 
 #include "Cherry/ImGui/ImGuiLayer.h"
 
+#include "Cherry/Debug/FlightRecorder.h"
+#include "Cherry/Debug/InputRecorder.h"
+
 //------------Renderer----------------
 #include "Cherry/Renderer/Renderer.h"
 #include "Cherry/Renderer/Renderer2D.h"
 #include "Cherry/Renderer/RenderCommand.h"
 
 #include "Cherry/Renderer/Shader.h"
+#include "Cherry/Renderer/Material.h"
 #include "Cherry/Renderer/Buffer.h"
 #include "Cherry/Renderer/Texture.h"
+#include "Cherry/Renderer/Framebuffer.h"
 #include "Cherry/Renderer/VertexArray.h"
 
 #include "Cherry/Renderer/Camera.h"
@@ -2,8 +2,13 @@
 #include "Application.h"
 #include "Cherry/Renderer/Buffer.h"
 #include "Cherry/Renderer/Renderer.h"
-#include <GLFW/glfw3.h>
-
+#include "Cherry/Core/VFS.h"
+#include "Cherry/Core/Clock.h"
+#include "Cherry/Core/Input.h"
+#include "Cherry/Core/JobSystem.h"
+#include "Cherry/Core/FrameAllocator.h"
+#include "Cherry/Debug/FlightRecorder.h"
+#include "Cherry/Debug/InputRecorder.h"
 
 namespace Cherry {
 
@@ -14,6 +19,16 @@ namespace Cherry {
         CH_PROFILE_FUNCTION();
 		CH_CORE_ASSERT(!s_Instance, "Application already exists!");
         s_Instance = this;
+
+        JobSystem::Init();
+        FrameAllocator::Init();
+
+        // Loose files under the working directory override anything packed
+        VFS::Init();
+        if (std::filesystem::exists("assets.chpak"))
+            VFS::MountPak("assets.chpak");
+        VFS::MountDirectory(".");
+
         m_Window = std::unique_ptr<Window>(Window::Create());
         m_Window->SetEventCallback(CH_BIND_EVENT_FN(Application::OnEvent));
 
@@ -21,6 +36,8 @@ namespace Cherry {
        
         m_ImGuiLayer = new ImGuiLayer();
         PushOverlay(m_ImGuiLayer);
+        m_ProfilerLayer = new ProfilerLayer();
+        PushOverlay(m_ProfilerLayer);
         CH_CORE_INFO("Application initialized successfully");
     }
 
@@ -33,8 +50,13 @@ namespace Cherry {
         // Note: m_ImGuiLayer is owned by LayerStack and will be deleted
         // when LayerStack destructor runs (after this destructor completes)
 
+        // Jobs still queued may use anything below
+        JobSystem::Shutdown();
+        FrameAllocator::Shutdown();
+
         // Shutdown renderer
         Renderer::Shutdown();
+        VFS::Shutdown();
 
         s_Instance = nullptr;
     }
@@ -44,6 +66,8 @@ namespace Cherry {
         CH_PROFILE_FUNCTION();
 
         m_LayerStack.PushLayer(layer);
+        m_EventRouter.Invalidate();
+        m_LayerScheduler.Invalidate();
         layer->OnAttach();
         CH_CORE_TRACE("Pushed Layer: {0}", layer->GetName());
     }
@@ -53,22 +77,50 @@ namespace Cherry {
         CH_PROFILE_FUNCTION();
 
         m_LayerStack.PushOverlay(layer);
+        m_EventRouter.Invalidate();
+        m_LayerScheduler.Invalidate();
         layer->OnAttach();
         CH_CORE_TRACE("Pushed Overlay: {0}", layer->GetName());
     }
 
+    void Application::SetFixedUpdateRate(double ticksPerSecond)
+    {
+        CH_CORE_ASSERT(ticksPerSecond > 0.0, "Fixed update rate must be positive!");
+        m_FixedStep = Clock::FromSeconds(1.0 / ticksPerSecond);
+    }
+
     void Application::OnEvent(Event& e)
+    {
+        // A replay drives input instead of the window
+        if (InputRecorder::IsSuperseded(e))
+            return;
+
+        // Wakes an idle loop whether or not the event waits in the queue
+        m_FramePacer.OnEvent(e);
+
+        if (m_EventQueue.IsImmediate(e.GetEventType()))
+            DispatchEvent(e);
+        else
+            m_EventQueue.Push(e);
+    }
+
+    void Application::DispatchEvent(Event& e)
     {
         CH_PROFILE_FUNCTION();
 
-        EventDispatcher dispatcher(e);
-        // Dispatch event to layers
-        for (auto it = m_LayerStack.end(); it != m_LayerStack.begin(); ) {
-            (*--it)->OnEvent(e);
-            if (e.Handled) break;
+        FlightRecorder::OnEvent(e);
+        // Input state follows the events even when a layer handles them
+        Input::OnEvent(e);
+        InputRecorder::OnEvent(e);
+
+        m_EventRouter.Dispatch(m_LayerStack, e);
+
+        switch (e.GetEventType())
+        {
+        case EventType::WindowClose:    OnWindowClose(static_cast<WindowCloseEvent&>(e)); break;
+        case EventType::WindowResize:   OnWindowResize(static_cast<WindowResizeEvent&>(e)); break;
+        default: break;
         }
-        dispatcher.Dispatch<WindowCloseEvent>(CH_BIND_EVENT_FN(Application::OnWindowClose));
-        dispatcher.Dispatch<WindowResizeEvent>(CH_BIND_EVENT_FN(Application::OnWindowResize));
     }
 
 
@@ -76,21 +128,61 @@ namespace Cherry {
     {
         CH_PROFILE_FUNCTION();
 
+        m_LastFrameTime = Clock::Now();
         while (m_Running)
         {
+            // Nothing wakes an on-demand loop during a replay
+            if (InputRecorder::IsReplaying())
+                m_FramePacer.RequestRedraw();
+            bool idled = m_FramePacer.WaitForNextFrame(*m_Window, m_Minimized);
+            int64_t workStart = Clock::Now();
+            m_ProfilerLayer->BeginFrame();
             CH_PROFILE_SCOPE("Run Loop");
+            FrameAllocator::BeginFrame();
 
-            float time = (float)glfwGetTime();
-            TimeStep timestep = time - m_LastFrameTime;
+            {
+                CH_PROFILE_SCOPE("Dispatch Events");
+                m_EventQueue.Dispatch([this](Event& e) { DispatchEvent(e); });
+                InputRecorder::ReplayEvents([this](Event& e) { DispatchEvent(e); });
+                Input::BeginFrame();
+            }
+
+            // After idling for a redraw the gap is not a frame: step by the nominal interval instead
+            int64_t time = Clock::Now();
+            int64_t elapsed = time - m_LastFrameTime;
+            int64_t frameTime = idled ? m_FramePacer.GetFrameInterval() : elapsed;
             m_LastFrameTime = time;
+            // Recorded sessions are stepped exactly as they were when recorded
+            frameTime = InputRecorder::OnFrame(frameTime, elapsed, m_LastFrameWork);
+            TimeStep timestep = (float)Clock::ToSeconds(frameTime);
 
             if (!m_Minimized)
             {
+                Renderer::BeginFrame();
+
+                {
+                    CH_PROFILE_SCOPE("LayerStack OnFixedUpdate");
+
+                    m_FixedAccumulator += frameTime;
+                    TimeStep fixedTimestep = (float)Clock::ToSeconds(m_FixedStep);
+                    uint32_t steps = 0;
+                    for (; m_FixedAccumulator >= m_FixedStep && steps < m_MaxFixedSteps; steps++)
+                    {
+                        for (Layer* layer : m_LayerStack)
+                            layer->OnFixedUpdate(fixedTimestep);
+                        m_FixedAccumulator -= m_FixedStep;
+                    }
+
+                    // Out of catch-up steps: the simulation falls behind wall time instead of spiralling
+                    if (m_FixedAccumulator >= m_FixedStep)
+                        m_FixedAccumulator %= m_FixedStep;
+                }
+
                 {
                     CH_PROFILE_SCOPE("LayerStack OnUpdate");
 
-                    for (Layer* layer : m_LayerStack)
-                        layer->OnUpdate(timestep);
+                    float alpha = (float)((double)m_FixedAccumulator / (double)m_FixedStep);
+                    m_LayerScheduler.Update(m_LayerStack, timestep, alpha);
                 }
                 m_ImGuiLayer->Begin();
                 // Render profiler UI
@@ -102,7 +194,13 @@ namespace Cherry {
                 }
                 m_ImGuiLayer->End();
             }
-                m_Window->OnUpdate();
+            m_LastFrameWork = Clock::Now() - workStart;
+            // Work time, so pacing and background throttling never look like hitches
+            if (!m_Minimized)
+            {
+                FlightRecorder::OnFrame((float)Clock::ToSeconds(m_LastFrameWork));
+            }
+            m_Window->OnUpdate();
         }
     }
 
@@ -3,12 +3,17 @@
 #include "Window.h"
 
 #include "Cherry/Core/LayerStack.h"
+#include "Cherry/Core/LayerScheduler.h"
 #include "Cherry/Events/Event.h"
 #include "Cherry/Events/ApplicationEvent.h"
+#include "Cherry/Events/EventQueue.h"
+#include "Cherry/Events/EventRouter.h"
 
 #include "Cherry/Core/TimeStep.h"
+#include "Cherry/Core/FramePacer.h"
 
 #include "Cherry/ImGui/ImGuiLayer.h"
+#include "Cherry/Debug/ProfilerLayer.h"
 #include "Cherry/OrthographicCameraController.h"
 
 namespace Cherry {
@@ -20,11 +25,30 @@ namespace Cherry {
 		Application();
 		virtual ~Application();
 		void Run();
+		// Window callback: queues the event for the next frame, or dispatches it now if its type is immediate
 		void OnEvent(Event& e);
 
 		void PushLayer(Layer* layer);
 		void PushOverlay(Layer* layer);
 
+		// Rate OnFixedUpdate runs at, 60 Hz by default
+		void SetFixedUpdateRate(double ticksPerSecond);
+		double GetFixedUpdateRate() const { return 1e9 / (double)m_FixedStep; }
+		// The same in nanoseconds per step, exactly
+		void SetFixedStep(int64_t nanoseconds) { m_FixedStep = nanoseconds; }
+		int64_t GetFixedStep() const { return m_FixedStep; }
+		// Fixed updates one frame may run to catch up; time beyond that is dropped rather than
+		// letting a slow frame cause ever more work
+		void SetMaxFixedSteps(uint32_t steps) { m_MaxFixedSteps = steps; }
+		uint32_t GetMaxFixedSteps() const { return m_MaxFixedSteps; }
+
+		// Ends the run loop after the current frame
+		void Close() { m_Running = false; }
+
+		// Frame rate caps, background throttling and on-demand redraw
+		inline FramePacer& GetFramePacer() { return m_FramePacer; }
+		inline EventQueue& GetEventQueue() { return m_EventQueue; }
+
 		inline Window& GetWindow() {
 			if (!m_Window)
 				throw std::runtime_error("Window is null");
@@ -33,17 +57,30 @@ namespace Cherry {
 		inline static Application& Get() { return *s_Instance; }
 
 	private:
+		void DispatchEvent(Event& e);
 		bool OnWindowClose(WindowCloseEvent& e);
 		bool OnWindowResize(WindowResizeEvent& e);
 
 	private:
 		std::unique_ptr<Window> m_Window;
 		ImGuiLayer* m_ImGuiLayer;
+		ProfilerLayer* m_ProfilerLayer;
 		bool m_Running = true;
 		LayerStack m_LayerStack;
-		float m_LastFrameTime = 0.0f;
+		int64_t m_LastFrameTime = 0;
+		// The previous frame's time outside the pacer wait and buffer swap
+		int64_t m_LastFrameWork = 0;
+
+		// Nanoseconds
+		int64_t m_FixedStep = 1'000'000'000 / 60;
+		int64_t m_FixedAccumulator = 0;
+		uint32_t m_MaxFixedSteps = 5;
 
 		bool m_Minimized = false;
+		FramePacer m_FramePacer;
+		EventQueue m_EventQueue;
+		EventRouter m_EventRouter;
+		LayerScheduler m_LayerScheduler;
 	private:
 		static Application* s_Instance;
 	};
@@ -0,0 +1,18 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace Cherry {
+
+	// Monotonic time in integer nanoseconds: exact however long the process runs, unlike float seconds
+	namespace Clock {
+
+		inline int64_t Now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		constexpr double ToSeconds(int64_t nanoseconds) { return (double)nanoseconds * 1e-9; }
+		constexpr int64_t FromSeconds(double seconds) { return (int64_t)(seconds * 1e9); }
+	}
+}
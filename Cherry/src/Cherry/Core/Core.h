@@ -16,8 +16,13 @@
 #else
 #define CHERRY_API
 #endif // CH_DYNAMIC_LINKING
+#define CH_DEBUGBREAK() __debugbreak()
+#elif defined(CH_PLATFORM_LINUX)
+#include <signal.h>
+#define CHERRY_API
+#define CH_DEBUGBREAK() raise(SIGTRAP)
 #else
-#error CHERRY ONLY SUPPORTS WINDOWS
+#error CHERRY ONLY SUPPORTS WINDOWS AND LINUX
 #endif // CH_PLATFORM_WINDOWS
 
 // =============================================================================
@@ -32,8 +37,8 @@
 // Assertion macros
 // =============================================================================
 #ifdef CH_ENABLE_ASSERTS
-#define CH_CLIENT_ASSERT(x, ...) { if(!(x)) { CH_CLIENT_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
-#define CH_CORE_ASSERT(x, ...) { if(!(x)) { CH_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); __debugbreak(); } }
+#define CH_CLIENT_ASSERT(x, ...) { if(!(x)) { CH_CLIENT_ERROR("Assertion Failed: {0}", __VA_ARGS__); CH_DEBUGBREAK(); } }
+#define CH_CORE_ASSERT(x, ...) { if(!(x)) { CH_CORE_ERROR("Assertion Failed: {0}", __VA_ARGS__); CH_DEBUGBREAK(); } }
 #else
 #define CH_CLIENT_ASSERT(x, ...)
 #define CH_CORE_ASSERT(x, ...)
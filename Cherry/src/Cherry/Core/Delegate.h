@@ -0,0 +1,48 @@
+#pragma once
+#include <functional>
+#include <utility>
+
+namespace Cherry {
+
+	template<typename Signature>
+	class Delegate;
+
+	// A non-owning callable: an object pointer and a function pointer, so copying or calling it never
+	// allocates, unlike std::function or std::bind. The target is fixed at compile time.
+	template<typename R, typename... Args>
+	class Delegate<R(Args...)>
+	{
+	public:
+		Delegate() = default;
+
+		// Callable is a member function of T, or a free function taking T* first
+		template<auto Callable, typename T>
+		static Delegate Bind(T* instance)
+		{
+			Delegate delegate;
+			delegate.m_Instance = instance;
+			delegate.m_Stub = [](void* instance, Args... args) -> R
+			{
+				return std::invoke(Callable, static_cast<T*>(instance), std::forward<Args>(args)...);
+			};
+			return delegate;
+		}
+
+		template<auto Function>
+		static Delegate Bind()
+		{
+			Delegate delegate;
+			delegate.m_Stub = [](void*, Args... args) -> R { return std::invoke(Function, std::forward<Args>(args)...); };
+			return delegate;
+		}
+
+		inline R operator()(Args... args) const { return m_Stub(m_Instance, std::forward<Args>(args)...); }
+
+		inline explicit operator bool() const { return m_Stub != nullptr; }
+		bool operator==(const Delegate& other) const = default;
+
+	private:
+		void* m_Instance = nullptr;
+		R(*m_Stub)(void*, Args...) = nullptr;
+	};
+}
@@ -1,7 +1,10 @@
 #pragma once
 #include "Cherry/Debug/Instrumentor.h"
+#include "Cherry/Debug/FlightRecorder.h"
+#include "Cherry/Debug/InputRecorder.h"
+#include "Cherry/Renderer/RendererAPI.h"
 
-#ifdef CH_PLATFORM_WINDOWS
+#if defined(CH_PLATFORM_WINDOWS) || defined(CH_PLATFORM_LINUX)
 extern Cherry::Application* Cherry::CreateApplication();
 
 int main(int argc, char** argv)
@@ -9,18 +12,47 @@ int main(int argc, char** argv)
     // Initialize logging system
     Cherry::Log::Init();
 
-	CH_PROFILE_BEGIN_SESSION("Startup", "CherryProfile-Startup.jason");
+	// --null-renderer: run everything without a GPU (see RendererAPI::API::Null)
+	// --profile-runtime: write the whole run to a file instead of flight recording it
+	// --record-input <file>: record the session's input (see InputRecorder)
+	// --replay-input <file>: replay a recorded session as a benchmark, then exit
+	bool profileRuntime = false;
+	std::string recordInput, replayInput;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--null-renderer")
+			Cherry::RendererAPI::SetAPI(Cherry::RendererAPI::API::Null);
+		else if (std::string(argv[i]) == "--profile-runtime")
+			profileRuntime = true;
+		else if (std::string(argv[i]) == "--record-input" && i + 1 < argc)
+			recordInput = argv[++i];
+		else if (std::string(argv[i]) == "--replay-input" && i + 1 < argc)
+			replayInput = argv[++i];
+	}
+
+	CH_PROFILE_THREAD("Main");
+	CH_PROFILE_BEGIN_SESSION("Startup", "CherryProfile-Startup.chtrace");
 	auto app = Cherry::CreateApplication();
 	CH_PROFILE_END_SESSION();
 
-	CH_PROFILE_BEGIN_SESSION("Runtime", "CherryProfile-Runtime.jason");
+	if (profileRuntime)
+		CH_PROFILE_BEGIN_SESSION("Runtime", "CherryProfile-Runtime.chtrace");
+	else
+		Cherry::FlightRecorder::Start();
+
+	if (!replayInput.empty())
+		Cherry::InputRecorder::StartReplay(replayInput);
+	else if (!recordInput.empty())
+		Cherry::InputRecorder::StartRecording(recordInput);
+
 	app->Run();
+	Cherry::InputRecorder::Stop();
 	CH_PROFILE_END_SESSION();
 
-	CH_PROFILE_BEGIN_SESSION("Shutdown", "CherryProfile-Shutdown.jason");
+	CH_PROFILE_BEGIN_SESSION("Shutdown", "CherryProfile-Shutdown.chtrace");
 	delete app;
 	CH_PROFILE_END_SESSION();
 
     return 0;
 }
-#endif // CH_PLATFORM_WINDOWS
\ No newline at end of file
+#endif // CH_PLATFORM_WINDOWS || CH_PLATFORM_LINUX
\ No newline at end of file
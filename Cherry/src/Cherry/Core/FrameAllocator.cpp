@@ -0,0 +1,248 @@
+#include "CHpch.h"
+#include "FrameAllocator.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#ifdef CH_DEBUG
+// Counts heap allocations on every thread, so BeginFrame can report them per frame. Array and nothrow forms
+// go through these; threads inside a HeapAllocationScope are not counted.
+static std::atomic<uint64_t> s_HeapAllocations = 0;
+static thread_local uint32_t t_UncountedScopes = 0;
+
+static inline void CountHeapAllocation()
+{
+	if (t_UncountedScopes == 0)
+		s_HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* operator new(size_t size)
+{
+	CountHeapAllocation();
+	if (void* memory = std::malloc(size ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	CountHeapAllocation();
+#ifdef CH_PLATFORM_WINDOWS
+	void* memory = _aligned_malloc(size ? size : 1, (size_t)alignment);
+#else
+	// aligned_alloc wants a multiple of the alignment
+	size_t rounded = (std::max(size, (size_t)1) + (size_t)alignment - 1) & ~((size_t)alignment - 1);
+	void* memory = std::aligned_alloc((size_t)alignment, rounded);
+#endif
+	if (memory)
+		return memory;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+#ifdef CH_PLATFORM_WINDOWS
+	_aligned_free(memory);
+#else
+	std::free(memory);
+#endif
+}
+
+void operator delete(void* memory, size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(memory, alignment);
+}
+#endif
+
+namespace Cherry {
+
+	// Carved out of the arena per thread; large enough that the shared offset is rarely touched
+	static constexpr size_t s_BlockSize = 64 * 1024;
+	// Frames allowed to warm up caches and pools before heap allocations assert
+	static constexpr uint32_t s_WarmupFrames = 240;
+
+	struct FrameArena
+	{
+		std::unique_ptr<uint8_t[]> Memory;
+		size_t Capacity = 0;
+		std::atomic<size_t> Offset = 0;
+
+		// Allocations past the capacity, freed when the arena is reset
+		std::mutex OverflowMutex;
+		std::vector<void*> Overflow;
+		std::atomic<size_t> OverflowBytes = 0;
+	};
+
+	struct FrameAllocatorData
+	{
+		FrameArena Arenas[FrameAllocator::FramesInFlight];
+		std::atomic<uint32_t> Frame = 0;
+
+		uint64_t HeapAllocationsAtFrameStart = 0;
+		uint64_t FrameHeapAllocations = 0;
+		uint32_t FrameCount = 0;
+	};
+
+	struct FrameAllocatorBlock
+	{
+		uint32_t Frame = UINT32_MAX;
+		uint8_t* Cursor = nullptr;
+		uint8_t* End = nullptr;
+	};
+
+	static FrameAllocatorData s_Data;
+	static thread_local FrameAllocatorBlock t_Block;
+
+	static inline uint8_t* AlignUp(uint8_t* pointer, size_t alignment)
+	{
+		return (uint8_t*)(((uintptr_t)pointer + alignment - 1) & ~(uintptr_t)(alignment - 1));
+	}
+
+	static void* AllocateFromArena(FrameArena& arena, size_t size, size_t alignment)
+	{
+		size_t padded = size + alignment - 1;
+		size_t offset = arena.Offset.fetch_add(padded, std::memory_order_relaxed);
+		if (offset + padded <= arena.Capacity)
+			return AlignUp(arena.Memory.get() + offset, alignment);
+
+		uint8_t* memory = (uint8_t*)::operator new(padded);
+		std::lock_guard<std::mutex> lock(arena.OverflowMutex);
+		arena.Overflow.push_back(memory);
+		arena.OverflowBytes.fetch_add(padded, std::memory_order_relaxed);
+		return AlignUp(memory, alignment);
+	}
+
+	static void ResetArena(FrameArena& arena)
+	{
+		std::lock_guard<std::mutex> lock(arena.OverflowMutex);
+		if (arena.OverflowBytes > 0)
+		{
+			for (void* memory : arena.Overflow)
+				::operator delete(memory);
+			arena.Overflow.clear();
+
+			size_t overflow = arena.OverflowBytes.load(std::memory_order_relaxed);
+			size_t capacity = arena.Capacity + std::max(overflow, arena.Capacity / 2);
+			CH_CORE_WARN("Frame allocator overflowed by {0} bytes; growing the arena to {1} bytes", overflow, capacity);
+			arena.Memory.reset(new uint8_t[capacity]);
+			arena.Capacity = capacity;
+			arena.OverflowBytes = 0;
+		}
+		arena.Offset.store(0, std::memory_order_relaxed);
+	}
+
+	void FrameAllocator::Init(size_t capacity)
+	{
+		CH_PROFILE_FUNCTION();
+
+		for (FrameArena& arena : s_Data.Arenas)
+		{
+			arena.Memory.reset(new uint8_t[capacity]);
+			arena.Capacity = capacity;
+			arena.Offset = 0;
+		}
+	}
+
+	void FrameAllocator::Shutdown()
+	{
+		for (FrameArena& arena : s_Data.Arenas)
+		{
+			ResetArena(arena);
+			arena.Memory.reset();
+			arena.Capacity = 0;
+		}
+	}
+
+	void FrameAllocator::BeginFrame()
+	{
+		CH_PROFILE_FUNCTION();
+
+		uint32_t frame = s_Data.Frame.load(std::memory_order_relaxed);
+		CH_PROFILE_COUNTER("Frame Allocator Bytes", GetUsed());
+
+		ResetArena(s_Data.Arenas[(frame + 1) % FramesInFlight]);
+		s_Data.Frame.store(frame + 1, std::memory_order_release);
+
+#ifdef CH_DEBUG
+		uint64_t heapAllocations = s_HeapAllocations.load(std::memory_order_relaxed);
+		s_Data.FrameHeapAllocations = heapAllocations - s_Data.HeapAllocationsAtFrameStart;
+		s_Data.HeapAllocationsAtFrameStart = heapAllocations;
+		CH_PROFILE_COUNTER("Heap Allocations", s_Data.FrameHeapAllocations);
+
+		if (++s_Data.FrameCount > s_WarmupFrames)
+			CH_CORE_ASSERT(s_Data.FrameHeapAllocations == 0, "Steady-state frame made heap allocations; per-frame data belongs in the FrameAllocator");
+#endif
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		uint32_t frame = s_Data.Frame.load(std::memory_order_acquire);
+		FrameAllocatorBlock& block = t_Block;
+		if (block.Frame != frame)
+			block = { frame, nullptr, nullptr };
+
+		if (block.Cursor)
+		{
+			uint8_t* aligned = AlignUp(block.Cursor, alignment);
+			if (aligned + size <= block.End)
+			{
+				block.Cursor = aligned + size;
+				return aligned;
+			}
+		}
+
+		// Large requests go straight to the arena rather than wasting most of a block
+		FrameArena& arena = s_Data.Arenas[frame % FramesInFlight];
+		if (size + alignment > s_BlockSize / 4)
+			return AllocateFromArena(arena, size, alignment);
+
+		block.Cursor = (uint8_t*)AllocateFromArena(arena, s_BlockSize, 64);
+		block.End = block.Cursor + s_BlockSize;
+
+		uint8_t* aligned = AlignUp(block.Cursor, alignment);
+		block.Cursor = aligned + size;
+		return aligned;
+	}
+
+	size_t FrameAllocator::GetUsed()
+	{
+		const FrameArena& arena = s_Data.Arenas[s_Data.Frame.load(std::memory_order_relaxed) % FramesInFlight];
+		return std::min(arena.Offset.load(std::memory_order_relaxed), arena.Capacity) + arena.OverflowBytes.load(std::memory_order_relaxed);
+	}
+
+	size_t FrameAllocator::GetCapacity()
+	{
+		return s_Data.Arenas[s_Data.Frame.load(std::memory_order_relaxed) % FramesInFlight].Capacity;
+	}
+
+	uint64_t FrameAllocator::GetFrameHeapAllocations()
+	{
+		return s_Data.FrameHeapAllocations;
+	}
+
+	HeapAllocationScope::HeapAllocationScope()
+	{
+#ifdef CH_DEBUG
+		t_UncountedScopes++;
+#endif
+	}
+
+	HeapAllocationScope::~HeapAllocationScope()
+	{
+#ifdef CH_DEBUG
+		t_UncountedScopes--;
+#endif
+	}
+}
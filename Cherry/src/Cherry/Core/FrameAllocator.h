@@ -0,0 +1,73 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Cherry {
+
+	// Bump allocation for data that lives no longer than a frame. There is one arena per frame in flight,
+	// reset when its turn comes round again, so memory from frame N stays valid through frame N + 1. Each
+	// thread carves its own blocks out of the arena and bumps through them without atomics.
+	class FrameAllocator
+	{
+	public:
+		static constexpr uint32_t FramesInFlight = 2;
+
+		static void Init(size_t capacity = 4 * 1024 * 1024);
+		static void Shutdown();
+
+		// Main thread, at the top of every frame, once no job is using the arena being recycled
+		static void BeginFrame();
+
+		// Any thread; never freed individually. Past the capacity it falls back to the heap, and the
+		// arena grows to fit the next time it is reset.
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		// Bytes handed out this frame, and the arena size
+		static size_t GetUsed();
+		static size_t GetCapacity();
+
+		// Global operator new calls made on any thread during the previous frame, outside HeapAllocationScopes.
+		// Counted in debug builds only, where a steady-state frame asserts it made none; 0 otherwise.
+		static uint64_t GetFrameHeapAllocations();
+	};
+
+	// Marks heap allocations the calling thread makes while it is alive as expected: loading, streaming
+	// and tooling work rather than the frame loop. Nests; does nothing outside debug builds.
+	class HeapAllocationScope
+	{
+	public:
+		HeapAllocationScope();
+		~HeapAllocationScope();
+
+		HeapAllocationScope(const HeapAllocationScope&) = delete;
+		HeapAllocationScope& operator=(const HeapAllocationScope&) = delete;
+	};
+
+	// For standard containers whose contents are dropped within the frame. Deallocation does nothing.
+	template<typename T>
+	class FrameStlAllocator
+	{
+	public:
+		using value_type = T;
+
+		FrameStlAllocator() = default;
+		template<typename U>
+		FrameStlAllocator(const FrameStlAllocator<U>&) {}
+
+		T* allocate(size_t count) { return static_cast<T*>(FrameAllocator::Allocate(count * sizeof(T), alignof(T))); }
+		void deallocate(T*, size_t) {}
+
+		template<typename U>
+		bool operator==(const FrameStlAllocator<U>&) const { return true; }
+		template<typename U>
+		bool operator!=(const FrameStlAllocator<U>&) const { return false; }
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameStlAllocator<char>>;
+}
@@ -0,0 +1,132 @@
+#include "CHpch.h"
+#include "Cherry/Core/FramePacer.h"
+
+#include "Cherry/Events/ApplicationEvent.h"
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+	#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace Cherry {
+
+	// How long an on-demand wait can take to notice a RequestRedraw from another thread
+	static constexpr double s_IdleWaitTimeout = 0.1;
+	// Input can take ImGui a few frames to settle (hover, layout, animations)
+	static constexpr uint32_t s_EventRedrawFrames = 3;
+
+	static constexpr int64_t s_MaxSleepError = 20'000'000;
+
+	static void PreciseSleep(int64_t nanoseconds)
+	{
+#ifdef CH_PLATFORM_WINDOWS
+		// Sleep rounds up to the 15.6 ms scheduler tick; high resolution waitable timers (Windows 10 1803
+		// and later) wake within a fraction of a millisecond
+		static HANDLE s_Timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (s_Timer)
+		{
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -(nanoseconds / 100);
+			if (SetWaitableTimerEx(s_Timer, &dueTime, 0, nullptr, nullptr, nullptr, 0))
+			{
+				WaitForSingleObject(s_Timer, INFINITE);
+				return;
+			}
+		}
+#endif
+		std::this_thread::sleep_for(std::chrono::nanoseconds(nanoseconds));
+	}
+
+	void FramePacer::SetTargetFrameRate(double framesPerSecond)
+	{
+		m_TargetInterval = framesPerSecond > 0.0 ? Clock::FromSeconds(1.0 / framesPerSecond) : 0;
+	}
+
+	void FramePacer::SetBackgroundFrameRate(double framesPerSecond)
+	{
+		m_BackgroundInterval = framesPerSecond > 0.0 ? Clock::FromSeconds(1.0 / framesPerSecond) : 0;
+	}
+
+	void FramePacer::RequestRedraw(uint32_t frames)
+	{
+		uint32_t current = m_RedrawFrames.load(std::memory_order_relaxed);
+		while (current < frames && !m_RedrawFrames.compare_exchange_weak(current, frames, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void FramePacer::OnEvent(Event& e)
+	{
+		if (e.GetEventType() == EventType::WindowFocus)
+			m_Focused = true;
+		else if (e.GetEventType() == EventType::WindowLostFocus)
+			m_Focused = false;
+
+		RequestRedraw(s_EventRedrawFrames);
+	}
+
+	int64_t FramePacer::GetCurrentInterval(bool minimized) const
+	{
+		if (!m_Focused || minimized)
+			return std::max(m_TargetInterval, m_BackgroundInterval);
+		return m_TargetInterval;
+	}
+
+	int64_t FramePacer::GetFrameInterval() const
+	{
+		int64_t interval = GetCurrentInterval(m_Minimized);
+		return interval > 0 ? interval : Clock::FromSeconds(1.0 / 60.0);
+	}
+
+	bool FramePacer::WaitForNextFrame(Window& window, bool minimized)
+	{
+		CH_PROFILE_FUNCTION();
+
+		m_Minimized = minimized;
+
+		// A minimised window has nothing to draw either way; wake for the event that restores it
+		bool idled = false;
+		if (m_OnDemand || minimized)
+		{
+			while (m_RedrawFrames.load(std::memory_order_acquire) == 0)
+			{
+				window.WaitEvents(s_IdleWaitTimeout);
+				idled = true;
+			}
+
+			uint32_t frames = m_RedrawFrames.load(std::memory_order_relaxed);
+			while (frames > 0 && !m_RedrawFrames.compare_exchange_weak(frames, frames - 1, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		int64_t interval = GetCurrentInterval(minimized);
+		if (interval > 0)
+			SleepUntil(m_NextFrame);
+
+		// Frames that ran long restart the schedule rather than being made up with a burst
+		int64_t now = Clock::Now();
+		m_NextFrame = now - m_NextFrame < interval ? m_NextFrame + interval : now + interval;
+		return idled;
+	}
+
+	void FramePacer::SleepUntil(int64_t deadline)
+	{
+		CH_PROFILE_FUNCTION();
+
+		// Sleep most of the way, then spin through the stretch the OS cannot be trusted to wake us on time for
+		int64_t start = Clock::Now();
+		int64_t sleepFor = deadline - start - m_SleepError;
+		if (sleepFor > 0)
+		{
+			PreciseSleep(sleepFor);
+
+			// Quick to grow after a late wake-up, slow to trust the OS again
+			int64_t error = Clock::Now() - start - sleepFor;
+			m_SleepError = error > m_SleepError ? error : m_SleepError - (m_SleepError - error) / 16;
+			m_SleepError = std::clamp<int64_t>(m_SleepError, 0, s_MaxSleepError);
+		}
+
+		while (Clock::Now() < deadline)
+			std::this_thread::yield();
+	}
+}
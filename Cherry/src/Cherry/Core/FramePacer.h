@@ -0,0 +1,53 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Core/Clock.h"
+#include "Cherry/Core/Window.h"
+#include "Cherry/Events/Event.h"
+
+#include <atomic>
+
+namespace Cherry {
+
+	// Decides when the next frame starts: caps the frame rate, throttles while the window is in the
+	// background and, on demand, sleeps in the event queue until something needs drawing
+	class FramePacer
+	{
+	public:
+		// Frames per second, 0 for uncapped (VSync still applies when on)
+		void SetTargetFrameRate(double framesPerSecond);
+		// Cap while unfocused or minimised, 0 to keep the target rate
+		void SetBackgroundFrameRate(double framesPerSecond);
+
+		// Only draw when an event arrives or a redraw is requested
+		inline void SetOnDemand(bool onDemand) { m_OnDemand = onDemand; }
+		inline bool IsOnDemand() const { return m_OnDemand; }
+
+		// Any thread: in on-demand mode, draw at least the next frames frames
+		void RequestRedraw(uint32_t frames = 1);
+
+		void OnEvent(Event& e);
+
+		// Main thread, top of the loop: returns once the next frame may start. True when the loop idled
+		// waiting for a redraw, so the time since the last frame is not a frame time.
+		bool WaitForNextFrame(Window& window, bool minimized);
+
+		// The interval being held to, or 1/60 s when uncapped
+		int64_t GetFrameInterval() const;
+
+	private:
+		int64_t GetCurrentInterval(bool minimized) const;
+		void SleepUntil(int64_t deadline);
+
+	private:
+		int64_t m_TargetInterval = 0;
+		int64_t m_BackgroundInterval = Clock::FromSeconds(1.0 / 20.0);
+		bool m_OnDemand = false;
+		bool m_Focused = true;
+		bool m_Minimized = false;
+		std::atomic<uint32_t> m_RedrawFrames = 1;
+
+		int64_t m_NextFrame = 0;
+		// How late the OS wakes from a sleep, learnt as we go; that much of every wait is spun instead
+		int64_t m_SleepError = 1'000'000;
+	};
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace Cherry {
+
+	// 64-bit FNV-1a: tiny and good enough for asset identity, not for anything adversarial
+	namespace Hash {
+
+		constexpr uint64_t s_FNVOffsetBasis = 0xcbf29ce484222325ull;
+		constexpr uint64_t s_FNVPrime = 0x100000001b3ull;
+
+		constexpr uint64_t FNV1a(const void* data, size_t size, uint64_t hash = s_FNVOffsetBasis)
+		{
+			const uint8_t* bytes = (const uint8_t*)data;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= s_FNVPrime;
+			}
+			return hash;
+		}
+
+		constexpr uint64_t FNV1a(std::string_view string, uint64_t hash = s_FNVOffsetBasis)
+		{
+			for (char c : string)
+			{
+				hash ^= (uint8_t)c;
+				hash *= s_FNVPrime;
+			}
+			return hash;
+		}
+	}
+}
@@ -0,0 +1,124 @@
+#include "CHpch.h"
+#include "Input.h"
+
+#include "Cherry/Events/KeyEvent.h"
+#include "Cherry/Events/MouseEvent.h"
+
+#include <atomic>
+
+namespace Cherry {
+
+	// Built up on the main thread as events arrive and copied out whole at the start of each frame
+	static InputSnapshot s_Building;
+	static bool s_HasMousePosition = false;
+
+	// The published buffer and the one the next frame is copied into
+	static InputSnapshot s_Snapshots[2];
+	static std::atomic<const InputSnapshot*> s_Published = &s_Snapshots[0];
+	static uint32_t s_BackSnapshot = 1;
+
+	const InputSnapshot& Input::GetSnapshot()
+	{
+		return *s_Published.load(std::memory_order_acquire);
+	}
+
+	void Input::OnEvent(const Event& e)
+	{
+		InputSnapshot& s = s_Building;
+		switch (e.GetEventType())
+		{
+		case EventType::KeyPressed:
+		{
+			int key = static_cast<const KeyPressedEvent&>(e).GetKeyCode();
+			if (InputSnapshot::IsValidKey(key) && !s.Keys[key])
+			{
+				s.Keys.set(key);
+				s.PressedKeys.set(key);
+			}
+			break;
+		}
+		case EventType::KeyReleased:
+		{
+			int key = static_cast<const KeyReleasedEvent&>(e).GetKeyCode();
+			if (InputSnapshot::IsValidKey(key) && s.Keys[key])
+			{
+				s.Keys.reset(key);
+				s.ReleasedKeys.set(key);
+			}
+			break;
+		}
+		case EventType::MouseButtonPressed:
+		{
+			int button = static_cast<const MouseButtonPressedEvent&>(e).GetMouseButton();
+			if (InputSnapshot::IsValidButton(button) && !s.MouseButtons[button])
+			{
+				s.MouseButtons.set(button);
+				s.PressedMouseButtons.set(button);
+			}
+			break;
+		}
+		case EventType::MouseButtonReleased:
+		{
+			int button = static_cast<const MouseButtonReleasedEvent&>(e).GetMouseButton();
+			if (InputSnapshot::IsValidButton(button) && s.MouseButtons[button])
+			{
+				s.MouseButtons.reset(button);
+				s.ReleasedMouseButtons.set(button);
+			}
+			break;
+		}
+		case EventType::MouseMoved:
+		{
+			auto& moved = static_cast<const MouseMovedEvent&>(e);
+			// The first position has nothing to be a delta from
+			if (s_HasMousePosition)
+			{
+				s.MouseDeltaX += moved.GetX() - s.MouseX;
+				s.MouseDeltaY += moved.GetY() - s.MouseY;
+			}
+			s.MouseX = moved.GetX();
+			s.MouseY = moved.GetY();
+			s_HasMousePosition = true;
+			break;
+		}
+		case EventType::MouseScrolled:
+		{
+			auto& scrolled = static_cast<const MouseScrolledEvent&>(e);
+			s.ScrollX += scrolled.GetXOffset();
+			s.ScrollY += scrolled.GetYOffset();
+			break;
+		}
+		case EventType::WindowLostFocus:
+			// Releases made while another window has focus never arrive
+			s.ReleasedKeys |= s.Keys;
+			s.ReleasedMouseButtons |= s.MouseButtons;
+			s.Keys.reset();
+			s.MouseButtons.reset();
+			break;
+		default:
+			break;
+		}
+	}
+
+	void Input::BeginFrame()
+	{
+		CH_PROFILE_FUNCTION();
+
+		InputSnapshot& back = s_Snapshots[s_BackSnapshot];
+		back = s_Building;
+		s_Published.store(&back, std::memory_order_release);
+		s_BackSnapshot ^= 1;
+
+		// Edges, deltas and scrolling are per frame; held state carries over
+		InputSnapshot& s = s_Building;
+		s.Frame++;
+		s.PreviousKeys = s.Keys;
+		s.PressedKeys.reset();
+		s.ReleasedKeys.reset();
+		s.PreviousMouseButtons = s.MouseButtons;
+		s.PressedMouseButtons.reset();
+		s.ReleasedMouseButtons.reset();
+		s.MouseDeltaX = s.MouseDeltaY = 0.0f;
+		s.ScrollX = s.ScrollY = 0.0f;
+	}
+}
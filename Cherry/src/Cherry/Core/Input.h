@@ -1,31 +1,81 @@
 #pragma once
 #include "Cherry/Core/Core.h"
+#include "Cherry/Core/KeyCodes.h"
+#include "Cherry/Core/MouseButtonCodes.h"
+#include "Cherry/Events/Event.h"
+
+#include <bitset>
+#include <cstdint>
 #include <utility> // for std::pair
 
 namespace Cherry {
-	// Input class to handle input events
+
+	// Keyboard and mouse state as of the start of one frame, built from that frame's events
+	struct InputSnapshot
+	{
+		static constexpr int KeyCount = CH_KEY_LAST + 1;
+		static constexpr int MouseButtonCount = CH_MOUSE_BUTTON_LAST + 1;
+
+		uint64_t Frame = 0;
+
+		std::bitset<KeyCount> Keys;
+		std::bitset<KeyCount> PreviousKeys;
+		// Kept separately from the Keys/PreviousKeys difference so a tap inside one frame is not lost
+		std::bitset<KeyCount> PressedKeys;
+		std::bitset<KeyCount> ReleasedKeys;
+
+		std::bitset<MouseButtonCount> MouseButtons;
+		std::bitset<MouseButtonCount> PreviousMouseButtons;
+		std::bitset<MouseButtonCount> PressedMouseButtons;
+		std::bitset<MouseButtonCount> ReleasedMouseButtons;
+
+		float MouseX = 0.0f, MouseY = 0.0f;
+		float MouseDeltaX = 0.0f, MouseDeltaY = 0.0f;
+		float ScrollX = 0.0f, ScrollY = 0.0f;
+
+		inline bool IsKeyDown(int keycode) const { return IsValidKey(keycode) && Keys[keycode]; }
+		inline bool WasKeyPressed(int keycode) const { return IsValidKey(keycode) && PressedKeys[keycode]; }
+		inline bool WasKeyReleased(int keycode) const { return IsValidKey(keycode) && ReleasedKeys[keycode]; }
+
+		inline bool IsMouseButtonDown(int button) const { return IsValidButton(button) && MouseButtons[button]; }
+		inline bool WasMouseButtonPressed(int button) const { return IsValidButton(button) && PressedMouseButtons[button]; }
+		inline bool WasMouseButtonReleased(int button) const { return IsValidButton(button) && ReleasedMouseButtons[button]; }
+
+		inline static bool IsValidKey(int keycode) { return keycode >= 0 && keycode < KeyCount; }
+		inline static bool IsValidButton(int button) { return button >= 0 && button < MouseButtonCount; }
+	};
+
+	// Input is read from a snapshot the main thread publishes once per frame, so any thread (job system
+	// tasks included) can query it without touching the windowing library. Queries answer for the frame
+	// in progress: state changes reach them at the start of the next frame.
 	class CHERRY_API Input {
-	protected:
-		Input() = default;
 	public:
-		Input(const Input&) = delete;
-		Input& operator=(const Input&) = delete;
-		// Check if a key is pressed
-		inline static bool IsKeyPressed(int keycode) { return s_Instance->IsKeyPressedImpl(keycode); }
-		inline static bool IsMouseButtonPressed(int button) { return s_Instance->IsMouseButtonPressedImpl(button); }
-		inline static float GetMouseX() { return s_Instance->GetMouseXImpl(); }
-		inline static float GetMouseY() { return s_Instance->GetMouseYImpl(); }
+		Input() = delete;
+
+		// Held down
+		inline static bool IsKeyPressed(int keycode) { return GetSnapshot().IsKeyDown(keycode); }
+		// Went down / came up since the previous frame
+		inline static bool WasKeyPressed(int keycode) { return GetSnapshot().WasKeyPressed(keycode); }
+		inline static bool WasKeyReleased(int keycode) { return GetSnapshot().WasKeyReleased(keycode); }
+
+		inline static bool IsMouseButtonPressed(int button) { return GetSnapshot().IsMouseButtonDown(button); }
+		inline static bool WasMouseButtonPressed(int button) { return GetSnapshot().WasMouseButtonPressed(button); }
+		inline static bool WasMouseButtonReleased(int button) { return GetSnapshot().WasMouseButtonReleased(button); }
+
+		inline static float GetMouseX() { return GetSnapshot().MouseX; }
+		inline static float GetMouseY() { return GetSnapshot().MouseY; }
 		// Get the current mouse position
-		inline static std::pair<float, float> GetMousePosition() {return s_Instance->GetMousePositionImp();}
-		
-		
-	protected:
-		virtual bool IsKeyPressedImpl(int keycode) = 0;
-		virtual bool IsMouseButtonPressedImpl(int button) = 0;
-		virtual float GetMouseXImpl() = 0;
-		virtual float GetMouseYImpl() = 0;
-		virtual std::pair<float, float> GetMousePositionImp() = 0;
-	private:
-			static Input* s_Instance;
+		inline static std::pair<float, float> GetMousePosition() { const InputSnapshot& s = GetSnapshot(); return { s.MouseX, s.MouseY }; }
+		inline static std::pair<float, float> GetMouseDelta() { const InputSnapshot& s = GetSnapshot(); return { s.MouseDeltaX, s.MouseDeltaY }; }
+		inline static std::pair<float, float> GetScroll() { const InputSnapshot& s = GetSnapshot(); return { s.ScrollX, s.ScrollY }; }
+
+		// Lock free from any thread. Stays intact until the frame after next begins, so read it within a frame
+		// rather than holding on to it.
+		static const InputSnapshot& GetSnapshot();
+
+		// Main thread: every event, before layers see it
+		static void OnEvent(const Event& e);
+		// Main thread, once per frame after the frame's events: publishes them and starts the next snapshot
+		static void BeginFrame();
 	};
-} // namespace Cherry
\ No newline at end of file
+} // namespace Cherry
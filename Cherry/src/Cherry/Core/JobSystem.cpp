@@ -0,0 +1,418 @@
+#include "CHpch.h"
+#include "JobSystem.h"
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#include <immintrin.h>
+	#define CH_CPU_PAUSE() _mm_pause()
+#else
+	#define CH_CPU_PAUSE() std::this_thread::yield()
+#endif
+
+namespace Cherry {
+
+	// Chase-Lev deque (with the fences of Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+	// Models"): the owner pushes and pops at the bottom, thieves take from the top
+	class JobDeque
+	{
+	public:
+		static constexpr int64_t Capacity = 4096;
+
+		// Owner only; false when full
+		bool Push(Job* job)
+		{
+			int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+			int64_t top = m_Top.load(std::memory_order_acquire);
+			if (bottom - top >= Capacity)
+				return false;
+
+			m_Jobs[bottom & (Capacity - 1)].store(job, std::memory_order_relaxed);
+			// Publishes the job to thieves, which read the bottom with acquire
+			m_Bottom.store(bottom + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Owner only
+		Job* Pop()
+		{
+			int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+			m_Bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_Top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Job* job = m_Jobs[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				// The last job: race thieves for it
+				if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					job = nullptr;
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return job;
+		}
+
+		// Any thread
+		Job* Steal()
+		{
+			int64_t top = m_Top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+			if (top >= bottom)
+				return nullptr;
+
+			Job* job = m_Jobs[top & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+			return job;
+		}
+
+		inline uint32_t GetSize() const
+		{
+			int64_t size = m_Bottom.load(std::memory_order_relaxed) - m_Top.load(std::memory_order_relaxed);
+			return size > 0 ? (uint32_t)size : 0;
+		}
+
+	private:
+		alignas(64) std::atomic<int64_t> m_Top = 0;
+		alignas(64) std::atomic<int64_t> m_Bottom = 0;
+		std::unique_ptr<std::atomic<Job*>[]> m_Jobs{ new std::atomic<Job*>[Capacity] };
+	};
+
+	struct alignas(64) JobThread
+	{
+		static constexpr uint32_t PoolSize = 4096;
+
+		JobDeque Deque;
+		// Jobs this thread submits; a slot is reused once the job in it has finished
+		std::unique_ptr<Job[]> Pool{ new Job[PoolSize] };
+		uint32_t NextJob = 0;
+		uint32_t Random = 0;
+		std::thread Thread;
+	};
+
+	struct JobSystemData
+	{
+		// Index 0 is the main thread, which has a deque but no std::thread
+		std::vector<std::unique_ptr<JobThread>> Threads;
+		std::atomic<bool> Running = false;
+
+		// Jobs submitted from threads the job system does not own
+		std::mutex SharedMutex;
+		std::deque<Job*> Shared;
+		std::atomic<uint32_t> SharedCount = 0;
+
+		// Bumped whenever work is queued; idle workers sleep on it
+		std::atomic<uint32_t> WorkEpoch = 0;
+		std::atomic<uint32_t> Sleeping = 0;
+	};
+
+	static JobSystemData s_Data;
+	static thread_local uint32_t t_ThreadIndex = UINT32_MAX;
+
+	static inline JobThread* GetCurrentThread()
+	{
+		return t_ThreadIndex < s_Data.Threads.size() ? s_Data.Threads[t_ThreadIndex].get() : nullptr;
+	}
+
+	static void WakeWorker()
+	{
+		s_Data.WorkEpoch.fetch_add(1);
+		if (s_Data.Sleeping.load() > 0)
+			s_Data.WorkEpoch.notify_one();
+	}
+
+	void JobSystem::Execute(Job* job)
+	{
+		job->Function(*job);
+
+		JobCounter* counter = job->Counter;
+		if (job->Pooled)
+			job->InUse.store(false, std::memory_order_release);
+		else
+			delete job;
+		counter->Decrement();
+	}
+
+	void JobSystem::Schedule(Job* job)
+	{
+		JobThread* thread = GetCurrentThread();
+		if (thread)
+		{
+			// A full deque means there is plenty queued already: run it here instead
+			if (!thread->Deque.Push(job))
+			{
+				Execute(job);
+				return;
+			}
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(s_Data.SharedMutex);
+			s_Data.Shared.push_back(job);
+			s_Data.SharedCount.fetch_add(1, std::memory_order_release);
+		}
+		WakeWorker();
+	}
+
+	static Job* FindJob()
+	{
+		JobThread* thread = GetCurrentThread();
+		if (thread)
+		{
+			if (Job* job = thread->Deque.Pop())
+				return job;
+		}
+
+		if (s_Data.SharedCount.load(std::memory_order_acquire) > 0)
+		{
+			std::lock_guard<std::mutex> lock(s_Data.SharedMutex);
+			if (!s_Data.Shared.empty())
+			{
+				Job* job = s_Data.Shared.front();
+				s_Data.Shared.pop_front();
+				s_Data.SharedCount.fetch_sub(1, std::memory_order_relaxed);
+				return job;
+			}
+		}
+
+		// Steal, starting from a random victim so thieves spread out
+		uint32_t count = (uint32_t)s_Data.Threads.size();
+		uint32_t start = 0;
+		if (thread)
+		{
+			thread->Random ^= thread->Random << 13;
+			thread->Random ^= thread->Random >> 17;
+			thread->Random ^= thread->Random << 5;
+			start = thread->Random;
+		}
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint32_t victim = (start + i) % count;
+			if (victim == t_ThreadIndex)
+				continue;
+			if (Job* job = s_Data.Threads[victim]->Deque.Steal())
+				return job;
+		}
+		return nullptr;
+	}
+
+	void JobSystem::WorkerLoop(uint32_t index)
+	{
+		t_ThreadIndex = index;
+		std::string name = "Job Worker " + std::to_string(index);
+		CH_PROFILE_THREAD(name);
+
+		while (true)
+		{
+			if (Job* job = FindJob())
+			{
+				Execute(job);
+				continue;
+			}
+
+			// Work queued after this read bumps the epoch, so the wait below cannot miss it
+			uint32_t epoch = s_Data.WorkEpoch.load();
+			if (Job* job = FindJob())
+			{
+				Execute(job);
+				continue;
+			}
+			if (!s_Data.Running.load())
+				break;
+
+			s_Data.Sleeping.fetch_add(1);
+			s_Data.WorkEpoch.wait(epoch);
+			s_Data.Sleeping.fetch_sub(1);
+		}
+	}
+
+	JobCounter::~JobCounter()
+	{
+		CH_CORE_ASSERT(IsDone(), "JobCounter destroyed with jobs outstanding!");
+		// The job that closed the list may still be releasing the lock
+		Lock();
+	}
+
+	void JobCounter::Lock()
+	{
+		while (m_Lock.test_and_set(std::memory_order_acquire))
+			CH_CPU_PAUSE();
+	}
+
+	void JobCounter::Add(uint32_t count)
+	{
+		if (count == 0)
+			return;
+		if (m_Value.fetch_add(count, std::memory_order_relaxed) != 0)
+			return;
+
+		// Reopen for waiters, unless the last job is still closing it (it checks the value again under the lock)
+		Lock();
+		if (m_Waiters.load(std::memory_order_relaxed) == Closed())
+			m_Waiters.store(nullptr, std::memory_order_release);
+		Unlock();
+	}
+
+	void JobCounter::Decrement()
+	{
+		if (m_Value.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		Lock();
+		Job* waiter = nullptr;
+		if (m_Value.load(std::memory_order_acquire) == 0)
+		{
+			waiter = m_Waiters.load(std::memory_order_relaxed);
+			m_Waiters.store(Closed(), std::memory_order_release);
+		}
+		Unlock();
+
+		// The counter may already be gone: only the detached list is touched from here
+		while (waiter && waiter != Closed())
+		{
+			Job* next = waiter->Next;
+			JobSystem::Schedule(waiter);
+			waiter = next;
+		}
+	}
+
+	bool JobCounter::AddWaiter(Job* job)
+	{
+		Lock();
+		Job* head = m_Waiters.load(std::memory_order_relaxed);
+		bool waiting = head != Closed();
+		if (waiting)
+		{
+			job->Next = head;
+			m_Waiters.store(job, std::memory_order_relaxed);
+		}
+		Unlock();
+		return waiting;
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		CH_PROFILE_FUNCTION();
+		CH_CORE_ASSERT(!s_Data.Running, "JobSystem already initialized!");
+
+		if (workerCount == 0)
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		s_Data.Running = true;
+		s_Data.Threads.clear();
+		for (uint32_t i = 0; i <= workerCount; i++)
+		{
+			s_Data.Threads.push_back(std::make_unique<JobThread>());
+			s_Data.Threads.back()->Random = 0x9E3779B9u * (i + 1);
+		}
+
+		t_ThreadIndex = 0;
+		for (uint32_t i = 1; i <= workerCount; i++)
+			s_Data.Threads[i]->Thread = std::thread(WorkerLoop, i);
+
+		CH_CORE_INFO("JobSystem started {0} workers", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		CH_PROFILE_FUNCTION();
+		if (!s_Data.Running)
+			return;
+
+		// The main thread's queue is only drained by stealing, so help empty it first
+		while (Job* job = FindJob())
+			Execute(job);
+
+		s_Data.Running = false;
+		s_Data.WorkEpoch.fetch_add(1);
+		s_Data.WorkEpoch.notify_all();
+		for (auto& thread : s_Data.Threads)
+		{
+			if (thread->Thread.joinable())
+				thread->Thread.join();
+		}
+		s_Data.Threads.clear();
+		t_ThreadIndex = UINT32_MAX;
+	}
+
+	uint32_t JobSystem::GetThreadCount()
+	{
+		return std::max((uint32_t)s_Data.Threads.size(), 1u);
+	}
+
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		return t_ThreadIndex;
+	}
+
+	uint32_t JobSystem::GetQueuedJobCount()
+	{
+		JobThread* thread = GetCurrentThread();
+		return thread ? thread->Deque.GetSize() : 0;
+	}
+
+	Job* JobSystem::AllocateJob()
+	{
+		JobThread* thread = GetCurrentThread();
+		if (!thread)
+		{
+			Job* job = new Job();
+			job->Pooled = false;
+			return job;
+		}
+
+		while (true)
+		{
+			for (uint32_t i = 0; i < JobThread::PoolSize; i++)
+			{
+				Job& job = thread->Pool[thread->NextJob++ % JobThread::PoolSize];
+				if (!job.InUse.load(std::memory_order_acquire))
+				{
+					job.InUse.store(true, std::memory_order_relaxed);
+					return &job;
+				}
+			}
+
+			// Every slot is queued or running: work some of it off
+			if (Job* job = FindJob())
+				Execute(job);
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::Submit(Job* job, JobCounter* dependency)
+	{
+		CH_CORE_ASSERT(s_Data.Running, "JobSystem not initialized!");
+
+		if (dependency && dependency->AddWaiter(job))
+			return;
+		Schedule(job);
+	}
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		uint32_t spins = 0;
+		while (!counter.IsDone())
+		{
+			if (Job* job = FindJob())
+			{
+				Execute(job);
+				spins = 0;
+			}
+			else if (++spins < 64)
+				CH_CPU_PAUSE();
+			else
+				std::this_thread::yield();
+		}
+	}
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Cherry {
+
+	class JobCounter;
+
+	// One unit of work with its callable stored inline; recycled by the job system, never allocated per Run
+	struct alignas(64) Job
+	{
+		static constexpr size_t StorageSize = 96;
+
+		// Invokes the stored callable, then destroys it
+		void (*Function)(Job& job) = nullptr;
+		JobCounter* Counter = nullptr;
+		// Next job waiting on the same dependency
+		Job* Next = nullptr;
+		std::atomic<bool> InUse = false;
+		bool Pooled = true;
+		alignas(16) unsigned char Storage[StorageSize];
+	};
+
+	// Counts jobs still to finish. Jobs can be made to wait on a counter reaching zero; a counter may be
+	// reused once it is done.
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+		~JobCounter();
+
+		// True once every job has finished and any jobs depending on this have been released
+		inline bool IsDone() const { return m_Waiters.load(std::memory_order_acquire) == Closed(); }
+		inline uint32_t GetValue() const { return m_Value.load(std::memory_order_relaxed); }
+
+		// For work counted by hand rather than through Run: jobs waiting on the counter start once every
+		// Add has been matched by a Decrement
+		void Add(uint32_t count);
+		void Decrement();
+
+	private:
+		inline static Job* Closed() { return reinterpret_cast<Job*>(uintptr_t(1)); }
+
+		// False if the counter is already done and the job can run straight away
+		bool AddWaiter(Job* job);
+
+		void Lock();
+		inline void Unlock() { m_Lock.clear(std::memory_order_release); }
+
+	private:
+		std::atomic<uint32_t> m_Value = 0;
+		// Jobs waiting on zero, or Closed() once it has been reached
+		std::atomic<Job*> m_Waiters = Closed();
+		// Held while the waiter list opens or closes, so a job finishing cannot close it under a new Add
+		std::atomic_flag m_Lock;
+
+		friend class JobSystem;
+	};
+
+	// Worker threads, one per hardware thread with the main thread counting as one, each with a
+	// work-stealing deque. Jobs are pushed to the submitting thread's deque; idle threads steal from
+	// the others. Waiting on a counter runs jobs instead of blocking, so jobs may wait on jobs.
+	class JobSystem
+	{
+	public:
+		// 0 workers: one per hardware thread, less the calling (main) thread
+		static void Init(uint32_t workerCount = 0);
+		// Finishes every queued job, then joins the workers
+		static void Shutdown();
+
+		// Workers plus the main thread
+		static uint32_t GetThreadCount();
+		// 0 on the main thread, 1.. on workers, UINT32_MAX on threads the job system does not own
+		static uint32_t GetThreadIndex();
+
+		// Runs fn() on some thread; counter is incremented now and decremented when it returns
+		template<typename Fn>
+		static void Run(JobCounter& counter, Fn&& fn)
+		{
+			Submit(CreateJob(counter, std::forward<Fn>(fn)), nullptr);
+		}
+
+		// As above, but not started until dependency is done
+		template<typename Fn>
+		static void Run(JobCounter& counter, JobCounter& dependency, Fn&& fn)
+		{
+			Submit(CreateJob(counter, std::forward<Fn>(fn)), &dependency);
+		}
+
+		// Executes queued jobs until the counter is done
+		static void Wait(const JobCounter& counter);
+
+		// fn(i) for every i in [0, count), split across threads and returning when all have run. Ranges are
+		// only split while the splitting thread has nothing queued, so the split follows how busy the
+		// workers are; minBatch bounds how small a range may get.
+		template<typename Fn>
+		static void ParallelFor(uint32_t count, Fn&& fn, uint32_t minBatch = 1)
+		{
+			if (count == 0)
+				return;
+
+			// Fine enough for the work to balance, coarse enough that splitting is not the work
+			uint32_t grain = std::max(minBatch, count / (GetThreadCount() * 16));
+			if (grain >= count)
+			{
+				for (uint32_t i = 0; i < count; i++)
+					fn(i);
+				return;
+			}
+
+			JobCounter counter;
+			ParallelForRange(counter, 0, count, std::max(grain, 1u), fn);
+			Wait(counter);
+		}
+
+	private:
+		template<typename Fn>
+		static Job* CreateJob(JobCounter& counter, Fn&& fn)
+		{
+			using Callable = std::decay_t<Fn>;
+			static_assert(sizeof(Callable) <= Job::StorageSize, "Job callable too large; capture by reference or pointer");
+			static_assert(alignof(Callable) <= 16, "Job callable over-aligned");
+
+			Job* job = AllocateJob();
+			new (job->Storage) Callable(std::forward<Fn>(fn));
+			job->Function = [](Job& job)
+			{
+				Callable* callable = std::launder(reinterpret_cast<Callable*>(job.Storage));
+				(*callable)();
+				callable->~Callable();
+			};
+			job->Counter = &counter;
+			counter.Add(1);
+			return job;
+		}
+
+		template<typename Fn>
+		static void ParallelForRange(JobCounter& counter, uint32_t begin, uint32_t end, uint32_t grain, Fn& fn)
+		{
+			while (begin < end)
+			{
+				// Hand the upper half to thieves, but only while there is nothing else for them to take
+				while (end - begin > grain && GetQueuedJobCount() == 0)
+				{
+					uint32_t middle = begin + (end - begin) / 2;
+					Run(counter, [&counter, middle, end, grain, &fn]() { ParallelForRange(counter, middle, end, grain, fn); });
+					end = middle;
+				}
+
+				uint32_t batchEnd = std::min(begin + grain, end);
+				for (uint32_t i = begin; i < batchEnd; i++)
+					fn(i);
+				begin = batchEnd;
+			}
+		}
+
+		static Job* AllocateJob();
+		static void Submit(Job* job, JobCounter* dependency);
+		// Queues a job that is ready to run
+		static void Schedule(Job* job);
+		static void Execute(Job* job);
+		static void WorkerLoop(uint32_t index);
+		// Jobs in the calling thread's own deque
+		static uint32_t GetQueuedJobCount();
+
+		friend class JobCounter;
+	};
+}
@@ -0,0 +1,171 @@
+#include "CHpch.h"
+#include "Cherry/Core/LZ4.h"
+
+namespace Cherry::LZ4 {
+
+	static constexpr size_t s_MinMatch = 4;
+	static constexpr size_t s_LastLiterals = 5;		// The block always ends in at least this many literals
+	static constexpr size_t s_MatchFindLimit = 12;	// No match may start closer than this to the end
+	static constexpr size_t s_MaxOffset = 65535;
+	static constexpr uint32_t s_HashBits = 12;
+
+	static inline uint32_t Read32(const uint8_t* p)
+	{
+		uint32_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static inline uint32_t HashSequence(uint32_t sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - s_HashBits);
+	}
+
+	static inline uint8_t* WriteLength(uint8_t* op, size_t length)
+	{
+		while (length >= 255)
+		{
+			*op++ = 255;
+			length -= 255;
+		}
+		*op++ = (uint8_t)length;
+		return op;
+	}
+
+	static uint8_t* WriteSequence(uint8_t* op, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+	{
+		uint8_t* token = op++;
+
+		if (literalLength >= 15)
+		{
+			*token = 15 << 4;
+			op = WriteLength(op, literalLength - 15);
+		}
+		else
+			*token = (uint8_t)(literalLength << 4);
+
+		memcpy(op, literals, literalLength);
+		op += literalLength;
+
+		// The last sequence carries literals only
+		if (matchLength == 0)
+			return op;
+
+		*op++ = (uint8_t)(offset & 0xff);
+		*op++ = (uint8_t)(offset >> 8);
+
+		size_t encodedMatch = matchLength - s_MinMatch;
+		if (encodedMatch >= 15)
+		{
+			*token |= 15;
+			op = WriteLength(op, encodedMatch - 15);
+		}
+		else
+			*token |= (uint8_t)encodedMatch;
+
+		return op;
+	}
+
+	size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+	{
+		CH_CORE_ASSERT(dstCapacity >= CompressBound(srcSize), "LZ4 destination is smaller than CompressBound!");
+
+		uint8_t* op = dst;
+		size_t anchor = 0;
+
+		if (srcSize > s_MatchFindLimit)
+		{
+			// Positions are only hints, every candidate is verified before use
+			std::vector<uint32_t> table(1u << s_HashBits, 0);
+
+			size_t matchLimit = srcSize - s_LastLiterals;
+			size_t inputLimit = srcSize - s_MatchFindLimit;
+			size_t ip = 0;
+			while (ip <= inputLimit)
+			{
+				uint32_t sequence = Read32(src + ip);
+				uint32_t hash = HashSequence(sequence);
+				size_t candidate = table[hash];
+				table[hash] = (uint32_t)ip;
+
+				if (candidate >= ip || ip - candidate > s_MaxOffset || Read32(src + candidate) != sequence)
+				{
+					ip++;
+					continue;
+				}
+
+				size_t matchLength = s_MinMatch;
+				while (ip + matchLength < matchLimit && src[candidate + matchLength] == src[ip + matchLength])
+					matchLength++;
+
+				op = WriteSequence(op, src + anchor, ip - anchor, ip - candidate, matchLength);
+				ip += matchLength;
+				anchor = ip;
+			}
+		}
+
+		op = WriteSequence(op, src + anchor, srcSize - anchor, 0, 0);
+		return (size_t)(op - dst);
+	}
+
+	size_t Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+	{
+		const uint8_t* ip = src;
+		const uint8_t* srcEnd = src + srcSize;
+		uint8_t* op = dst;
+		uint8_t* dstEnd = dst + dstCapacity;
+
+		auto readLength = [&](size_t& length) -> bool
+		{
+			uint8_t byte;
+			do
+			{
+				if (ip >= srcEnd)
+					return false;
+				byte = *ip++;
+				length += byte;
+			} while (byte == 255);
+			return true;
+		};
+
+		while (ip < srcEnd)
+		{
+			uint8_t token = *ip++;
+
+			size_t literalLength = token >> 4;
+			if (literalLength == 15 && !readLength(literalLength))
+				return 0;
+			if (literalLength > (size_t)(srcEnd - ip) || literalLength > (size_t)(dstEnd - op))
+				return 0;
+
+			memcpy(op, ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+
+			if (ip == srcEnd)
+				break;
+
+			if (srcEnd - ip < 2)
+				return 0;
+			size_t offset = ip[0] | (ip[1] << 8);
+			ip += 2;
+			if (offset == 0 || offset > (size_t)(op - dst))
+				return 0;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15 && !readLength(matchLength))
+				return 0;
+			matchLength += s_MinMatch;
+			if (matchLength > (size_t)(dstEnd - op))
+				return 0;
+
+			// Byte copy: matches may overlap their own output
+			const uint8_t* match = op - offset;
+			for (size_t i = 0; i < matchLength; i++)
+				op[i] = match[i];
+			op += matchLength;
+		}
+
+		return (size_t)(op - dst);
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace Cherry {
+
+	// LZ4 block format (no frame header): fast greedy compressor and bounds-checked decompressor.
+	// Output is compatible with the reference LZ4_decompress_safe.
+	namespace LZ4 {
+
+		// Worst case compressed size for incompressible input
+		constexpr size_t CompressBound(size_t size) { return size + size / 255 + 16; }
+
+		// dstCapacity must be at least CompressBound(srcSize); returns the compressed size
+		size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+		// Returns the decompressed size, or 0 if the input is malformed or doesn't fit dstCapacity
+		size_t Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+	}
+}
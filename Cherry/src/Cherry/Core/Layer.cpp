@@ -9,4 +9,40 @@ namespace Cherry {
 	{
 
 	}
-}
\ No newline at end of file
+
+	void Layer::SubscribeCategories(int categories)
+	{
+		m_ExplicitSubscriptions = true;
+		s_SubscriptionGeneration++;
+		for (uint32_t type = 1; type < s_EventTypeCount; type++)
+		{
+			if (GetEventTypeCategories((EventType)type) & categories)
+				AddEventSubscription((EventType)type, EventHandler::Bind<&Layer::OnEvent>(this));
+		}
+	}
+
+	void Layer::Subscribe(EventType type)
+	{
+		AddEventSubscription(type, EventHandler::Bind<&Layer::OnEvent>(this));
+	}
+
+	void Layer::AddEventSubscription(EventType type, EventHandler handler)
+	{
+		m_ExplicitSubscriptions = true;
+		s_SubscriptionGeneration++;
+		m_EventSubscriptions.push_back({ type, handler });
+	}
+
+	void Layer::SetUpdateAffinity(LayerThreadAffinity affinity)
+	{
+		m_UpdateAffinity = affinity;
+		s_ScheduleGeneration++;
+	}
+
+	void Layer::AddUpdateDependency(Layer* layer)
+	{
+		CH_CORE_ASSERT(layer != this, "A layer cannot depend on itself!");
+		m_UpdateDependencies.push_back(layer);
+		s_ScheduleGeneration++;
+	}
+}
@@ -1,25 +1,92 @@
 #pragma once
 #include "Cherry/Core/Core.h"
+#include "Cherry/Core/Delegate.h"
 #include "Cherry/Core/TimeStep.h"
 #include "Cherry/Events/Event.h"
 
 namespace Cherry {
+
+	// Where a layer's OnUpdate may run
+	enum class LayerThreadAffinity
+	{
+		MainThread,		// In stack order on the main thread, so it may submit to the renderer
+		AnyThread		// On a job system worker, alongside other layers; must not touch the renderer
+	};
+
 	class CHERRY_API Layer 
 	{
 	public:
+		using EventHandler = Delegate<void(Event&)>;
+
+		struct EventSubscription
+		{
+			EventType Type;
+			EventHandler Handler;
+		};
+
 		Layer(const std::string& name = "Layer");
 		virtual ~Layer();
 
 		virtual void OnAttach(){}
 		virtual void OnDetach(){}
+		// At the application's fixed tick rate: zero or more times a frame, always before OnUpdate
+		virtual void OnFixedUpdate(TimeStep timeStep) {}
 		virtual void OnUpdate(TimeStep timeStep){}
+		// Called every frame in place of OnUpdate. alpha is how far this frame lies between the last fixed
+		// update and the next, for interpolating what is drawn; layers that do not interpolate keep OnUpdate.
+		virtual void OnInterpolatedUpdate(TimeStep timeStep, float alpha) { OnUpdate(timeStep); }
 		virtual void OnImGuiRender() {}
+		// Receives every event unless the layer subscribes to a narrower set
 		virtual void OnEvent(Event& event){}
 
 		inline const std::string GetName() const { return m_DebugName; }
 
+		// All types to OnEvent while the layer has never subscribed
+		inline bool HasEventSubscriptions() const { return m_ExplicitSubscriptions; }
+		inline const std::vector<EventSubscription>& GetEventSubscriptions() const { return m_EventSubscriptions; }
+		// Bumped by any layer's subscription change, so routing tables know to rebuild
+		inline static uint32_t GetSubscriptionGeneration() { return s_SubscriptionGeneration; }
+
+		void SetUpdateAffinity(LayerThreadAffinity affinity);
+		inline LayerThreadAffinity GetUpdateAffinity() const { return m_UpdateAffinity; }
+		// This layer's OnUpdate starts only once layer's has finished for the frame
+		void AddUpdateDependency(Layer* layer);
+		inline const std::vector<Layer*>& GetUpdateDependencies() const { return m_UpdateDependencies; }
+		// Bumped by any layer's affinity or dependency change, so update schedules know to rebuild
+		inline static uint32_t GetScheduleGeneration() { return s_ScheduleGeneration; }
+
+	protected:
+		// OnEvent receives events in these EventCategory flags; 0 declares a layer that handles none
+		void SubscribeCategories(int categories);
+		// OnEvent receives events of this type
+		void Subscribe(EventType type);
+
+		// handler, a member of the layer taking a T&, receives events of type T; its result marks them handled
+		template<typename T, auto Handler, typename L>
+		void Subscribe(L* layer)
+		{
+			AddEventSubscription(T::GetStaticType(), EventHandler::Bind<&Layer::InvokeHandler<T, L, Handler>>(layer));
+		}
+
+	private:
+		template<typename T, typename L, auto Handler>
+		static void InvokeHandler(L* layer, Event& event)
+		{
+			event.Handled = (layer->*Handler)(static_cast<T&>(event));
+		}
+
+		void AddEventSubscription(EventType type, EventHandler handler);
+
 	protected:
 		std::string m_DebugName;
 
+	private:
+		bool m_ExplicitSubscriptions = false;
+		std::vector<EventSubscription> m_EventSubscriptions;
+		inline static uint32_t s_SubscriptionGeneration = 0;
+
+		LayerThreadAffinity m_UpdateAffinity = LayerThreadAffinity::MainThread;
+		std::vector<Layer*> m_UpdateDependencies;
+		inline static uint32_t s_ScheduleGeneration = 0;
 	};
-}
\ No newline at end of file
+}
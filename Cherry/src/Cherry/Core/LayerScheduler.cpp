@@ -0,0 +1,154 @@
+#include "CHpch.h"
+#include "Cherry/Core/LayerScheduler.h"
+
+#include <queue>
+
+namespace Cherry {
+
+	void LayerScheduler::Rebuild(LayerStack& layers)
+	{
+		CH_PROFILE_FUNCTION();
+
+		m_Layers.assign(layers.begin(), layers.end());
+		uint32_t count = (uint32_t)m_Layers.size();
+
+		std::unordered_map<Layer*, uint32_t> indices;
+		for (uint32_t i = 0; i < count; i++)
+			indices[m_Layers[i]] = i;
+
+		m_MainThread.assign(count, true);
+		m_Dependents.assign(count, {});
+		m_DependencyCounts.assign(count, 0);
+		bool anyThread = false;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			m_MainThread[i] = m_Layers[i]->GetUpdateAffinity() == LayerThreadAffinity::MainThread;
+			anyThread |= !m_MainThread[i];
+
+			// Layers not in the stack have nothing to wait for
+			for (Layer* dependency : m_Layers[i]->GetUpdateDependencies())
+			{
+				auto it = indices.find(dependency);
+				if (it == indices.end())
+					continue;
+				m_Dependents[it->second].push_back(i);
+				m_DependencyCounts[i]++;
+			}
+		}
+
+		// Main-thread layers also wait on the one before them. Taking the lowest ready layer first keeps
+		// stack order wherever the dependencies allow it.
+		std::vector<uint32_t> incoming = m_DependencyCounts;
+		uint32_t previousMain = UINT32_MAX;
+		std::vector<uint32_t> nextMain(count, UINT32_MAX);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (!m_MainThread[i])
+				continue;
+			if (previousMain != UINT32_MAX)
+			{
+				nextMain[previousMain] = i;
+				incoming[i]++;
+			}
+			previousMain = i;
+		}
+
+		std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (incoming[i] == 0)
+				ready.push(i);
+		}
+
+		std::vector<uint32_t> order;
+		order.reserve(count);
+		while (!ready.empty())
+		{
+			uint32_t layer = ready.top();
+			ready.pop();
+			order.push_back(layer);
+			for (uint32_t dependent : m_Dependents[layer])
+			{
+				if (--incoming[dependent] == 0)
+					ready.push(dependent);
+			}
+			if (nextMain[layer] != UINT32_MAX && --incoming[nextMain[layer]] == 0)
+				ready.push(nextMain[layer]);
+		}
+
+		bool acyclic = order.size() == count;
+		if (!acyclic)
+			CH_CORE_ERROR("Layer update dependencies form a cycle; updating every layer on the main thread in stack order");
+
+		m_Parallel = acyclic && anyThread && JobSystem::GetThreadCount() > 1;
+		m_JobOrder.clear();
+		if (m_Parallel)
+		{
+			for (uint32_t layer : order)
+			{
+				if (!m_MainThread[layer])
+					m_JobOrder.push_back(layer);
+			}
+			m_Pending.reset(new JobCounter[count]);
+		}
+		else
+		{
+			// Serially, the dependency order is the update order
+			if (acyclic)
+			{
+				std::vector<Layer*> ordered;
+				for (uint32_t layer : order)
+					ordered.push_back(m_Layers[layer]);
+				m_Layers = std::move(ordered);
+			}
+			m_Pending.reset();
+		}
+
+		m_Dirty = false;
+		m_Generation = Layer::GetScheduleGeneration();
+	}
+
+	void LayerScheduler::Finish(uint32_t layer)
+	{
+		for (uint32_t dependent : m_Dependents[layer])
+			m_Pending[dependent].Decrement();
+	}
+
+	void LayerScheduler::Update(LayerStack& layers, TimeStep timeStep, float alpha)
+	{
+		if (m_Dirty || m_Generation != Layer::GetScheduleGeneration())
+			Rebuild(layers);
+
+		if (!m_Parallel)
+		{
+			for (Layer* layer : m_Layers)
+				layer->OnInterpolatedUpdate(timeStep, alpha);
+			return;
+		}
+
+		// Every counter is open before any job can wait on it
+		for (uint32_t i = 0; i < (uint32_t)m_Layers.size(); i++)
+			m_Pending[i].Add(m_DependencyCounts[i]);
+
+		for (uint32_t layer : m_JobOrder)
+		{
+			JobSystem::Run(m_Jobs, m_Pending[layer], [this, layer, timeStep, alpha]()
+			{
+				m_Layers[layer]->OnInterpolatedUpdate(timeStep, alpha);
+				Finish(layer);
+			});
+		}
+
+		// Waiting runs the jobs meanwhile
+		for (uint32_t layer = 0; layer < (uint32_t)m_Layers.size(); layer++)
+		{
+			if (!m_MainThread[layer])
+				continue;
+			JobSystem::Wait(m_Pending[layer]);
+			m_Layers[layer]->OnInterpolatedUpdate(timeStep, alpha);
+			Finish(layer);
+		}
+
+		JobSystem::Wait(m_Jobs);
+	}
+}
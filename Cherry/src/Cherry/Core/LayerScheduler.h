@@ -0,0 +1,46 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Core/JobSystem.h"
+#include "Cherry/Core/LayerStack.h"
+#include "Cherry/Core/TimeStep.h"
+
+#include <memory>
+#include <vector>
+
+namespace Cherry {
+
+	// Runs every layer's OnUpdate for the frame. Main-thread layers run in stack order on the calling
+	// thread, so what they submit to the renderer keeps its order; AnyThread layers run as jobs as soon
+	// as the layers they depend on have finished. Schedules that could deadlock run serially instead.
+	class LayerScheduler
+	{
+	public:
+		// Call after the stack changes; affinity and dependency changes are picked up on their own
+		inline void Invalidate() { m_Dirty = true; }
+
+		// Returns once every layer has updated
+		void Update(LayerStack& layers, TimeStep timeStep, float alpha);
+
+	private:
+		void Rebuild(LayerStack& layers);
+		void Finish(uint32_t layer);
+
+	private:
+		// Stack order
+		std::vector<Layer*> m_Layers;
+		std::vector<bool> m_MainThread;
+		// Layers that depend on each layer
+		std::vector<std::vector<uint32_t>> m_Dependents;
+		std::vector<uint32_t> m_DependencyCounts;
+		// AnyThread layers in an order where each comes after everything it depends on, so their jobs are
+		// submitted only after the counters they wait on are open
+		std::vector<uint32_t> m_JobOrder;
+		// Per layer, dependencies still to finish this frame
+		std::unique_ptr<JobCounter[]> m_Pending;
+		JobCounter m_Jobs;
+		bool m_Parallel = false;
+
+		bool m_Dirty = true;
+		uint32_t m_Generation = 0;
+	};
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+
+#include <string>
+
+namespace Cherry {
+
+	// Read-only memory mapping of a whole file; pages are faulted in by the OS on first access
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const std::string& path);
+		void Close();
+
+		inline bool IsOpen() const { return m_Data != nullptr; }
+		inline const uint8_t* GetData() const { return (const uint8_t*)m_Data; }
+		inline size_t GetSize() const { return m_Size; }
+
+	private:
+		void* m_Data = nullptr;
+		size_t m_Size = 0;
+
+		// Platform handles
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+	};
+}
@@ -0,0 +1,161 @@
+#include "CHpch.h"
+#include "Cherry/Core/Pak.h"
+
+#include "Cherry/Core/LZ4.h"
+#include "Cherry/Core/VFS.h"
+
+namespace Cherry {
+
+	PakArchive::PakArchive(const std::string& path)
+		: m_Path(path)
+	{
+		CH_PROFILE_FUNCTION();
+
+		if (!m_File.Open(path))
+		{
+			CH_CORE_ERROR("Could not open pak '{0}'", path);
+			return;
+		}
+
+		const uint8_t* data = m_File.GetData();
+		size_t size = m_File.GetSize();
+
+		auto header = (const PakHeader*)data;
+		if (size < sizeof(PakHeader) || header->Magic != PakHeader::s_Magic || header->Version != PakHeader::s_Version)
+		{
+			CH_CORE_ERROR("'{0}' is not a version {1} pak", path, PakHeader::s_Version);
+			return;
+		}
+
+		if (header->TocOffset > size || (uint64_t)header->EntryCount * sizeof(PakEntry) > size - header->TocOffset)
+		{
+			CH_CORE_ERROR("'{0}' has a truncated table of contents", path);
+			return;
+		}
+
+		// The table is read in place from the page-aligned mapping, so its offset must keep PakEntry aligned
+		if (header->TocOffset % alignof(PakEntry) != 0)
+		{
+			CH_CORE_ERROR("'{0}' has a misaligned table of contents", path);
+			return;
+		}
+
+		auto entries = (const PakEntry*)(data + header->TocOffset);
+		for (uint32_t i = 0; i < header->EntryCount; i++)
+		{
+			const PakEntry& entry = entries[i];
+			if (entry.Offset > header->TocOffset || entry.StoredSize > header->TocOffset - entry.Offset)
+			{
+				CH_CORE_ERROR("'{0}' entry {1} is out of bounds", path, i);
+				return;
+			}
+			// Uncompressed entries are read straight from the mapping at their full size
+			if (!(entry.Flags & PakEntryFlag_LZ4) && entry.Size != entry.StoredSize)
+			{
+				CH_CORE_ERROR("'{0}' entry {1} is stored uncompressed but its sizes differ", path, i);
+				return;
+			}
+		}
+
+		m_Entries = entries;
+		m_EntryCount = header->EntryCount;
+	}
+
+	PakSourceStamp PakSourceStamp::FromFile(const std::string& path)
+	{
+		std::error_code sizeError, timeError;
+		uint64_t size = std::filesystem::file_size(path, sizeError);
+		auto writeTime = std::filesystem::last_write_time(path, timeError);
+		if (sizeError || timeError)
+			return {};
+		return { size, (int64_t)writeTime.time_since_epoch().count() };
+	}
+
+	const PakEntry* PakArchive::Find(uint64_t pathHash) const
+	{
+		const PakEntry* end = m_Entries + m_EntryCount;
+		const PakEntry* entry = std::lower_bound(m_Entries, end, pathHash,
+			[](const PakEntry& entry, uint64_t hash) { return entry.PathHash < hash; });
+		return entry != end && entry->PathHash == pathHash ? entry : nullptr;
+	}
+
+	bool PakWriter::Add(const std::string& path, std::vector<uint8_t> data, bool compress, PakSourceStamp source)
+	{
+		uint64_t pathHash = VFS::HashPath(path);
+		for (const auto& file : m_Files)
+		{
+			if (file.Entry.PathHash == pathHash)
+			{
+				CH_CORE_ERROR("'{0}' is already in the pak or collides with another path", path);
+				return false;
+			}
+		}
+
+		PendingFile file;
+		file.Entry.PathHash = pathHash;
+		file.Entry.Size = data.size();
+		file.Entry.Source = source;
+
+		if (compress && !data.empty())
+		{
+			std::vector<uint8_t> compressed(LZ4::CompressBound(data.size()));
+			size_t compressedSize = LZ4::Compress(data.data(), data.size(), compressed.data(), compressed.size());
+			if (compressedSize < data.size())
+			{
+				compressed.resize(compressedSize);
+				data = std::move(compressed);
+				file.Entry.Flags |= PakEntryFlag_LZ4;
+			}
+		}
+
+		file.Entry.StoredSize = data.size();
+		file.Data = std::move(data);
+		m_Files.push_back(std::move(file));
+		return true;
+	}
+
+	bool PakWriter::Write(const std::string& pakPath) const
+	{
+		CH_PROFILE_FUNCTION();
+
+		std::vector<PakEntry> toc;
+		toc.reserve(m_Files.size());
+
+		uint64_t offset = sizeof(PakHeader);
+		for (const auto& file : m_Files)
+		{
+			offset = (offset + PakHeader::s_Alignment - 1) & ~(PakHeader::s_Alignment - 1);
+			PakEntry entry = file.Entry;
+			entry.Offset = offset;
+			toc.push_back(entry);
+			offset += entry.StoredSize;
+		}
+
+		PakHeader header;
+		header.TocOffset = (offset + alignof(PakEntry) - 1) & ~(uint64_t)(alignof(PakEntry) - 1);
+		header.EntryCount = (uint32_t)toc.size();
+
+		std::ofstream out(pakPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!out)
+		{
+			CH_CORE_ERROR("Could not open '{0}' for writing", pakPath);
+			return false;
+		}
+
+		static const std::vector<char> s_Padding(PakHeader::s_Alignment, 0);
+		auto padTo = [&](uint64_t position) { out.write(s_Padding.data(), position - (uint64_t)out.tellp()); };
+
+		out.write((const char*)&header, sizeof(header));
+		for (size_t i = 0; i < m_Files.size(); i++)
+		{
+			padTo(toc[i].Offset);
+			out.write((const char*)m_Files[i].Data.data(), m_Files[i].Data.size());
+		}
+		padTo(header.TocOffset);
+
+		std::sort(toc.begin(), toc.end(), [](const PakEntry& a, const PakEntry& b) { return a.PathHash < b.PathHash; });
+		out.write((const char*)toc.data(), toc.size() * sizeof(PakEntry));
+
+		return (bool)out;
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Core/MappedFile.h"
+
+#include <string>
+#include <vector>
+
+namespace Cherry {
+
+	// .chpak layout (little-endian):
+	//   PakHeader
+	//   file data				   every entry starts on a 4 KB page boundary
+	//   PakEntry[EntryCount]	   at TocOffset, sorted by PathHash for binary search
+	// Paths are stored only as VFS::HashPath of their normalized form.
+
+	enum PakEntryFlags : uint32_t
+	{
+		PakEntryFlag_LZ4 = BIT(0)
+	};
+
+	struct PakHeader
+	{
+		static constexpr uint32_t s_Magic = 0x4b504843;	// "CHPK"
+		static constexpr uint32_t s_Version = 2;
+		static constexpr uint64_t s_Alignment = 4096;
+
+		uint32_t Magic = s_Magic;
+		uint32_t Version = s_Version;
+		uint64_t TocOffset = 0;
+		uint32_t EntryCount = 0;
+		uint32_t Reserved = 0;
+	};
+
+	// Size and modification time of the file an entry was cooked from, so a loose copy of that file can
+	// be checked against it. WriteTime is in std::filesystem clock ticks, 0 when nothing was recorded.
+	struct PakSourceStamp
+	{
+		uint64_t Size = 0;
+		int64_t WriteTime = 0;
+
+		inline bool IsValid() const { return WriteTime != 0; }
+		bool operator==(const PakSourceStamp& other) const = default;
+
+		static PakSourceStamp FromFile(const std::string& path);
+	};
+
+	struct PakEntry
+	{
+		uint64_t PathHash = 0;
+		uint64_t Offset = 0;
+		uint64_t StoredSize = 0;
+		uint64_t Size = 0;			// Uncompressed
+		uint32_t Flags = 0;
+		uint32_t Reserved = 0;
+		PakSourceStamp Source;
+	};
+
+	static_assert(sizeof(PakHeader) == 24, "PakHeader layout changed");
+	static_assert(sizeof(PakEntry) == 56, "PakEntry layout changed");
+
+	// A mounted, memory-mapped pak
+	class PakArchive
+	{
+	public:
+		explicit PakArchive(const std::string& path);
+
+		inline bool IsValid() const { return m_Entries != nullptr; }
+		inline const std::string& GetPath() const { return m_Path; }
+
+		const PakEntry* Find(uint64_t pathHash) const;
+		inline const uint8_t* GetEntryData(const PakEntry& entry) const { return m_File.GetData() + entry.Offset; }
+	private:
+		std::string m_Path;
+		MappedFile m_File;
+		const PakEntry* m_Entries = nullptr;
+		uint32_t m_EntryCount = 0;
+	};
+
+	// Builds a .chpak; used by the cook tool
+	class PakWriter
+	{
+	public:
+		// Compressed entries are stored raw when LZ4 doesn't make them smaller
+		bool Add(const std::string& path, std::vector<uint8_t> data, bool compress = true, PakSourceStamp source = {});
+		bool Write(const std::string& pakPath) const;
+
+		inline size_t GetEntryCount() const { return m_Files.size(); }
+	private:
+		struct PendingFile
+		{
+			PakEntry Entry;
+			std::vector<uint8_t> Data;
+		};
+		std::vector<PendingFile> m_Files;
+	};
+}
@@ -0,0 +1,290 @@
+#include "CHpch.h"
+#include "Cherry/Core/VFS.h"
+
+#include "Cherry/Core/Hash.h"
+#include "Cherry/Core/LZ4.h"
+#include "Cherry/Core/MappedFile.h"
+#include "Cherry/Core/Pak.h"
+
+#include <shared_mutex>
+
+namespace Cherry {
+
+	struct VFSData
+	{
+		std::shared_mutex Mutex;
+		std::vector<std::filesystem::path> Directories;
+		std::vector<REF(PakArchive)> Paks;
+	};
+
+	static VFSData* s_Data = nullptr;
+
+	FileData::~FileData() = default;
+
+	FileData::FileData(FileData&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	FileData& FileData::operator=(FileData&& other) noexcept
+	{
+		m_Data = other.m_Data;
+		m_Valid = other.m_Valid;
+		m_File = std::move(other.m_File);
+		m_Archive = std::move(other.m_Archive);
+		m_Buffer = std::move(other.m_Buffer);
+
+		other.m_Data = {};
+		other.m_Valid = false;
+		return *this;
+	}
+
+	void VFS::Init()
+	{
+		CH_PROFILE_FUNCTION();
+
+		s_Data = new VFSData();
+	}
+
+	void VFS::Shutdown()
+	{
+		CH_PROFILE_FUNCTION();
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	bool VFS::MountDirectory(const std::string& directory)
+	{
+		std::error_code error;
+		if (!std::filesystem::is_directory(directory, error))
+		{
+			CH_CORE_ERROR("VFS: '{0}' is not a directory", directory);
+			return false;
+		}
+
+		std::unique_lock lock(s_Data->Mutex);
+		s_Data->Directories.push_back(directory);
+		CH_CORE_INFO("VFS: mounted directory '{0}'", directory);
+		return true;
+	}
+
+	bool VFS::MountPak(const std::string& pakPath)
+	{
+		auto archive = SmartPointer::CreateRef<PakArchive>(pakPath);
+		if (!archive->IsValid())
+			return false;
+
+		std::unique_lock lock(s_Data->Mutex);
+		s_Data->Paks.push_back(archive);
+		CH_CORE_INFO("VFS: mounted pak '{0}'", pakPath);
+		return true;
+	}
+
+	void VFS::Unmount(const std::string& path)
+	{
+		std::unique_lock lock(s_Data->Mutex);
+
+		auto& directories = s_Data->Directories;
+		directories.erase(std::remove(directories.begin(), directories.end(), std::filesystem::path(path)), directories.end());
+
+		// Files already read keep their pak mapped until released
+		auto& paks = s_Data->Paks;
+		paks.erase(std::remove_if(paks.begin(), paks.end(), [&](const REF(PakArchive)& pak) { return pak->GetPath() == path; }), paks.end());
+	}
+
+	// Resolves normalized (lower case) path under root one segment at a time, matching names case-insensitively
+	static std::filesystem::path FindCaseInsensitive(const std::filesystem::path& root, const std::string& normalized)
+	{
+		std::filesystem::path current = root;
+		size_t start = 0;
+		while (start < normalized.size())
+		{
+			size_t end = std::min(normalized.find('/', start), normalized.size());
+			std::string_view segment(normalized.data() + start, end - start);
+
+			bool found = false;
+			std::error_code error;
+			for (std::filesystem::directory_iterator it(current, error), last; !error && it != last; it.increment(error))
+			{
+				std::string name = it->path().filename().string();
+				if (std::equal(name.begin(), name.end(), segment.begin(), segment.end(),
+					[](char a, char b) { return std::tolower((unsigned char)a) == b; }))
+				{
+					current = it->path();
+					found = true;
+					break;
+				}
+			}
+			if (!found)
+				return {};
+			start = end + 1;
+		}
+
+		std::error_code error;
+		return std::filesystem::is_regular_file(current, error) ? current : std::filesystem::path();
+	}
+
+	static std::string FindLoosePath(const std::string& path)
+	{
+		std::filesystem::path relative = std::filesystem::path(path).lexically_normal();
+		for (auto it = s_Data->Directories.rbegin(); it != s_Data->Directories.rend(); ++it)
+		{
+			std::error_code error;
+			std::filesystem::path candidate = *it / relative;
+			if (std::filesystem::is_regular_file(candidate, error))
+				return candidate.string();
+
+#ifndef CH_PLATFORM_WINDOWS
+			// Case-sensitive file systems need a directory walk to match the pak lookup, which hashes the lower case path
+			candidate = FindCaseInsensitive(*it, VFS::NormalizePath(path));
+			if (!candidate.empty())
+				return candidate.string();
+#endif
+		}
+		return {};
+	}
+
+	bool VFS::Exists(const std::string& path)
+	{
+		std::shared_lock lock(s_Data->Mutex);
+
+		if (!FindLoosePath(path).empty())
+			return true;
+
+		uint64_t hash = HashPath(path);
+		for (const auto& pak : s_Data->Paks)
+		{
+			if (pak->Find(hash))
+				return true;
+		}
+		return false;
+	}
+
+	bool VFS::GetSize(const std::string& path, uint64_t& size)
+	{
+		std::shared_lock lock(s_Data->Mutex);
+
+		std::string loosePath = FindLoosePath(path);
+		if (!loosePath.empty())
+		{
+			std::error_code error;
+			size = std::filesystem::file_size(loosePath, error);
+			return !error;
+		}
+
+		uint64_t hash = HashPath(path);
+		for (auto it = s_Data->Paks.rbegin(); it != s_Data->Paks.rend(); ++it)
+		{
+			if (const PakEntry* entry = (*it)->Find(hash))
+			{
+				size = entry->Size;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FileData VFS::Read(const std::string& path)
+	{
+		CH_PROFILE_FUNCTION();
+
+		std::shared_lock lock(s_Data->Mutex);
+
+		FileData result;
+
+		std::string loosePath = FindLoosePath(path);
+		if (!loosePath.empty())
+		{
+			auto file = CREATE_SCOPE(MappedFile);
+			if (file->Open(loosePath))
+			{
+				result.m_Data = { (const std::byte*)file->GetData(), file->GetSize() };
+				result.m_File = std::move(file);
+			}
+			else
+			{
+				std::error_code error;
+				if (std::filesystem::file_size(loosePath, error) != 0 || error)
+				{
+					CH_CORE_ERROR("VFS: could not read '{0}'", loosePath);
+					return result;
+				}
+				// Empty files can't be mapped but are perfectly valid
+			}
+			result.m_Valid = true;
+			return result;
+		}
+
+		uint64_t hash = HashPath(path);
+		for (auto it = s_Data->Paks.rbegin(); it != s_Data->Paks.rend(); ++it)
+		{
+			const PakEntry* entry = (*it)->Find(hash);
+			if (!entry)
+				continue;
+
+			const uint8_t* stored = (*it)->GetEntryData(*entry);
+			if (entry->Flags & PakEntryFlag_LZ4)
+			{
+				result.m_Buffer.resize(entry->Size);
+				size_t size = LZ4::Decompress(stored, entry->StoredSize, (uint8_t*)result.m_Buffer.data(), entry->Size);
+				if (size != entry->Size)
+				{
+					CH_CORE_ERROR("VFS: '{0}' in '{1}' is corrupt", path, (*it)->GetPath());
+					return FileData();
+				}
+				result.m_Data = result.m_Buffer;
+			}
+			else
+			{
+				// Zero copy: a view into the pak mapping
+				result.m_Data = { (const std::byte*)stored, entry->Size };
+				result.m_Archive = *it;
+			}
+			result.m_Valid = true;
+			return result;
+		}
+
+		CH_CORE_ERROR("VFS: '{0}' not found", path);
+		return result;
+	}
+
+	std::string VFS::GetLoosePath(const std::string& path)
+	{
+		std::shared_lock lock(s_Data->Mutex);
+		return FindLoosePath(path);
+	}
+
+	PakSourceStamp VFS::GetPackedSource(const std::string& path)
+	{
+		std::shared_lock lock(s_Data->Mutex);
+
+		if (!FindLoosePath(path).empty())
+			return {};
+
+		uint64_t hash = HashPath(path);
+		for (auto it = s_Data->Paks.rbegin(); it != s_Data->Paks.rend(); ++it)
+		{
+			if (const PakEntry* entry = (*it)->Find(hash))
+				return entry->Source;
+		}
+		return {};
+	}
+
+	std::string VFS::NormalizePath(const std::string& path)
+	{
+		// Backslashes are separators in asset paths on every platform
+		std::string result = path;
+		std::replace(result.begin(), result.end(), '\\', '/');
+		result = std::filesystem::path(result).lexically_normal().generic_string();
+		std::transform(result.begin(), result.end(), result.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+		if (result.rfind("./", 0) == 0)
+			result.erase(0, 2);
+		return result;
+	}
+
+	uint64_t VFS::HashPath(const std::string& path)
+	{
+		return Hash::FNV1a(NormalizePath(path));
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Core/MappedFile.h"
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Cherry {
+
+	class PakArchive;
+	struct PakSourceStamp;
+
+	// Contents of a file read through the VFS. Uncompressed pak entries and loose files are views
+	// straight into a memory mapping the FileData keeps alive; compressed entries own their buffer.
+	class FileData
+	{
+	public:
+		FileData() = default;
+		~FileData();
+
+		FileData(FileData&& other) noexcept;
+		FileData& operator=(FileData&& other) noexcept;
+		FileData(const FileData&) = delete;
+		FileData& operator=(const FileData&) = delete;
+
+		inline bool IsValid() const { return m_Valid; }
+		inline explicit operator bool() const { return m_Valid; }
+
+		inline std::span<const std::byte> GetData() const { return m_Data; }
+		inline size_t GetSize() const { return m_Data.size(); }
+		inline const uint8_t* GetBytes() const { return (const uint8_t*)m_Data.data(); }
+		inline std::string_view AsString() const { return { (const char*)m_Data.data(), m_Data.size() }; }
+
+	private:
+		std::span<const std::byte> m_Data;
+		bool m_Valid = false;
+
+		SCOPE(MappedFile) m_File;
+		REF(PakArchive) m_Archive;
+		std::vector<std::byte> m_Buffer;
+
+		friend class VFS;
+	};
+
+	// Virtual file system for all asset I/O. Paths are relative and case-insensitive
+	// ("assets/textures/Checkerboard.png"). Loose directories are searched first so files on disk
+	// override packed ones during development, then pak archives, most recently mounted first.
+	// Mount and unmount from the main thread; reads are safe from any thread.
+	class VFS
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static bool MountDirectory(const std::string& directory);
+		static bool MountPak(const std::string& pakPath);
+		static void Unmount(const std::string& path);
+
+		static bool Exists(const std::string& path);
+		// Uncompressed size without reading the file; false if it doesn't exist
+		static bool GetSize(const std::string& path, uint64_t& size);
+		static FileData Read(const std::string& path);
+
+		// Where the loose overlay would read path from, empty if it isn't a loose file
+		static std::string GetLoosePath(const std::string& path);
+		// What a packed file was cooked from; invalid if path is loose, missing or has no stamp
+		static PakSourceStamp GetPackedSource(const std::string& path);
+
+		// Lower case, forward slashes, no "./" or ".." segments: the form pak paths are hashed in
+		static std::string NormalizePath(const std::string& path);
+		static uint64_t HashPath(const std::string& path);
+	};
+}
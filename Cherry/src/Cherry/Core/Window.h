@@ -10,6 +10,8 @@ namespace Cherry {
 		std::string Title;
 		unsigned int Width;
 		unsigned int Height;
+		// No visible window or display connection; also forced on Linux when no display is available
+		bool Headless = false;
 
 		WindowProps(const std::string& title = "Cherry Engine", unsigned int width = 1280, unsigned int height = 720)
 			: Title(title), Width(width), Height(height)
@@ -25,7 +27,10 @@ namespace Cherry {
 
 		virtual ~Window() = default;
 
+		// Polls events and presents the frame
 		virtual void OnUpdate() = 0;
+		// Sleeps until an event arrives or the timeout passes, dispatching whatever came in
+		virtual void WaitEvents(double timeoutSeconds) = 0;
 
 		virtual unsigned int GetWidth() const = 0;
 		virtual unsigned int GetHeight() const = 0;
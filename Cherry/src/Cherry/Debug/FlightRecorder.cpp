@@ -0,0 +1,110 @@
+#include "CHpch.h"
+#include "Cherry/Debug/FlightRecorder.h"
+
+#include "Cherry/Core/FrameAllocator.h"
+#include "Cherry/Events/KeyEvent.h"
+
+#include <ctime>
+
+namespace Cherry {
+
+	// Enough frames for a median that one slow frame cannot move
+	static constexpr uint32_t s_FrameHistorySize = 128;
+	static constexpr uint32_t s_MinimumFrames = 32;
+
+	struct FlightRecorderData
+	{
+		FlightRecorderSettings Settings;
+
+		std::array<float, s_FrameHistorySize> FrameTimes{};
+		uint32_t FrameCount = 0;
+		std::array<float, s_FrameHistorySize> Sorted{};
+
+		std::chrono::steady_clock::time_point LastCapture;
+		uint32_t CaptureCount = 0;
+	};
+
+	static FlightRecorderData s_Data;
+
+	FlightRecorderSettings& FlightRecorder::GetSettings()
+	{
+		return s_Data.Settings;
+	}
+
+	void FlightRecorder::Start()
+	{
+#if CH_PROFILE
+		CH_PROFILE_FUNCTION();
+
+		s_Data.FrameCount = 0;
+		s_Data.LastCapture = {};
+		Instrumentor::Get().BeginFlightRecording(s_Data.Settings.Window);
+		CH_CORE_INFO("Flight recorder keeping the last {0} s of profile events", s_Data.Settings.Window);
+#endif
+	}
+
+	void FlightRecorder::Stop()
+	{
+		if (Instrumentor::Get().IsFlightRecording())
+			Instrumentor::Get().EndSession();
+	}
+
+	void FlightRecorder::OnFrame(float workTime)
+	{
+		if (!s_Data.Settings.CaptureHitches || !Instrumentor::Get().IsFlightRecording())
+			return;
+
+		// The median of the frames before this one, so a hitch is not measured against itself
+		uint32_t count = std::min(s_Data.FrameCount, s_FrameHistorySize);
+		bool hitch = false;
+		float median = 0.0f;
+		if (count >= s_MinimumFrames && workTime > s_Data.Settings.HitchMinimum)
+		{
+			std::copy_n(s_Data.FrameTimes.begin(), count, s_Data.Sorted.begin());
+			std::nth_element(s_Data.Sorted.begin(), s_Data.Sorted.begin() + count / 2, s_Data.Sorted.begin() + count);
+			median = s_Data.Sorted[count / 2];
+			hitch = workTime > median * s_Data.Settings.HitchThreshold;
+		}
+		s_Data.FrameTimes[s_Data.FrameCount++ % s_FrameHistorySize] = workTime;
+
+		if (!hitch)
+			return;
+
+		// One capture per window: a later hitch inside it is already in the file
+		auto now = std::chrono::steady_clock::now();
+		if (s_Data.CaptureCount > 0 && now - s_Data.LastCapture < std::chrono::duration<float>(s_Data.Settings.Window))
+			return;
+
+		if (Capture("hitch", s_Data.Settings.AfterHitch))
+			CH_CORE_WARN("Hitch: frame work took {0:.1f} ms, {1:.1f}x the median; capturing flight recording", workTime * 1000.0f, workTime / median);
+	}
+
+	void FlightRecorder::OnEvent(Event& e)
+	{
+		// Never marks the key handled; layers still see it
+		EventDispatcher dispatcher(e);
+		dispatcher.Dispatch<KeyPressedEvent>([](KeyPressedEvent& keyEvent)
+		{
+			if (keyEvent.GetKeyCode() == s_Data.Settings.DumpKey && keyEvent.GetRepeatCount() == 0 && Instrumentor::Get().IsFlightRecording())
+				Capture("manual");
+			return false;
+		});
+	}
+
+	bool FlightRecorder::Capture(const char* reason, float afterSeconds)
+	{
+		HeapAllocationScope heapAllocations;
+
+		char timestamp[32];
+		std::time_t time = std::time(nullptr);
+		std::strftime(timestamp, sizeof(timestamp), "%Y%m%d-%H%M%S", std::localtime(&time));
+
+		std::string filepath = std::string("CherryFlight-") + timestamp + "-" + std::to_string(s_Data.CaptureCount) + "-" + reason + ".chtrace";
+		if (!Instrumentor::Get().DumpFlightRecording(filepath, afterSeconds))
+			return false;
+
+		s_Data.LastCapture = std::chrono::steady_clock::now();
+		s_Data.CaptureCount++;
+		return true;
+	}
+}
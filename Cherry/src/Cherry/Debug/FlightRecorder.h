@@ -0,0 +1,39 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Core/KeyCodes.h"
+#include "Cherry/Events/Event.h"
+
+namespace Cherry {
+
+	struct FlightRecorderSettings
+	{
+		// Seconds of profile events kept in memory
+		float Window = 10.0f;
+		// A frame whose work takes longer than this many times the median is a hitch
+		float HitchThreshold = 2.0f;
+		// Frames whose work is shorter than this are never hitches, however fast the median
+		float HitchMinimum = 0.008f;
+		// Recording kept going after a hitch so the frames that follow it are in the capture too
+		float AfterHitch = 1.0f;
+		bool CaptureHitches = true;
+		int DumpKey = CH_KEY_F11;
+	};
+
+	// Always-on profiling for builds that cannot afford a full session: the Instrumentor keeps the last
+	// few seconds of events in memory and they are written out only on the hotkey or after a hitch
+	class FlightRecorder
+	{
+	public:
+		static void Start();
+		static void Stop();
+
+		// Main thread, once per frame with the seconds its work took, waits for pacing and VSync excluded
+		static void OnFrame(float workTime);
+		static void OnEvent(Event& e);
+
+		// Writes CherryFlight-<date>-<time>-<n>-<reason>.chtrace; false if a capture is already pending
+		static bool Capture(const char* reason, float afterSeconds = 0.0f);
+
+		static FlightRecorderSettings& GetSettings();
+	};
+}
@@ -0,0 +1,434 @@
+#include "CHpch.h"
+#include "Cherry/Debug/InputRecorder.h"
+
+#include "Cherry/Core/Application.h"
+#include "Cherry/Core/Clock.h"
+#include "Cherry/Debug/TraceFormat.h"
+#include "Cherry/Events/ApplicationEvent.h"
+#include "Cherry/Events/KeyEvent.h"
+#include "Cherry/Events/MouseEvent.h"
+
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <random>
+
+namespace Cherry {
+
+	enum class InputRecorderMode
+	{
+		None, Recording, Replaying
+	};
+
+	struct RecordedEvent
+	{
+		EventType Type;
+		int Code = 0;
+		int Repeat = 0;
+		float X = 0.0f, Y = 0.0f;
+	};
+
+	struct RecordedFrame
+	{
+		int64_t FrameTime;
+		uint32_t FirstEvent;
+		uint32_t EventCount;
+	};
+
+	static uint64_t GenerateSeed()
+	{
+		std::random_device device;
+		return ((uint64_t)device() << 32) | device();
+	}
+
+	struct InputRecorderData
+	{
+		InputRecorderMode Mode = InputRecorderMode::None;
+		std::string Filepath;
+		InputRecordingHeader Header;
+		uint64_t Seed = GenerateSeed();
+
+		// Recording: finished frames, and the events of the frame in progress
+		std::string Frames;
+		std::string FrameEvents;
+		uint32_t FrameEventCount = 0;
+		int64_t LastEventTime = 0;
+
+		// Replay
+		std::vector<RecordedEvent> Events;
+		std::vector<RecordedFrame> ReplayFrames;
+		uint32_t ReplayFrame = 0;
+		std::vector<int64_t> Measured;
+		std::vector<int64_t> Work;
+	};
+
+	static InputRecorderData s_Data;
+
+	// Focus changes are recorded with the input: losing focus releases every key
+	static bool IsRecordedType(EventType type)
+	{
+		return (GetEventTypeCategories(type) & EventCategoryInput) || type == EventType::WindowFocus || type == EventType::WindowLostFocus;
+	}
+
+	static void WriteFloat(std::string& output, float value)
+	{
+		char bytes[sizeof(float)];
+		std::memcpy(bytes, &value, sizeof(float));
+		output.append(bytes, sizeof(float));
+	}
+
+	static bool ReadFloat(const uint8_t*& data, const uint8_t* end, float& value)
+	{
+		if (end - data < (ptrdiff_t)sizeof(float))
+			return false;
+		std::memcpy(&value, data, sizeof(float));
+		data += sizeof(float);
+		return true;
+	}
+
+	bool InputRecorder::IsRecording()
+	{
+		return s_Data.Mode == InputRecorderMode::Recording;
+	}
+
+	bool InputRecorder::IsReplaying()
+	{
+		return s_Data.Mode == InputRecorderMode::Replaying;
+	}
+
+	uint64_t InputRecorder::GetSeed()
+	{
+		return s_Data.Seed;
+	}
+
+	bool InputRecorder::StartRecording(const std::string& filepath)
+	{
+		CH_CORE_ASSERT(s_Data.Mode == InputRecorderMode::None, "Input recorder is already running!");
+
+		Application& app = Application::Get();
+		s_Data.Header = {};
+		s_Data.Header.FixedStep = app.GetFixedStep();
+		s_Data.Header.MaxFixedSteps = app.GetMaxFixedSteps();
+		s_Data.Header.Seed = s_Data.Seed;
+
+		s_Data.Filepath = filepath;
+		s_Data.Frames.clear();
+		s_Data.FrameEvents.clear();
+		s_Data.FrameEventCount = 0;
+		s_Data.LastEventTime = Clock::Now();
+		s_Data.Mode = InputRecorderMode::Recording;
+		CH_CORE_INFO("Recording input to {0}", filepath);
+		return true;
+	}
+
+	bool InputRecorder::StartReplay(const std::string& filepath)
+	{
+		CH_PROFILE_FUNCTION();
+		CH_CORE_ASSERT(s_Data.Mode == InputRecorderMode::None, "Input recorder is already running!");
+
+		std::ifstream file(filepath, std::ios::binary);
+		if (!file)
+		{
+			CH_CORE_ERROR("Could not open input recording {0}", filepath);
+			return false;
+		}
+		std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		InputRecordingHeader header;
+		if (contents.size() < sizeof(header))
+		{
+			CH_CORE_ERROR("{0} is not an input recording", filepath);
+			return false;
+		}
+		std::memcpy(&header, contents.data(), sizeof(header));
+		if (header.Magic != InputRecordingHeader::s_Magic || header.Version != InputRecordingHeader::s_Version)
+		{
+			CH_CORE_ERROR("{0} is not an input recording, or is from another version", filepath);
+			return false;
+		}
+
+		s_Data.Events.clear();
+		s_Data.ReplayFrames.clear();
+		s_Data.ReplayFrames.reserve(header.FrameCount);
+
+		const uint8_t* data = (const uint8_t*)contents.data() + sizeof(header);
+		const uint8_t* end = (const uint8_t*)contents.data() + contents.size();
+		bool valid = true;
+		for (uint32_t frame = 0; frame < header.FrameCount && valid; frame++)
+		{
+			uint64_t frameTime, eventCount;
+			valid = Varint::Read(data, end, frameTime) && Varint::Read(data, end, eventCount);
+			if (!valid)
+				break;
+
+			s_Data.ReplayFrames.push_back({ (int64_t)frameTime, (uint32_t)s_Data.Events.size(), (uint32_t)eventCount });
+			for (uint64_t i = 0; i < eventCount && valid; i++)
+			{
+				if (data == end)
+				{
+					valid = false;
+					break;
+				}
+
+				RecordedEvent event{ (EventType)*data++ };
+				uint64_t time, repeat;
+				int64_t code;
+				valid = Varint::Read(data, end, time);
+				switch (event.Type)
+				{
+				case EventType::KeyPressed:
+					valid = valid && Varint::ReadSigned(data, end, code) && Varint::Read(data, end, repeat);
+					event.Code = (int)code;
+					event.Repeat = (int)repeat;
+					break;
+				case EventType::KeyReleased: case EventType::KeyTyped:
+				case EventType::MouseButtonPressed: case EventType::MouseButtonReleased:
+					valid = valid && Varint::ReadSigned(data, end, code);
+					event.Code = (int)code;
+					break;
+				case EventType::MouseMoved: case EventType::MouseScrolled:
+					valid = valid && ReadFloat(data, end, event.X) && ReadFloat(data, end, event.Y);
+					break;
+				case EventType::WindowFocus: case EventType::WindowLostFocus:
+					break;
+				default:
+					valid = false;
+					break;
+				}
+				s_Data.Events.push_back(event);
+			}
+		}
+
+		if (!valid)
+		{
+			CH_CORE_ERROR("Input recording {0} is truncated or corrupt", filepath);
+			return false;
+		}
+
+		// The simulation has to step exactly as it did when recorded
+		Application& app = Application::Get();
+		app.SetFixedStep(header.FixedStep);
+		app.SetMaxFixedSteps(header.MaxFixedSteps);
+		s_Data.Seed = header.Seed;
+
+		// Run flat out, or every frame would measure the display refresh. The replay closes the
+		// application when it ends, so nothing is restored.
+		app.GetWindow().SetVSync(false);
+		FramePacer& pacer = app.GetFramePacer();
+		pacer.SetTargetFrameRate(0.0);
+		pacer.SetBackgroundFrameRate(0.0);
+		pacer.SetOnDemand(false);
+
+		s_Data.Header = header;
+		s_Data.Filepath = filepath;
+		s_Data.ReplayFrame = 0;
+		s_Data.Measured.clear();
+		s_Data.Measured.reserve(header.FrameCount);
+		s_Data.Work.clear();
+		s_Data.Work.reserve(header.FrameCount);
+		s_Data.Mode = header.FrameCount > 0 ? InputRecorderMode::Replaying : InputRecorderMode::None;
+		CH_CORE_INFO("Replaying {0} frames of input from {1}", header.FrameCount, filepath);
+		return true;
+	}
+
+	static void WriteRecording()
+	{
+		CH_PROFILE_FUNCTION();
+
+		std::ofstream file(s_Data.Filepath, std::ios::binary);
+		if (!file)
+		{
+			CH_CORE_ERROR("Could not write input recording {0}", s_Data.Filepath);
+			return;
+		}
+		file.write((const char*)&s_Data.Header, sizeof(s_Data.Header));
+		file.write(s_Data.Frames.data(), s_Data.Frames.size());
+		CH_CORE_INFO("Recorded {0} frames of input to {1} ({2} bytes)", s_Data.Header.FrameCount, s_Data.Filepath,
+			sizeof(s_Data.Header) + s_Data.Frames.size());
+	}
+
+	struct FrameStatistics
+	{
+		size_t Count = 0;
+		double Total = 0.0;		// Seconds; the rest in milliseconds
+		double Mean = 0.0, StdDev = 0.0;
+		double Min = 0.0, Median = 0.0, P95 = 0.0, P99 = 0.0, Max = 0.0;
+	};
+
+	static FrameStatistics ComputeStatistics(std::vector<int64_t> sorted)
+	{
+		FrameStatistics stats;
+		if (sorted.empty())
+			return stats;
+		std::sort(sorted.begin(), sorted.end());
+
+		for (int64_t frameTime : sorted)
+			stats.Total += Clock::ToSeconds(frameTime);
+		double mean = stats.Total / sorted.size();
+		double variance = 0.0;
+		for (int64_t frameTime : sorted)
+			variance += (Clock::ToSeconds(frameTime) - mean) * (Clock::ToSeconds(frameTime) - mean);
+		auto percentile = [&](double p) { return Clock::ToSeconds(sorted[(size_t)(p * (sorted.size() - 1))]) * 1000.0; };
+
+		stats.Count = sorted.size();
+		stats.Mean = mean * 1000.0;
+		stats.StdDev = std::sqrt(variance / sorted.size()) * 1000.0;
+		stats.Min = Clock::ToSeconds(sorted.front()) * 1000.0;
+		stats.Median = percentile(0.5);
+		stats.P95 = percentile(0.95);
+		stats.P99 = percentile(0.99);
+		stats.Max = Clock::ToSeconds(sorted.back()) * 1000.0;
+		return stats;
+	}
+
+	static void WriteStatistics(std::ofstream& file, const FrameStatistics& stats, const char* indent)
+	{
+		file << indent << "\"mean\": " << stats.Mean << ",\n"
+			<< indent << "\"stdDev\": " << stats.StdDev << ",\n"
+			<< indent << "\"min\": " << stats.Min << ",\n"
+			<< indent << "\"median\": " << stats.Median << ",\n"
+			<< indent << "\"p95\": " << stats.P95 << ",\n"
+			<< indent << "\"p99\": " << stats.P99 << ",\n"
+			<< indent << "\"max\": " << stats.Max;
+	}
+
+	static void WriteReplayStatistics()
+	{
+		CH_PROFILE_FUNCTION();
+
+		if (s_Data.Measured.empty())
+			return;
+		FrameStatistics frames = ComputeStatistics(s_Data.Measured);
+		FrameStatistics work = ComputeStatistics(s_Data.Work);
+
+		char timestamp[32];
+		std::time_t time = std::time(nullptr);
+		std::strftime(timestamp, sizeof(timestamp), "%Y%m%d-%H%M%S", std::localtime(&time));
+		std::filesystem::path recording(s_Data.Filepath);
+		std::filesystem::path filepath = recording.parent_path() / (recording.stem().string() + "-replay-" + timestamp + ".json");
+
+		// Milliseconds. The top level is the whole frame; "work" leaves out pacer sleeps and the buffer swap.
+		std::ofstream file(filepath);
+		file << "{\n"
+			<< "  \"recording\": \"" << recording.filename().string() << "\",\n"
+			<< "  \"frames\": " << frames.Count << ",\n"
+			<< "  \"totalSeconds\": " << frames.Total << ",\n";
+		WriteStatistics(file, frames, "  ");
+		file << ",\n  \"work\": {\n"
+			<< "    \"frames\": " << work.Count << ",\n"
+			<< "    \"totalSeconds\": " << work.Total << ",\n";
+		WriteStatistics(file, work, "    ");
+		file << "\n  }\n}\n";
+
+		CH_CORE_INFO("Replay of {0} frames: mean {1:.3f} ms, median {2:.3f} ms, p99 {3:.3f} ms, max {4:.3f} ms; work mean {5:.3f} ms, p99 {6:.3f} ms; written to {7}",
+			frames.Count, frames.Mean, frames.Median, frames.P99, frames.Max, work.Mean, work.P99, filepath.string());
+	}
+
+	void InputRecorder::Stop()
+	{
+		if (IsRecording())
+			WriteRecording();
+		else if (IsReplaying())
+			WriteReplayStatistics();
+		s_Data.Mode = InputRecorderMode::None;
+	}
+
+	bool InputRecorder::IsSuperseded(const Event& e)
+	{
+		return IsReplaying() && IsRecordedType(e.GetEventType());
+	}
+
+	void InputRecorder::OnEvent(const Event& e)
+	{
+		if (!IsRecording() || !IsRecordedType(e.GetEventType()))
+			return;
+
+		std::string& output = s_Data.FrameEvents;
+		output += (char)e.GetEventType();
+		int64_t now = Clock::Now();
+		Varint::Write(output, (uint64_t)(now - s_Data.LastEventTime));
+		s_Data.LastEventTime = now;
+
+		switch (e.GetEventType())
+		{
+		case EventType::KeyPressed:
+		{
+			auto& pressed = static_cast<const KeyPressedEvent&>(e);
+			Varint::WriteSigned(output, pressed.GetKeyCode());
+			Varint::Write(output, (uint64_t)pressed.GetRepeatCount());
+			break;
+		}
+		case EventType::KeyReleased: case EventType::KeyTyped:
+			Varint::WriteSigned(output, static_cast<const KeyEvent&>(e).GetKeyCode());
+			break;
+		case EventType::MouseButtonPressed: case EventType::MouseButtonReleased:
+			Varint::WriteSigned(output, static_cast<const MouseButtonEvent&>(e).GetMouseButton());
+			break;
+		case EventType::MouseMoved:
+			WriteFloat(output, static_cast<const MouseMovedEvent&>(e).GetX());
+			WriteFloat(output, static_cast<const MouseMovedEvent&>(e).GetY());
+			break;
+		case EventType::MouseScrolled:
+			WriteFloat(output, static_cast<const MouseScrolledEvent&>(e).GetXOffset());
+			WriteFloat(output, static_cast<const MouseScrolledEvent&>(e).GetYOffset());
+			break;
+		default:
+			break;
+		}
+		s_Data.FrameEventCount++;
+	}
+
+	void InputRecorder::ReplayEvents(const std::function<void(Event&)>& dispatch)
+	{
+		if (!IsReplaying())
+			return;
+
+		const RecordedFrame& frame = s_Data.ReplayFrames[s_Data.ReplayFrame];
+		for (uint32_t i = frame.FirstEvent; i < frame.FirstEvent + frame.EventCount; i++)
+		{
+			const RecordedEvent& recorded = s_Data.Events[i];
+			switch (recorded.Type)
+			{
+			case EventType::KeyPressed:          { KeyPressedEvent e(recorded.Code, recorded.Repeat); dispatch(e); break; }
+			case EventType::KeyReleased:         { KeyReleasedEvent e(recorded.Code); dispatch(e); break; }
+			case EventType::KeyTyped:            { KeyTypedEvent e(recorded.Code); dispatch(e); break; }
+			case EventType::MouseButtonPressed:  { MouseButtonPressedEvent e(recorded.Code); dispatch(e); break; }
+			case EventType::MouseButtonReleased: { MouseButtonReleasedEvent e(recorded.Code); dispatch(e); break; }
+			case EventType::MouseMoved:          { MouseMovedEvent e(recorded.X, recorded.Y); dispatch(e); break; }
+			case EventType::MouseScrolled:       { MouseScrolledEvent e(recorded.X, recorded.Y); dispatch(e); break; }
+			case EventType::WindowFocus:         { WindowFocusEvent e; dispatch(e); break; }
+			case EventType::WindowLostFocus:     { WindowLostFocusEvent e; dispatch(e); break; }
+			default: break;
+			}
+		}
+	}
+
+	int64_t InputRecorder::OnFrame(int64_t frameTime, int64_t measured, int64_t work)
+	{
+		if (IsRecording())
+		{
+			Varint::Write(s_Data.Frames, (uint64_t)frameTime);
+			Varint::Write(s_Data.Frames, s_Data.FrameEventCount);
+			s_Data.Frames += s_Data.FrameEvents;
+			s_Data.FrameEvents.clear();
+			s_Data.FrameEventCount = 0;
+			s_Data.Header.FrameCount++;
+			return frameTime;
+		}
+
+		if (!IsReplaying())
+			return frameTime;
+
+		s_Data.Measured.push_back(measured);
+		// Nothing has run before the first frame
+		if (work > 0)
+			s_Data.Work.push_back(work);
+		int64_t recorded = s_Data.ReplayFrames[s_Data.ReplayFrame++].FrameTime;
+		if (s_Data.ReplayFrame == s_Data.ReplayFrames.size())
+		{
+			Stop();
+			Application::Get().Close();
+		}
+		return recorded;
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Events/Event.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Cherry {
+
+	// .chinput layout (little-endian):
+	//   InputRecordingHeader
+	//   per frame: varint frame time (ns), varint event count, then per event:
+	//     type byte, varint time since the previous event (ns), then by type
+	//       KeyPressed          zigzag(keycode), varint repeat count
+	//       KeyReleased/Typed   zigzag(keycode)
+	//       MouseButton*        zigzag(button)
+	//       MouseMoved/Scrolled two floats
+	struct InputRecordingHeader
+	{
+		static constexpr uint32_t s_Magic = 0x4E494843;	// "CHIN"
+		static constexpr uint32_t s_Version = 1;
+
+		uint32_t Magic = s_Magic;
+		uint32_t Version = s_Version;
+		int64_t FixedStep = 0;		// Nanoseconds
+		uint32_t MaxFixedSteps = 0;
+		uint32_t FrameCount = 0;
+		uint64_t Seed = 0;
+	};
+
+	static_assert(sizeof(InputRecordingHeader) == 32, "InputRecordingHeader layout changed");
+
+	// Records the input events each frame dispatched, with the frame times the simulation stepped by, and
+	// plays them back in place of the window's input so a session can be rerun identically as a benchmark.
+	// Replay steps by the recorded frame times, runs unpaced with VSync off, and writes the measured frame
+	// and work times out when it finishes.
+	class InputRecorder
+	{
+	public:
+		static bool StartRecording(const std::string& filepath);
+		// Closes the application once the last recorded frame has run
+		static bool StartReplay(const std::string& filepath);
+		// Writes the recording, or the replay statistics if the replay was cut short
+		static void Stop();
+
+		static bool IsRecording();
+		static bool IsReplaying();
+
+		// For seeding anything random in the simulation: the recorded seed while replaying
+		static uint64_t GetSeed();
+
+		// Main thread, as the window delivers an event: true if a replay stands in for it
+		static bool IsSuperseded(const Event& e);
+		// Main thread, as an event is dispatched
+		static void OnEvent(const Event& e);
+		// Main thread, after the frame's own events: dispatches the replayed ones
+		static void ReplayEvents(const std::function<void(Event&)>& dispatch);
+		// Main thread, once per frame: returns the frame time to simulate with. measured is the real time
+		// since the previous frame, work the part of it not spent waiting on the pacer or buffer swap.
+		static int64_t OnFrame(int64_t frameTime, int64_t measured, int64_t work);
+	};
+}
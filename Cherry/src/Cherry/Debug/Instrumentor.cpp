@@ -0,0 +1,415 @@
+#include "CHpch.h"
+#include "Cherry/Debug/Instrumentor.h"
+
+#include "Cherry/Core/FrameAllocator.h"
+#include "Cherry/Debug/TraceWriter.h"
+
+namespace Cherry {
+
+	static int64_t SteadyNanoseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+#if CH_PROFILE_CLOCK_TSC
+	struct TSCCalibration
+	{
+		uint64_t OriginTicks;
+		int64_t OriginNanoseconds;
+		std::atomic<double> NanosecondsPerTick;
+		std::atomic<int64_t> LastCalibration;
+
+		TSCCalibration()
+		{
+			// A first rate good to a fraction of a percent; refined as the process ages
+			OriginTicks = ProfileClock::Now();
+			OriginNanoseconds = SteadyNanoseconds();
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			LastCalibration = 0;
+			Calibrate();
+		}
+
+		void Calibrate()
+		{
+			uint64_t ticks = ProfileClock::Now();
+			int64_t nanoseconds = SteadyNanoseconds();
+			NanosecondsPerTick.store((double)(nanoseconds - OriginNanoseconds) / (double)(ticks - OriginTicks), std::memory_order_relaxed);
+			LastCalibration.store(nanoseconds, std::memory_order_relaxed);
+		}
+	};
+
+	static TSCCalibration& GetCalibration()
+	{
+		static TSCCalibration calibration;
+
+		// Cheap enough once a second, from whichever thread converts
+		int64_t now = SteadyNanoseconds();
+		if (now - calibration.LastCalibration.load(std::memory_order_relaxed) > 1'000'000'000)
+			calibration.Calibrate();
+		return calibration;
+	}
+
+	int64_t ProfileClock::ToNanoseconds(uint64_t ticks)
+	{
+		TSCCalibration& calibration = GetCalibration();
+		double perTick = calibration.NanosecondsPerTick.load(std::memory_order_relaxed);
+		return calibration.OriginNanoseconds + (int64_t)((double)(int64_t)(ticks - calibration.OriginTicks) * perTick);
+	}
+
+	uint64_t ProfileClock::FromNanoseconds(int64_t nanoseconds)
+	{
+		TSCCalibration& calibration = GetCalibration();
+		double perTick = calibration.NanosecondsPerTick.load(std::memory_order_relaxed);
+		return calibration.OriginTicks + (uint64_t)(int64_t)((double)(nanoseconds - calibration.OriginNanoseconds) / perTick);
+	}
+#else
+	int64_t ProfileClock::ToNanoseconds(uint64_t ticks)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::duration((int64_t)ticks)).count();
+	}
+
+	uint64_t ProfileClock::FromNanoseconds(int64_t nanoseconds)
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(nanoseconds)).count();
+	}
+#endif
+
+	// The writer wakes this often, or sooner at session end
+	static constexpr auto s_WriterInterval = std::chrono::milliseconds(20);
+	// Output is handed to the OS in chunks of at least this size
+	static constexpr size_t s_WriteChunkSize = 1 << 20;
+
+	Instrumentor::Instrumentor() = default;
+
+	Instrumentor::~Instrumentor()
+	{
+		if (IsSessionActive())
+			EndSession();
+	}
+
+	void Instrumentor::BeginSession(const std::string& name, const std::string& filepath, TraceFormat format)
+	{
+		if (IsSessionActive())
+			EndSession();
+
+		m_OutputFile = std::fopen(filepath.c_str(), "wb");
+		if (!m_OutputFile)
+			return;
+
+		m_TraceWriter = TraceWriter::Create(format);
+		m_TraceWriter->GetOutput().reserve(s_WriteChunkSize * 2);
+		m_TraceWriter->Begin(ProfileClock::ToNanoseconds(ProfileClock::Now()));
+		m_NamedThreads.clear();
+		m_TraceWriter->WriteThreadName(GPUThreadID, "GPU");
+		m_NamedThreads.push_back(GPUThreadID);
+
+		m_FlightRecording = false;
+		StartWriter();
+	}
+
+	void Instrumentor::BeginFlightRecording(float windowSeconds)
+	{
+		if (IsSessionActive())
+			EndSession();
+
+		m_FlightWindow = (int64_t)((double)windowSeconds * 1e9);
+		m_FlightRecording = true;
+		StartWriter();
+	}
+
+	void Instrumentor::StartWriter()
+	{
+		// Leftovers from threads that were mid-scope when the last session ended
+		{
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+			for (auto& buffer : m_Buffers)
+			{
+				buffer->Drain([](const ProfileEvent&) {});
+				buffer->TakeDropped();
+			}
+		}
+
+		m_StopWriter = false;
+		m_DumpPending = false;
+		m_Active.store(true, std::memory_order_release);
+		m_Writer = std::thread(&Instrumentor::WriterLoop, this);
+	}
+
+	void Instrumentor::EndSession()
+	{
+		if (!IsSessionActive())
+			return;
+
+		m_Active.store(false, std::memory_order_release);
+		{
+			std::lock_guard<std::mutex> lock(m_WriterMutex);
+			m_StopWriter = true;
+		}
+		m_WriterCondition.notify_one();
+		m_Writer.join();
+
+		if (m_FlightRecording)
+		{
+			m_FlightChunks.clear();
+			m_FlightEventCount = 0;
+			m_FlightRecording = false;
+			return;
+		}
+
+		m_TraceWriter->End();
+		FlushOutput();
+		std::fclose(m_OutputFile);
+		m_OutputFile = nullptr;
+		m_TraceWriter.reset();
+	}
+
+	bool Instrumentor::DumpFlightRecording(const std::string& filepath, float afterSeconds)
+	{
+		if (!IsFlightRecording())
+			return false;
+
+		std::lock_guard<std::mutex> lock(m_WriterMutex);
+		if (m_DumpPending)
+			return false;
+
+		int64_t now = ProfileClock::ToNanoseconds(ProfileClock::Now());
+		m_DumpDeadline = ProfileClock::FromNanoseconds(now + (int64_t)((double)afterSeconds * 1e9));
+		m_DumpWindowStart = ProfileClock::FromNanoseconds(now - m_FlightWindow);
+		m_DumpPath = filepath;
+		m_DumpPending = true;
+		return true;
+	}
+
+	void Instrumentor::SetThreadName(const std::string& name)
+	{
+		ProfileEventBuffer& buffer = GetThreadBuffer();
+
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+		buffer.ThreadName = name;
+	}
+
+	std::vector<std::pair<uint32_t, std::string>> Instrumentor::GetThreadNames()
+	{
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+
+		std::vector<std::pair<uint32_t, std::string>> names;
+		names.emplace_back(GPUThreadID, "GPU");
+		for (auto& buffer : m_Buffers)
+		{
+			if (!buffer->ThreadName.empty())
+				names.emplace_back(buffer->ThreadID, buffer->ThreadName);
+		}
+		return names;
+	}
+
+	void Instrumentor::SetEventListener(EventListener listener)
+	{
+		std::lock_guard<std::mutex> lock(m_ListenerMutex);
+		m_Listener = std::move(listener);
+	}
+
+	ProfileEventBuffer* Instrumentor::RegisterThread()
+	{
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+
+		auto& buffer = m_Buffers.emplace_back(std::make_unique<ProfileEventBuffer>());
+		buffer->ThreadID = m_NextThreadID++;
+		return buffer.get();
+	}
+
+	void Instrumentor::WriterLoop()
+	{
+		// Formatting and dumping traces allocate freely; none of it is frame work
+		HeapAllocationScope heapAllocations;
+
+		std::unique_lock<std::mutex> lock(m_WriterMutex);
+		while (!m_StopWriter)
+		{
+			m_WriterCondition.wait_for(lock, s_WriterInterval);
+
+			// Checked before draining so the events up to the deadline go in with it
+			std::string dumpPath;
+			m_FlightKeepFrom = m_DumpPending ? m_DumpWindowStart : UINT64_MAX;
+			if (m_DumpPending && ProfileClock::Now() >= m_DumpDeadline)
+			{
+				dumpPath = std::move(m_DumpPath);
+				m_DumpPending = false;
+			}
+
+			lock.unlock();
+			Drain();
+			if (!dumpPath.empty())
+				WriteFlightRecording(dumpPath);
+			else if (!m_FlightRecording && m_TraceWriter->GetOutput().size() >= s_WriteChunkSize)
+				FlushOutput();
+			lock.lock();
+		}
+
+		// A dump still waiting on its deadline gets whatever was recorded so far
+		std::string dumpPath;
+		m_FlightKeepFrom = m_DumpPending ? m_DumpWindowStart : UINT64_MAX;
+		if (m_DumpPending)
+		{
+			dumpPath = std::move(m_DumpPath);
+			m_DumpPending = false;
+		}
+
+		// Scopes that closed just before the session ended
+		lock.unlock();
+		Drain();
+		if (!dumpPath.empty())
+			WriteFlightRecording(dumpPath);
+	}
+
+	static void WriteEvent(TraceWriter& writer, const ProfileEvent& event)
+	{
+		int64_t start = ProfileClock::ToNanoseconds(event.Start);
+		int64_t end = event.Type == ProfileEventType::Counter ? event.Value : ProfileClock::ToNanoseconds(event.End);
+		writer.WriteEvent({ event.Name, start, end, event.ThreadID, event.Type });
+	}
+
+	void Instrumentor::Drain()
+	{
+		// Registration only appends, so a snapshot of the pointers is enough to drain without the lock
+		std::vector<ProfileEventBuffer*> buffers;
+		{
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+			buffers.reserve(m_Buffers.size());
+			for (auto& buffer : m_Buffers)
+			{
+				buffers.push_back(buffer.get());
+				if (!m_FlightRecording && !buffer->ThreadName.empty() && std::find(m_NamedThreads.begin(), m_NamedThreads.end(), buffer->ThreadID) == m_NamedThreads.end())
+				{
+					m_TraceWriter->WriteThreadName(buffer->ThreadID, buffer->ThreadName);
+					m_NamedThreads.push_back(buffer->ThreadID);
+				}
+			}
+		}
+
+		// Held for the whole drain so SetEventListener cannot return while the old listener is in use
+		std::lock_guard<std::mutex> listenerLock(m_ListenerMutex);
+		bool listening = (bool)m_Listener;
+		m_ListenerEvents.clear();
+		uint64_t drainStart = ProfileClock::Now();
+
+		// Flight recording keeps the raw events; they are only converted if a dump asks for them
+		std::vector<ProfileEvent> chunk = std::move(m_SpareChunk);
+		chunk.clear();
+		auto consume = [this, &chunk, listening](const ProfileEvent& event)
+		{
+			if (m_FlightRecording)
+				chunk.push_back(event);
+			else
+				WriteEvent(*m_TraceWriter, event);
+			if (listening)
+				m_ListenerEvents.push_back(event);
+		};
+
+		for (ProfileEventBuffer* buffer : buffers)
+		{
+			buffer->Drain(consume);
+
+			if (uint64_t dropped = buffer->TakeDropped())
+			{
+				ProfileEvent event{ "Profiler Dropped Events", ProfileClock::Now(), {}, buffer->ThreadID, ProfileEventType::Counter };
+				event.Value = (int64_t)dropped;
+				consume(event);
+			}
+		}
+
+		if (listening)
+			m_Listener(m_ListenerEvents, drainStart);
+
+		if (!m_FlightRecording)
+		{
+			m_TraceWriter->Flush();
+			return;
+		}
+
+		if (!chunk.empty())
+		{
+			FlightChunk& flightChunk = m_FlightChunks.emplace_back();
+			for (const ProfileEvent& event : chunk)
+				flightChunk.Latest = std::max(flightChunk.Latest, event.Type == ProfileEventType::Scope ? event.End : event.Start);
+			m_FlightEventCount += chunk.size();
+			flightChunk.Events = std::move(chunk);
+		}
+		else
+			m_SpareChunk = std::move(chunk);
+		PruneFlightRecording();
+	}
+
+	void Instrumentor::PruneFlightRecording()
+	{
+		// Bounds memory (32 bytes an event) when the window is long or the frame heavily instrumented
+		static constexpr size_t s_MaxFlightEvents = 1 << 22;
+
+		uint64_t cutoff = ProfileClock::FromNanoseconds(ProfileClock::ToNanoseconds(ProfileClock::Now()) - m_FlightWindow);
+		cutoff = std::min(cutoff, m_FlightKeepFrom);
+		while (!m_FlightChunks.empty() && (m_FlightChunks.front().Latest < cutoff || m_FlightEventCount > s_MaxFlightEvents))
+		{
+			m_FlightEventCount -= m_FlightChunks.front().Events.size();
+			if (m_SpareChunk.capacity() < m_FlightChunks.front().Events.capacity())
+				m_SpareChunk = std::move(m_FlightChunks.front().Events);
+			m_FlightChunks.pop_front();
+		}
+	}
+
+	void Instrumentor::WriteFlightRecording(const std::string& filepath)
+	{
+		// Chunks from before the window the dump asked for are skipped
+		uint64_t windowStart = m_FlightKeepFrom == UINT64_MAX ? 0 : m_FlightKeepFrom;
+		uint64_t earliest = UINT64_MAX;
+		size_t eventCount = 0;
+		for (const FlightChunk& chunk : m_FlightChunks)
+		{
+			if (chunk.Latest < windowStart)
+				continue;
+			eventCount += chunk.Events.size();
+			for (const ProfileEvent& event : chunk.Events)
+				earliest = std::min(earliest, event.Start);
+		}
+		if (earliest == UINT64_MAX)
+			earliest = ProfileClock::Now();
+
+		SCOPE(TraceWriter) writer = TraceWriter::Create(TraceFormat::Binary);
+		writer->Begin(ProfileClock::ToNanoseconds(earliest));
+		writer->WriteThreadName(GPUThreadID, "GPU");
+		{
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+			for (auto& buffer : m_Buffers)
+			{
+				if (!buffer->ThreadName.empty())
+					writer->WriteThreadName(buffer->ThreadID, buffer->ThreadName);
+			}
+		}
+
+		for (const FlightChunk& chunk : m_FlightChunks)
+		{
+			if (chunk.Latest < windowStart)
+				continue;
+			for (const ProfileEvent& event : chunk.Events)
+				WriteEvent(*writer, event);
+			writer->Flush();
+		}
+		writer->End();
+
+		std::FILE* file = std::fopen(filepath.c_str(), "wb");
+		if (!file)
+		{
+			CH_CORE_ERROR("Could not write flight recording to {0}", filepath);
+			return;
+		}
+		const std::string& output = writer->GetOutput();
+		std::fwrite(output.data(), 1, output.size(), file);
+		std::fclose(file);
+		CH_CORE_INFO("Flight recording written to {0} ({1} events, {2} KB)", filepath, eventCount, output.size() / 1024);
+	}
+
+	void Instrumentor::FlushOutput()
+	{
+		std::string& output = m_TraceWriter->GetOutput();
+		std::fwrite(output.data(), 1, output.size(), m_OutputFile);
+		output.clear();
+	}
+}
@@ -1,136 +1,305 @@
 #pragma once
-#include <string>
+#include <atomic>
 #include <chrono>
-#include <algorithm>
-#include <fstream>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
+
+#include "Cherry/Debug/TraceFormat.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+	#define CH_PROFILE_CLOCK_TSC 1
+#else
+	#define CH_PROFILE_CLOCK_TSC 0
+#endif
 
 namespace Cherry
 {
+    class TraceWriter;
 
-    struct ProfileResult
+    // Clock for profile timestamps: the TSC where available (a few ns to read), otherwise steady_clock.
+    // Ticks are converted to steady_clock nanoseconds only when events are written out.
+    class ProfileClock
     {
-        std::string Name;
-        long long Start, End;
-        uint32_t ThreadID;
+    public:
+        inline static uint64_t Now()
+        {
+#if CH_PROFILE_CLOCK_TSC
+            return __rdtsc();
+#else
+            return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+        }
+
+        // Rate is measured against steady_clock since startup, so it sharpens the longer the app runs
+        static int64_t ToNanoseconds(uint64_t ticks);
+        static uint64_t FromNanoseconds(int64_t nanoseconds);
     };
 
-    struct InstrumentationSession
+    enum class ProfileEventType : uint8_t
     {
-        std::string Name;
+        Scope,
+        Counter
     };
 
-    class Instrumentor
+    // Fixed size and allocation free: the name must be a string literal or otherwise outlive the session
+    struct ProfileEvent
     {
-    private:
-        InstrumentationSession* m_CurrentSession;
-        std::ofstream m_OutputStream;
-        int m_ProfileCount;
-    public:
-        Instrumentor()
-            : m_CurrentSession(nullptr), m_ProfileCount(0)
+        const char* Name;
+        uint64_t Start;
+        union
         {
-        }
+            uint64_t End;           // Scope
+            int64_t Value;          // Counter
+        };
+        uint32_t ThreadID;
+        ProfileEventType Type;
+    };
+
+    // Single producer (the owning thread), single consumer (the writer). When the writer falls behind
+    // new events are dropped and counted rather than blocking the thread being measured.
+    class ProfileEventBuffer
+    {
+    public:
+        static constexpr uint32_t Capacity = 16384;
 
-        void BeginSession(const std::string& name, const std::string& filepath = "results.json")
+        inline void Push(const ProfileEvent& event)
         {
-            m_OutputStream.open(filepath);
-            WriteHeader();
-            m_CurrentSession = new InstrumentationSession{ name };
+            // The consumer's tail is only re-read when the cached copy says the buffer is full
+            uint64_t head = m_Head.load(std::memory_order_relaxed);
+            if (head - m_CachedTail >= Capacity)
+            {
+                m_CachedTail = m_Tail.load(std::memory_order_acquire);
+                if (head - m_CachedTail >= Capacity)
+                {
+                    m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+
+            m_Events[head % Capacity] = event;
+            m_Head.store(head + 1, std::memory_order_release);
         }
 
-        void EndSession()
+        // Consumer side: hands every buffered event to fn, returns how many
+        template<typename Fn>
+        uint32_t Drain(Fn&& fn)
         {
-            WriteFooter();
-            m_OutputStream.close();
-            delete m_CurrentSession;
-            m_CurrentSession = nullptr;
-            m_ProfileCount = 0;
+            uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+            uint64_t head = m_Head.load(std::memory_order_acquire);
+            for (uint64_t i = tail; i < head; i++)
+                fn(m_Events[i % Capacity]);
+            m_Tail.store(head, std::memory_order_release);
+            return (uint32_t)(head - tail);
         }
 
-        void WriteProfile(const ProfileResult& result)
+        inline uint64_t TakeDropped() { return m_Dropped.exchange(0, std::memory_order_relaxed); }
+
+        uint32_t ThreadID = 0;
+        std::string ThreadName;
+
+    private:
+        std::unique_ptr<ProfileEvent[]> m_Events{ new ProfileEvent[Capacity] };
+        // Producer and consumer halves on separate cache lines
+        alignas(64) std::atomic<uint64_t> m_Head = 0;
+        uint64_t m_CachedTail = 0;
+        std::atomic<uint64_t> m_Dropped = 0;
+        alignas(64) std::atomic<uint64_t> m_Tail = 0;
+    };
+
+    // Scopes are recorded into per-thread ring buffers and drained by a background thread, which
+    // serialises them to the session file (binary .chtrace unless asked otherwise) in large writes. Recording costs two clock reads and a
+    // buffer store; nothing is formatted, allocated or locked on the measured thread.
+    class Instrumentor
+    {
+    public:
+        // Track GPUProfiler results are written to
+        static constexpr uint32_t GPUThreadID = 0xFFFFFFFF;
+
+        Instrumentor();
+        ~Instrumentor();
+
+        void BeginSession(const std::string& name, const std::string& filepath = "results.chtrace", TraceFormat format = TraceFormat::Binary);
+        // A session that writes nothing: the writer keeps the last windowSeconds of events in memory
+        // until DumpFlightRecording asks for them. Ended by EndSession like any other.
+        void BeginFlightRecording(float windowSeconds);
+        void EndSession();
+
+        inline bool IsSessionActive() const { return m_Active.load(std::memory_order_relaxed); }
+        inline bool IsFlightRecording() const { return IsSessionActive() && m_FlightRecording; }
+
+        // Writes the retained window, plus whatever is recorded in the next afterSeconds, to a binary
+        // .chtrace from the writer thread. False if not flight recording or a dump is already pending.
+        bool DumpFlightRecording(const std::string& filepath, float afterSeconds = 0.0f);
+
+        inline void WriteProfile(const char* name, uint64_t start, uint64_t end)
         {
-            if (m_ProfileCount++ > 0)
-                m_OutputStream << ",";
-
-            std::string name = result.Name;
-            std::replace(name.begin(), name.end(), '"', '\'');
-
-            m_OutputStream << "{";
-            m_OutputStream << "\"cat\":\"function\",";
-            m_OutputStream << "\"dur\":" << (result.End - result.Start) << ',';
-            m_OutputStream << "\"name\":\"" << name << "\",";
-            m_OutputStream << "\"ph\":\"X\",";
-            m_OutputStream << "\"pid\":0,";
-            m_OutputStream << "\"tid\":" << result.ThreadID << ",";
-            m_OutputStream << "\"ts\":" << result.Start;
-            m_OutputStream << "}";
-
-            m_OutputStream.flush();
+            if (!IsSessionActive())
+                return;
+
+            ProfileEventBuffer& buffer = GetThreadBuffer();
+            buffer.Push({ name, start, { end }, buffer.ThreadID, ProfileEventType::Scope });
         }
 
-        void WriteHeader()
+        // For scopes measured on another timeline (the GPU), already converted to ProfileClock ticks
+        inline void WriteProfile(const char* name, uint64_t start, uint64_t end, uint32_t threadID)
         {
-            m_OutputStream << "{\"otherData\": {},\"traceEvents\":[";
-            m_OutputStream.flush();
+            if (!IsSessionActive())
+                return;
+
+            GetThreadBuffer().Push({ name, start, { end }, threadID, ProfileEventType::Scope });
         }
 
-        void WriteFooter()
+        // Chrome tracing counter track, one series per name
+        inline void WriteCounter(const char* name, long long value)
         {
-            m_OutputStream << "]}";
-            m_OutputStream.flush();
+            if (!IsSessionActive())
+                return;
+
+            ProfileEvent event{ name, ProfileClock::Now(), {}, 0, ProfileEventType::Counter };
+            event.Value = value;
+            ProfileEventBuffer& buffer = GetThreadBuffer();
+            event.ThreadID = buffer.ThreadID;
+            buffer.Push(event);
         }
 
+        // Labels the calling thread's track in the trace
+        void SetThreadName(const std::string& name);
+        std::vector<std::pair<uint32_t, std::string>> GetThreadNames();
+
+        // Handed every drained event on the writer thread, in whatever session is running. drainStart is
+        // when the drain began: scopes that closed before it are in this batch or an earlier one.
+        using EventListener = std::function<void(const std::vector<ProfileEvent>& events, uint64_t drainStart)>;
+        // Once this returns (with nullptr) the previous listener is no longer being called
+        void SetEventListener(EventListener listener);
+
         static Instrumentor& Get()
         {
             static Instrumentor instance;
             return instance;
         }
+
+    private:
+        inline ProfileEventBuffer& GetThreadBuffer()
+        {
+            thread_local ProfileEventBuffer* t_Buffer = nullptr;
+            if (!t_Buffer)
+                t_Buffer = RegisterThread();
+            return *t_Buffer;
+        }
+
+        ProfileEventBuffer* RegisterThread();
+
+        void StartWriter();
+        void WriterLoop();
+        // Writer thread (or EndSession once it has stopped): drains every buffer into the file,
+        // or into the flight recording
+        void Drain();
+        void FlushOutput();
+        void PruneFlightRecording();
+        void WriteFlightRecording(const std::string& filepath);
+
+    private:
+        std::atomic<bool> m_Active = false;
+
+        // Buffers outlive their threads; they are only freed with the Instrumentor
+        std::mutex m_BuffersMutex;
+        std::vector<std::unique_ptr<ProfileEventBuffer>> m_Buffers;
+        uint32_t m_NextThreadID = 1;
+
+        std::thread m_Writer;
+        std::mutex m_WriterMutex;
+        std::condition_variable m_WriterCondition;
+        bool m_StopWriter = false;
+        // Requested dump, guarded by m_WriterMutex
+        bool m_DumpPending = false;
+        std::string m_DumpPath;
+        uint64_t m_DumpDeadline = 0;
+        uint64_t m_DumpWindowStart = 0;
+
+        // Writer thread state
+        std::FILE* m_OutputFile = nullptr;
+        std::unique_ptr<TraceWriter> m_TraceWriter;
+        std::vector<uint32_t> m_NamedThreads;
+
+        std::mutex m_ListenerMutex;
+        EventListener m_Listener;
+        std::vector<ProfileEvent> m_ListenerEvents;
+
+        struct FlightChunk
+        {
+            std::vector<ProfileEvent> Events;
+            uint64_t Latest = 0;
+        };
+
+        // Flight recording: one chunk per drain, oldest first, dropped once entirely outside the window
+        bool m_FlightRecording = false;
+        int64_t m_FlightWindow = 0;
+        std::deque<FlightChunk> m_FlightChunks;
+        // Nothing after this is pruned while a dump waits on its deadline
+        uint64_t m_FlightKeepFrom = UINT64_MAX;
+        std::vector<ProfileEvent> m_SpareChunk;
+        size_t m_FlightEventCount = 0;
     };
 
     class InstrumentationTimer
     {
     public:
+        // Outside a session not even the clock is read
         InstrumentationTimer(const char* name)
-            : m_Name(name), m_Stopped(false)
+            : m_Name(name), m_Start(Instrumentor::Get().IsSessionActive() ? ProfileClock::Now() : 0)
         {
-            m_StartTimepoint = std::chrono::high_resolution_clock::now();
         }
 
         ~InstrumentationTimer()
         {
-            if (!m_Stopped)
-                Stop();
+            if (m_Start)
+                Instrumentor::Get().WriteProfile(m_Name, m_Start, ProfileClock::Now());
         }
 
-        void Stop()
-        {
-            auto endTimepoint = std::chrono::high_resolution_clock::now();
-
-            long long start = std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch().count();
-            long long end = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch().count();
-
-            uint32_t threadID = std::hash<std::thread::id>{}(std::this_thread::get_id());
-            Instrumentor::Get().WriteProfile({ m_Name, start, end, threadID });
-
-            m_Stopped = true;
-        }
     private:
         const char* m_Name;
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_StartTimepoint;
-        bool m_Stopped;
+        uint64_t m_Start;
     };
 }
 
-#define CH_PROFILE 1
+#if defined(__GNUC__) || defined(__clang__)
+	#define CH_FUNC_SIG __PRETTY_FUNCTION__
+#elif defined(_MSC_VER)
+	#define CH_FUNC_SIG __FUNCSIG__
+#else
+	#define CH_FUNC_SIG __func__
+#endif
+
+// Builds can opt out with CH_PROFILE=0 (Dist does)
+#ifndef CH_PROFILE
+	#define CH_PROFILE 1
+#endif
+
 #if CH_PROFILE
 	#define CH_PROFILE_BEGIN_SESSION(name, filepath)  ::Cherry::Instrumentor::Get().BeginSession(name, filepath)
 	#define CH_PROFILE_END_SESSION()  ::Cherry::Instrumentor::Get().EndSession()
 	#define CH_PROFILE_SCOPE(name)  ::Cherry::InstrumentationTimer timer##__LINE__(name)
-	#define CH_PROFILE_FUNCTION()   CH_PROFILE_SCOPE(__FUNCSIG__)
+	#define CH_PROFILE_FUNCTION()   CH_PROFILE_SCOPE(CH_FUNC_SIG)
+	#define CH_PROFILE_COUNTER(name, value)  ::Cherry::Instrumentor::Get().WriteCounter(name, (long long)(value))
+	#define CH_PROFILE_THREAD(name)  ::Cherry::Instrumentor::Get().SetThreadName(name)
 #else
 	#define CH_PROFILE_BEGIN_SESSION(name, filepath)
 	#define CH_PROFILE_END_SESSION()
 	#define CH_PROFILE_SCOPE(name)
 	#define CH_PROFILE_FUNCTION()
+	#define CH_PROFILE_COUNTER(name, value)
+	#define CH_PROFILE_THREAD(name)
 #endif
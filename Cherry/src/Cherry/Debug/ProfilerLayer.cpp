@@ -0,0 +1,472 @@
+#include "CHpch.h"
+#include "Cherry/Debug/ProfilerLayer.h"
+
+#include "Cherry/Debug/FlightRecorder.h"
+
+#include "imgui.h"
+
+#include <cstring>
+
+namespace Cherry {
+
+	static constexpr size_t s_MaxFrames = 300;
+	// Held while the panel is not drawn (a minimized window), beyond which events are dropped
+	static constexpr size_t s_MaxIncomingEvents = 1 << 20;
+
+	static constexpr float s_FrameGraphHeight = 80.0f;
+	static constexpr float s_FrameBarWidth = 3.0f;
+
+	static bool SameName(const char* a, const char* b)
+	{
+		// Usually the same literal; the same text from another translation unit is still the same scope
+		return a == b || std::strcmp(a, b) == 0;
+	}
+
+	static ImU32 NameColor(const char* name)
+	{
+		uint32_t hash = 2166136261u;
+		for (const char* c = name; *c; c++)
+			hash = (hash ^ (uint8_t)*c) * 16777619u;
+		return ImColor::HSV((hash % 360) / 360.0f, 0.45f, 0.75f);
+	}
+
+	static float ToMilliseconds(int64_t nanoseconds)
+	{
+		return (float)((double)nanoseconds / 1e6);
+	}
+
+	ProfilerLayer::ProfilerLayer()
+		: Layer("ProfilerLayer")
+	{
+		Subscribe<KeyPressedEvent, &ProfilerLayer::OnKeyPressed>(this);
+	}
+
+	void ProfilerLayer::OnDetach()
+	{
+		SetOpen(false);
+	}
+
+	bool ProfilerLayer::OnKeyPressed(KeyPressedEvent& e)
+	{
+		if (e.GetKeyCode() != m_ToggleKey || e.GetRepeatCount() > 0)
+			return false;
+
+		SetOpen(!m_Open);
+		return true;
+	}
+
+	void ProfilerLayer::SetOpen(bool open)
+	{
+		if (open == m_Open)
+			return;
+
+		m_Open = open;
+		if (open)
+		{
+			m_FollowLatest = true;
+			m_HasSelection = false;
+			Instrumentor::Get().SetEventListener([this](const std::vector<ProfileEvent>& events, uint64_t drainStart) { OnEvents(events, drainStart); });
+			return;
+		}
+
+		Instrumentor::Get().SetEventListener(nullptr);
+		m_Frames.clear();
+		m_FirstFrame = 0;
+		m_Incoming.clear();
+		m_Incoming.shrink_to_fit();
+	}
+
+	void ProfilerLayer::MarkFrame()
+	{
+		if (m_Paused)
+			return;
+
+		uint64_t now = ProfileClock::Now();
+		if (!m_Frames.empty())
+			m_Frames.back().End = now;
+		m_Frames.push_back({ now, 0, {} });
+
+		while (m_Frames.size() > s_MaxFrames)
+		{
+			m_Frames.pop_front();
+			m_FirstFrame++;
+		}
+	}
+
+	void ProfilerLayer::OnEvents(const std::vector<ProfileEvent>& events, uint64_t drainStart)
+	{
+		std::lock_guard<std::mutex> lock(m_IncomingMutex);
+
+		if (m_Incoming.size() + events.size() <= s_MaxIncomingEvents)
+			m_Incoming.insert(m_Incoming.end(), events.begin(), events.end());
+
+		// A scope can close just before a drain starts yet be pushed just after it, so a frame is only
+		// complete once the drain after the one that followed it has run
+		m_SettledUpTo = m_LastDrainStart;
+		m_LastDrainStart = drainStart;
+	}
+
+	void ProfilerLayer::CollectEvents()
+	{
+		uint64_t settledUpTo;
+		{
+			std::lock_guard<std::mutex> lock(m_IncomingMutex);
+			m_Collected.swap(m_Incoming);
+			settledUpTo = m_SettledUpTo;
+		}
+
+		if (!m_Paused)
+		{
+			for (const ProfileEvent& event : m_Collected)
+			{
+				if (event.Type != ProfileEventType::Scope)
+					continue;
+
+				// Scopes belong to the frame they started in; GPU scopes arrive frames late and still find theirs
+				auto it = std::upper_bound(m_Frames.begin(), m_Frames.end(), event.Start, [](uint64_t start, const Frame& frame) { return start < frame.Start; });
+				if (it != m_Frames.begin())
+					(--it)->Events.push_back(event);
+			}
+		}
+		m_Collected.clear();
+
+		if (m_HasSelection && m_SelectedFrame < m_FirstFrame)
+			m_FollowLatest = true;
+
+		if (m_FollowLatest && !m_Paused)
+		{
+			for (size_t i = m_Frames.size(); i-- > 0; )
+			{
+				if (m_Frames[i].End != 0 && m_Frames[i].End <= settledUpTo)
+				{
+					m_SelectedFrame = m_FirstFrame + i;
+					m_HasSelection = true;
+					break;
+				}
+			}
+		}
+	}
+
+	void ProfilerLayer::SelectThread()
+	{
+		// Names only change as threads start, so they are fetched again while the list is open
+		if (m_ThreadNames.empty())
+			m_ThreadNames = Instrumentor::Get().GetThreadNames();
+		if (m_SelectedThread == 0)
+		{
+			for (const auto& [threadID, name] : m_ThreadNames)
+			{
+				if (name == "Main")
+					m_SelectedThread = threadID;
+			}
+		}
+
+		// Threads that never named themselves are not listed, but one picked earlier keeps its number
+		char fallback[32];
+		const char* preview = "None";
+		if (m_SelectedThread)
+		{
+			snprintf(fallback, sizeof(fallback), "Thread %u", m_SelectedThread);
+			preview = fallback;
+		}
+		for (const auto& [threadID, name] : m_ThreadNames)
+		{
+			if (threadID == m_SelectedThread)
+				preview = name.c_str();
+		}
+
+		ImGui::SetNextItemWidth(200.0f);
+		if (ImGui::BeginCombo("Thread", preview))
+		{
+			m_ThreadNames = Instrumentor::Get().GetThreadNames();
+			for (const auto& [threadID, name] : m_ThreadNames)
+			{
+				if (ImGui::Selectable(name.c_str(), threadID == m_SelectedThread))
+					m_SelectedThread = threadID;
+			}
+			ImGui::EndCombo();
+		}
+	}
+
+	void ProfilerLayer::BuildSelectedFrame()
+	{
+		m_Tree.clear();
+		m_Flame.clear();
+		m_FlameDepth = 0;
+		m_FrameDuration = 0;
+		if (!m_HasSelection || m_SelectedFrame < m_FirstFrame || m_SelectedFrame - m_FirstFrame >= m_Frames.size())
+			return;
+
+		const Frame& frame = m_Frames[m_SelectedFrame - m_FirstFrame];
+		int64_t frameStart = ProfileClock::ToNanoseconds(frame.Start);
+		m_FrameDuration = frame.End ? ProfileClock::ToNanoseconds(frame.End) - frameStart : 0;
+
+		m_ThreadEvents.clear();
+		for (const ProfileEvent& event : frame.Events)
+		{
+			if (event.ThreadID == m_SelectedThread)
+				m_ThreadEvents.push_back(event);
+		}
+
+		// Parents first: by start, and the longer of two scopes that start together
+		std::sort(m_ThreadEvents.begin(), m_ThreadEvents.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+		{
+			return a.Start != b.Start ? a.Start < b.Start : a.End > b.End;
+		});
+
+		m_Tree.push_back({ "Frame" });
+		m_Tree[0].Inclusive = m_FrameDuration;
+		m_Tree[0].Calls = 1;
+
+		// End and node of every scope enclosing the current one
+		FrameVector<std::pair<uint64_t, uint32_t>> stack;
+		for (const ProfileEvent& event : m_ThreadEvents)
+		{
+			while (!stack.empty() && stack.back().first <= event.Start)
+				stack.pop_back();
+
+			uint32_t parent = stack.empty() ? 0 : stack.back().second;
+			uint32_t node = 0;
+			for (uint32_t child : m_Tree[parent].Children)
+			{
+				if (SameName(m_Tree[child].Name, event.Name))
+				{
+					node = child;
+					break;
+				}
+			}
+			if (node == 0)
+			{
+				node = (uint32_t)m_Tree.size();
+				m_Tree[parent].Children.push_back(node);
+				m_Tree.push_back({ event.Name });
+			}
+
+			int64_t start = ProfileClock::ToNanoseconds(event.Start);
+			int64_t duration = ProfileClock::ToNanoseconds(event.End) - start;
+			m_Tree[node].Inclusive += duration;
+			m_Tree[node].Calls++;
+
+			uint32_t depth = (uint32_t)stack.size();
+			m_Flame.push_back({ event.Name, start - frameStart, duration, depth });
+			m_FlameDepth = std::max(m_FlameDepth, depth + 1);
+
+			stack.emplace_back(event.End, node);
+		}
+
+		for (ScopeNode& node : m_Tree)
+		{
+			node.Exclusive = node.Inclusive;
+			for (uint32_t child : node.Children)
+				node.Exclusive -= m_Tree[child].Inclusive;
+
+			std::sort(node.Children.begin(), node.Children.end(), [this](uint32_t a, uint32_t b) { return m_Tree[a].Inclusive > m_Tree[b].Inclusive; });
+		}
+	}
+
+	void ProfilerLayer::OnImGuiRender()
+	{
+		if (!m_Open)
+			return;
+
+		CH_PROFILE_FUNCTION();
+
+		bool open = true;
+		ImGui::SetNextWindowSize(ImVec2(760.0f, 560.0f), ImGuiCond_FirstUseEver);
+		if (!ImGui::Begin("Profiler", &open))
+		{
+			ImGui::End();
+			if (!open)
+				SetOpen(false);
+			return;
+		}
+
+#if CH_PROFILE
+		if (!Instrumentor::Get().IsSessionActive())
+		{
+			ImGui::TextUnformatted("No profile session is running.");
+			if (ImGui::Button("Start flight recording"))
+				FlightRecorder::Start();
+		}
+		else
+		{
+			CollectEvents();
+
+			if (ImGui::Checkbox("Pause", &m_Paused) && !m_Paused && !m_Frames.empty() && m_Frames.back().End == 0)
+				m_Frames.pop_back();	// It would span the whole pause
+			ImGui::SameLine();
+			if (ImGui::Checkbox("Follow latest", &m_FollowLatest) && m_FollowLatest)
+				m_Paused = false;
+			ImGui::SameLine();
+			SelectThread();
+
+			DrawFrameGraph();
+			BuildSelectedFrame();
+
+			if (m_HasSelection)
+				ImGui::Text("Frame %llu: %.3f ms, %u scopes", (unsigned long long)m_SelectedFrame, ToMilliseconds(m_FrameDuration), (uint32_t)m_Flame.size());
+
+			if (ImGui::BeginTabBar("##ProfilerViews"))
+			{
+				if (ImGui::BeginTabItem("Call Tree"))
+				{
+					ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersV | ImGuiTableFlags_ScrollY;
+					if (!m_Tree.empty() && ImGui::BeginTable("##ScopeTree", 4, flags))
+					{
+						ImGui::TableSetupScrollFreeze(0, 1);
+						ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+						ImGui::TableSetupColumn("Inclusive ms", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+						ImGui::TableSetupColumn("Exclusive ms", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+						ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+						ImGui::TableHeadersRow();
+						DrawScopeTree(0);
+						ImGui::EndTable();
+					}
+					ImGui::EndTabItem();
+				}
+				if (ImGui::BeginTabItem("Flame Graph"))
+				{
+					DrawFlameGraph();
+					ImGui::EndTabItem();
+				}
+				ImGui::EndTabBar();
+			}
+		}
+#else
+		ImGui::TextUnformatted("Profiling is compiled out of this build (CH_PROFILE=0).");
+#endif
+
+		ImGui::End();
+		if (!open)
+			SetOpen(false);
+	}
+
+	void ProfilerLayer::DrawFrameGraph()
+	{
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+		ImGui::InvisibleButton("##FrameGraph", ImVec2(width, s_FrameGraphHeight));
+		bool hovered = ImGui::IsItemHovered();
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + s_FrameGraphHeight), ImGui::GetColorU32(ImGuiCol_FrameBg));
+
+		// Newest frame at the right edge; the one still running is not drawn
+		size_t completed = (!m_Frames.empty() && m_Frames.back().End == 0) ? m_Frames.size() - 1 : m_Frames.size();
+		size_t visible = std::min(completed, (size_t)(width / s_FrameBarWidth));
+		size_t first = completed - visible;
+
+		// Scaled to 33.3 ms, or the slowest frame shown when that is longer
+		float scale = 1000.0f / 30.0f;
+		for (size_t i = first; i < completed; i++)
+			scale = std::max(scale, ToMilliseconds(ProfileClock::ToNanoseconds(m_Frames[i].End) - ProfileClock::ToNanoseconds(m_Frames[i].Start)));
+
+		float bottom = origin.y + s_FrameGraphHeight;
+		for (float budget : { 1000.0f / 60.0f, 1000.0f / 30.0f })
+		{
+			float y = bottom - budget / scale * s_FrameGraphHeight;
+			drawList->AddLine(ImVec2(origin.x, y), ImVec2(origin.x + width, y), IM_COL32(255, 255, 255, 48));
+		}
+
+		float left = origin.x + width - visible * s_FrameBarWidth;
+		int64_t hoveredFrame = -1;
+		for (size_t i = first; i < completed; i++)
+		{
+			const Frame& frame = m_Frames[i];
+			float milliseconds = ToMilliseconds(ProfileClock::ToNanoseconds(frame.End) - ProfileClock::ToNanoseconds(frame.Start));
+			float x = left + (i - first) * s_FrameBarWidth;
+			float y = bottom - std::min(milliseconds / scale, 1.0f) * s_FrameGraphHeight;
+
+			uint64_t index = m_FirstFrame + i;
+			ImU32 color = milliseconds > 1000.0f / 30.0f ? IM_COL32(220, 70, 60, 255) : milliseconds > 1000.0f / 60.0f ? IM_COL32(220, 180, 60, 255) : IM_COL32(90, 180, 90, 255);
+			if (m_HasSelection && index == m_SelectedFrame)
+				color = IM_COL32(255, 255, 255, 255);
+			drawList->AddRectFilled(ImVec2(x, y), ImVec2(x + s_FrameBarWidth - 1.0f, bottom), color);
+
+			if (hovered && ImGui::GetIO().MousePos.x >= x && ImGui::GetIO().MousePos.x < x + s_FrameBarWidth)
+			{
+				hoveredFrame = (int64_t)index;
+				ImGui::SetTooltip("Frame %llu: %.3f ms", (unsigned long long)index, milliseconds);
+			}
+		}
+
+		// Picking a frame stops following the newest one
+		if (hoveredFrame >= 0 && ImGui::IsItemClicked())
+		{
+			m_SelectedFrame = (uint64_t)hoveredFrame;
+			m_HasSelection = true;
+			m_FollowLatest = false;
+		}
+	}
+
+	void ProfilerLayer::DrawScopeTree(uint32_t index)
+	{
+		const ScopeNode& node = m_Tree[index];
+
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth;
+		if (node.Children.empty())
+			flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+		if (index == 0)
+			flags |= ImGuiTreeNodeFlags_DefaultOpen;
+		// Keyed by name so a node stays open as frames change underneath it
+		bool open = ImGui::TreeNodeEx(node.Name, flags, "%s", node.Name);
+
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", ToMilliseconds(node.Inclusive));
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", ToMilliseconds(node.Exclusive));
+		ImGui::TableNextColumn();
+		ImGui::Text("%u", node.Calls);
+
+		if (open && !node.Children.empty())
+		{
+			for (uint32_t child : node.Children)
+				DrawScopeTree(child);
+			ImGui::TreePop();
+		}
+	}
+
+	void ProfilerLayer::DrawFlameGraph()
+	{
+		if (m_FrameDuration <= 0)
+			return;
+
+		float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+		float height = std::max(m_FlameDepth, 1u) * rowHeight;
+		ImGui::InvisibleButton("##FlameGraph", ImVec2(width, height));
+		bool hovered = ImGui::IsItemHovered();
+		ImVec2 mouse = ImGui::GetIO().MousePos;
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		ImVec2 end(origin.x + width, origin.y + height);
+		drawList->PushClipRect(origin, end, true);
+
+		// Scopes that run on past the end of the frame are cut off at its edge
+		float scale = width / (float)m_FrameDuration;
+		for (const FlameBar& bar : m_Flame)
+		{
+			float x0 = origin.x + bar.Start * scale;
+			float x1 = std::max(x0 + 1.0f, x0 + bar.Duration * scale);
+			float y0 = origin.y + bar.Depth * rowHeight;
+			float y1 = y0 + rowHeight - 1.0f;
+			if (x1 < origin.x || x0 > end.x)
+				continue;
+
+			drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), NameColor(bar.Name));
+			if (x1 - x0 > 24.0f)
+			{
+				ImVec4 clip(std::max(x0, origin.x) + 2.0f, y0, std::min(x1, end.x) - 2.0f, y1);
+				drawList->AddText(nullptr, 0.0f, ImVec2(clip.x, y0 + 2.0f), IM_COL32(0, 0, 0, 255), bar.Name, nullptr, 0.0f, &clip);
+			}
+
+			if (hovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1)
+				ImGui::SetTooltip("%s\n%.3f ms", bar.Name, ToMilliseconds(bar.Duration));
+		}
+
+		drawList->PopClipRect();
+	}
+}
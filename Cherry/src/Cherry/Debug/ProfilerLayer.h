@@ -0,0 +1,97 @@
+#pragma once
+#include "Cherry/Core/FrameAllocator.h"
+#include "Cherry/Core/Layer.h"
+#include "Cherry/Core/KeyCodes.h"
+#include "Cherry/Debug/Instrumentor.h"
+#include "Cherry/Events/KeyEvent.h"
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace Cherry {
+
+	// Live view of the CH_PROFILE_SCOPE data: a frame-time graph, the call tree of the selected frame and its
+	// flame graph. Toggled with F10; while closed it does not listen to the Instrumentor at all.
+	class ProfilerLayer : public Layer
+	{
+	public:
+		ProfilerLayer();
+
+		virtual void OnDetach() override;
+		virtual void OnImGuiRender() override;
+
+		// Main thread, at the top of every frame
+		inline void BeginFrame() { if (m_Open) MarkFrame(); }
+
+		void SetOpen(bool open);
+		inline bool IsOpen() const { return m_Open; }
+
+	private:
+		struct Frame
+		{
+			uint64_t Start;
+			uint64_t End;		// 0 until the next frame begins
+			std::vector<ProfileEvent> Events;
+		};
+
+		// Every call of the same scope under the same parent, summed
+		struct ScopeNode
+		{
+			const char* Name;
+			int64_t Inclusive = 0;
+			int64_t Exclusive = 0;
+			uint32_t Calls = 0;
+			// The tree is rebuilt every frame it is drawn
+			FrameVector<uint32_t> Children;
+		};
+
+		struct FlameBar
+		{
+			const char* Name;
+			int64_t Start;		// From the frame start
+			int64_t Duration;
+			uint32_t Depth;
+		};
+
+		bool OnKeyPressed(KeyPressedEvent& e);
+		void MarkFrame();
+		// Writer thread
+		void OnEvents(const std::vector<ProfileEvent>& events, uint64_t drainStart);
+		void CollectEvents();
+		void SelectThread();
+		void BuildSelectedFrame();
+
+		void DrawFrameGraph();
+		void DrawScopeTree(uint32_t node);
+		void DrawFlameGraph();
+
+	private:
+		bool m_Open = false;
+		bool m_Paused = false;
+		bool m_FollowLatest = true;
+		int m_ToggleKey = CH_KEY_F10;
+
+		std::deque<Frame> m_Frames;
+		// Frames are numbered from the first one recorded since the panel opened
+		uint64_t m_FirstFrame = 0;
+		uint64_t m_SelectedFrame = 0;
+		bool m_HasSelection = false;
+		uint32_t m_SelectedThread = 0;
+		std::vector<std::pair<uint32_t, std::string>> m_ThreadNames;
+
+		std::mutex m_IncomingMutex;
+		std::vector<ProfileEvent> m_Incoming;
+		uint64_t m_LastDrainStart = 0;
+		// Frames that ended before this have all their CPU scopes
+		uint64_t m_SettledUpTo = 0;
+		std::vector<ProfileEvent> m_Collected;
+
+		// The selected frame, rebuilt every time the panel draws
+		std::vector<ProfileEvent> m_ThreadEvents;
+		std::vector<ScopeNode> m_Tree;
+		std::vector<FlameBar> m_Flame;
+		uint32_t m_FlameDepth = 0;
+		int64_t m_FrameDuration = 0;
+	};
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace Cherry {
+
+	enum class TraceFormat
+	{
+		Binary,		// .chtrace, described below; CherryTraceTool converts it to JSON
+		JSON		// Chrome tracing / Perfetto
+	};
+
+	// .chtrace layout (little-endian):
+	//   TraceHeader
+	//   records to the end of the file, each a TraceRecord byte followed by varints:
+	//     String   id, length, bytes		scope names, interned on first use
+	//     Thread   thread id, name id
+	//     Events   thread id, count, then per event:
+	//                type, name id, zigzag(start - previous start), duration (scope) or zigzag(value) (counter)
+	// Times are nanoseconds relative to TraceHeader::StartTime. Every thread id is its own delta-encoded
+	// stream, so records of different threads may be interleaved freely.
+
+	enum class TraceRecord : uint8_t
+	{
+		String = 1,
+		Thread = 2,
+		Events = 3
+	};
+
+	struct TraceHeader
+	{
+		static constexpr uint32_t s_Magic = 0x52544843;	// "CHTR"
+		static constexpr uint32_t s_Version = 1;
+
+		uint32_t Magic = s_Magic;
+		uint32_t Version = s_Version;
+		int64_t StartTime = 0;		// steady_clock nanoseconds
+	};
+
+	static_assert(sizeof(TraceHeader) == 16, "TraceHeader layout changed");
+
+	// LEB128 with zigzag for signed values: small deltas take one or two bytes
+	namespace Varint {
+
+		inline void Write(std::string& output, uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				output += (char)(value | 0x80);
+				value >>= 7;
+			}
+			output += (char)value;
+		}
+
+		inline void WriteSigned(std::string& output, int64_t value)
+		{
+			Write(output, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+		}
+
+		// Advances data; false on truncated or overlong input
+		inline bool Read(const uint8_t*& data, const uint8_t* end, uint64_t& value)
+		{
+			value = 0;
+			for (uint32_t shift = 0; shift < 64 && data < end; shift += 7)
+			{
+				uint8_t byte = *data++;
+				value |= (uint64_t)(byte & 0x7f) << shift;
+				if (!(byte & 0x80))
+					return true;
+			}
+			return false;
+		}
+
+		inline bool ReadSigned(const uint8_t*& data, const uint8_t* end, int64_t& value)
+		{
+			uint64_t encoded;
+			if (!Read(data, end, encoded))
+				return false;
+			value = (int64_t)(encoded >> 1) ^ -(int64_t)(encoded & 1);
+			return true;
+		}
+	}
+}
@@ -0,0 +1,193 @@
+#include "CHpch.h"
+#include "Cherry/Debug/TraceWriter.h"
+
+#include <charconv>
+
+namespace Cherry {
+
+	SCOPE(TraceWriter) TraceWriter::Create(TraceFormat format)
+	{
+		switch (format)
+		{
+		case TraceFormat::Binary:	return CREATE_SCOPE(BinaryTraceWriter);
+		case TraceFormat::JSON:		return CREATE_SCOPE(JSONTraceWriter);
+		}
+
+		CH_CORE_ASSERT(false, "Unknown TraceFormat!");
+		return nullptr;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+	// JSON
+
+	static void AppendInteger(std::string& output, int64_t value)
+	{
+		char digits[24];
+		auto result = std::to_chars(digits, digits + sizeof(digits), value);
+		output.append(digits, result.ptr);
+	}
+
+	// Microseconds with nanosecond precision, the unit Chrome tracing expects
+	static void AppendMicroseconds(std::string& output, int64_t nanoseconds)
+	{
+		if (nanoseconds < 0)
+		{
+			output += '-';
+			nanoseconds = -nanoseconds;
+		}
+		AppendInteger(output, nanoseconds / 1000);
+		output += '.';
+		int64_t fraction = nanoseconds % 1000;
+		output += (char)('0' + fraction / 100);
+		output += (char)('0' + fraction / 10 % 10);
+		output += (char)('0' + fraction % 10);
+	}
+
+	static void AppendName(std::string& output, const char* name)
+	{
+		for (const char* c = name; *c; c++)
+		{
+			if (*c == '"' || *c == '\\')
+				output += '\'';
+			else
+				output += *c;
+		}
+	}
+
+	void JSONTraceWriter::Begin(int64_t startTime)
+	{
+		m_Output += "{\"otherData\": {},\"traceEvents\":[";
+		m_EntryCount = 0;
+	}
+
+	void JSONTraceWriter::BeginEntry()
+	{
+		if (m_EntryCount++ > 0)
+			m_Output += ',';
+	}
+
+	void JSONTraceWriter::WriteThreadName(uint32_t threadID, const std::string& name)
+	{
+		BeginEntry();
+		m_Output += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":";
+		AppendInteger(m_Output, threadID);
+		m_Output += ",\"args\":{\"name\":\"";
+		AppendName(m_Output, name.c_str());
+		m_Output += "\"}}";
+	}
+
+	void JSONTraceWriter::WriteEvent(const TraceEvent& event)
+	{
+		BeginEntry();
+		if (event.Type == ProfileEventType::Counter)
+		{
+			m_Output += "{\"cat\":\"counter\",\"name\":\"";
+			AppendName(m_Output, event.Name);
+			m_Output += "\",\"ph\":\"C\",\"pid\":0,\"ts\":";
+			AppendMicroseconds(m_Output, event.Start);
+			m_Output += ",\"args\":{\"value\":";
+			AppendInteger(m_Output, event.End);
+			m_Output += "}}";
+			return;
+		}
+
+		m_Output += "{\"cat\":\"function\",\"dur\":";
+		AppendMicroseconds(m_Output, event.End - event.Start);
+		m_Output += ",\"name\":\"";
+		AppendName(m_Output, event.Name);
+		m_Output += "\",\"ph\":\"X\",\"pid\":0,\"tid\":";
+		AppendInteger(m_Output, event.ThreadID);
+		m_Output += ",\"ts\":";
+		AppendMicroseconds(m_Output, event.Start);
+		m_Output += '}';
+	}
+
+	void JSONTraceWriter::End()
+	{
+		m_Output += "]}";
+	}
+
+	//////////////////////////////////////////////////////////////////////////////////
+	// Binary
+
+	void BinaryTraceWriter::Begin(int64_t startTime)
+	{
+		m_StartTime = startTime;
+		m_StringIDs.clear();
+		m_NextStringID = 0;
+		m_Threads.clear();
+
+		TraceHeader header;
+		header.StartTime = startTime;
+		m_Output.append((const char*)&header, sizeof(header));
+	}
+
+	uint32_t BinaryTraceWriter::WriteString(const std::string& string)
+	{
+		uint32_t id = m_NextStringID++;
+		m_Output += (char)TraceRecord::String;
+		Varint::Write(m_Output, id);
+		Varint::Write(m_Output, string.size());
+		m_Output += string;
+		return id;
+	}
+
+	uint32_t BinaryTraceWriter::InternString(const char* string)
+	{
+		auto it = m_StringIDs.find(string);
+		if (it != m_StringIDs.end())
+			return it->second;
+
+		uint32_t id = WriteString(string);
+		m_StringIDs.emplace(string, id);
+		return id;
+	}
+
+	void BinaryTraceWriter::WriteThreadName(uint32_t threadID, const std::string& name)
+	{
+		uint32_t nameID = WriteString(name);
+		m_Output += (char)TraceRecord::Thread;
+		Varint::Write(m_Output, threadID);
+		Varint::Write(m_Output, nameID);
+	}
+
+	void BinaryTraceWriter::WriteEvent(const TraceEvent& event)
+	{
+		m_Threads[event.ThreadID].Pending.push_back(event);
+	}
+
+	void BinaryTraceWriter::Flush()
+	{
+		for (auto& [threadID, stream] : m_Threads)
+		{
+			if (stream.Pending.empty())
+				continue;
+
+			// Strings go out ahead of the record that first uses them
+			for (const auto& event : stream.Pending)
+				InternString(event.Name);
+
+			m_Output += (char)TraceRecord::Events;
+			Varint::Write(m_Output, threadID);
+			Varint::Write(m_Output, stream.Pending.size());
+			for (const auto& event : stream.Pending)
+			{
+				int64_t start = event.Start - m_StartTime;
+				m_Output += (char)event.Type;
+				Varint::Write(m_Output, m_StringIDs[event.Name]);
+				Varint::WriteSigned(m_Output, start - stream.PreviousStart);
+				if (event.Type == ProfileEventType::Counter)
+					Varint::WriteSigned(m_Output, event.End);
+				else
+					Varint::Write(m_Output, (uint64_t)std::max<int64_t>(event.End - event.Start, 0));
+				stream.PreviousStart = start;
+			}
+			stream.Pending.clear();
+		}
+	}
+
+	void BinaryTraceWriter::End()
+	{
+		Flush();
+	}
+}
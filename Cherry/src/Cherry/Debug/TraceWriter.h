@@ -0,0 +1,84 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Debug/Instrumentor.h"
+#include "Cherry/Debug/TraceFormat.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Cherry {
+
+	// A ProfileEvent with its times already converted to steady_clock nanoseconds
+	struct TraceEvent
+	{
+		const char* Name;
+		int64_t Start;
+		int64_t End;		// Scope end, or the value of a counter
+		uint32_t ThreadID;
+		ProfileEventType Type;
+	};
+
+	// Serialises trace events into an in-memory buffer the caller writes out whenever it likes
+	class TraceWriter
+	{
+	public:
+		virtual ~TraceWriter() = default;
+
+		virtual void Begin(int64_t startTime) = 0;
+		virtual void WriteThreadName(uint32_t threadID, const std::string& name) = 0;
+		virtual void WriteEvent(const TraceEvent& event) = 0;
+		// Encodes anything batched by WriteEvent; called after each drain
+		virtual void Flush() {}
+		virtual void End() = 0;
+
+		inline std::string& GetOutput() { return m_Output; }
+
+		static SCOPE(TraceWriter) Create(TraceFormat format);
+
+	protected:
+		std::string m_Output;
+	};
+
+	class JSONTraceWriter : public TraceWriter
+	{
+	public:
+		virtual void Begin(int64_t startTime) override;
+		virtual void WriteThreadName(uint32_t threadID, const std::string& name) override;
+		virtual void WriteEvent(const TraceEvent& event) override;
+		virtual void End() override;
+
+	private:
+		void BeginEntry();
+
+	private:
+		uint32_t m_EntryCount = 0;
+	};
+
+	class BinaryTraceWriter : public TraceWriter
+	{
+	public:
+		virtual void Begin(int64_t startTime) override;
+		virtual void WriteThreadName(uint32_t threadID, const std::string& name) override;
+		virtual void WriteEvent(const TraceEvent& event) override;
+		virtual void Flush() override;
+		virtual void End() override;
+
+	private:
+		uint32_t InternString(const char* string);
+		uint32_t WriteString(const std::string& string);
+
+	private:
+		struct ThreadStream
+		{
+			int64_t PreviousStart = 0;
+			std::vector<TraceEvent> Pending;
+		};
+
+		int64_t m_StartTime = 0;
+		// Names are literals, so their address identifies them
+		std::unordered_map<const char*, uint32_t> m_StringIDs;
+		uint32_t m_NextStringID = 0;
+		std::unordered_map<uint32_t, ThreadStream> m_Threads;
+	};
+}
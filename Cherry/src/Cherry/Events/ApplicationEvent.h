@@ -36,6 +36,22 @@ namespace Cherry {
 		EVENT_CLASS_CATEGORY(EventCategoryApplication)
 	};
 
+	class CHERRY_API WindowFocusEvent : public Event
+	{
+	public:
+		WindowFocusEvent() {}
+		EVENT_CLASS_TYPE(WindowFocus)
+		EVENT_CLASS_CATEGORY(EventCategoryApplication)
+	};
+
+	class CHERRY_API WindowLostFocusEvent : public Event
+	{
+	public:
+		WindowLostFocusEvent() {}
+		EVENT_CLASS_TYPE(WindowLostFocus)
+		EVENT_CLASS_CATEGORY(EventCategoryApplication)
+	};
+
 	class CHERRY_API AppTickEvent : public Event
 	{
 	public:
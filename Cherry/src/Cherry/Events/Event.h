@@ -6,9 +6,9 @@
 
 namespace Cherry {
 
-	//EVENTS IN CHERRY ENGINE IS BLOCKING, MEANING THAT WHEN AN EVENT
-	//OCCURS IT IMMEDIATLY DISPATCHED AND MUST DEALT WAITH RIGHT THEN AND THERE
-	//TODO : FOR FUTURE WE MIGHT USE BUFFER EVENTS
+	//EVENTS IN CHERRY ENGINE ARE BUFFERED: THE APPLICATION QUEUES THEM AS THEY ARRIVE (SEE EventQueue)
+	//AND DISPATCHES THEM TOGETHER AT THE START OF THE NEXT FRAME. TYPES MARKED IMMEDIATE (WINDOW CLOSE
+	//AND RESIZE BY DEFAULT) ARE STILL DISPATCHED RIGHT THEN AND THERE
 
 	enum class EventType
 	{
@@ -19,6 +19,8 @@ namespace Cherry {
 		MouseButtonPressed,MouseButtonReleased,MouseMoved,MouseScrolled
 	};
 
+	constexpr uint32_t s_EventTypeCount = (uint32_t)EventType::MouseScrolled + 1;
+
 	enum EventCategory
 	{
 		None = 0,
@@ -29,6 +31,25 @@ namespace Cherry {
 		EventCategoryMouseButton = BIT(4)
 	};
 
+	// The categories every event of the type reports, without an instance to ask
+	constexpr int GetEventTypeCategories(EventType type)
+	{
+		switch (type)
+		{
+		case EventType::WindowClose: case EventType::WindowResize: case EventType::WindowFocus:
+		case EventType::WindowLostFocus: case EventType::WindowMoved:
+		case EventType::AppTick: case EventType::AppUpdate: case EventType::AppRender:
+			return EventCategoryApplication;
+		case EventType::KeyPressed: case EventType::KeyReleased: case EventType::KeyTyped:
+			return EventCategoryInput | EventCategoryKeyboard;
+		case EventType::MouseButtonPressed: case EventType::MouseButtonReleased:
+		case EventType::MouseMoved: case EventType::MouseScrolled:
+			return EventCategoryMouse | EventCategoryInput;
+		default:
+			return 0;
+		}
+	}
+
 #define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::type; }\
 							  virtual EventType GetEventType() const override { return GetStaticType(); }\
 							  virtual const char* GetName() const override { return #type; }
@@ -51,10 +72,8 @@ namespace Cherry {
 			return GetCategoryFlags() & category;
 		}
 	public:
+		// Events hold nothing that needs destroying, so the queue can store them by value
 		bool Handled = false;
-	protected:
-		bool m_handled = false;
-		std::string m_event;
 	};
 
 	class EventDispatcher
@@ -0,0 +1,69 @@
+#include "CHpch.h"
+#include "Cherry/Events/EventQueue.h"
+
+#include "Cherry/Events/ApplicationEvent.h"
+#include "Cherry/Events/KeyEvent.h"
+
+#include <cstddef>
+
+namespace Cherry {
+
+	// Every event is stored on a boundary suitable for any of its members
+	static constexpr size_t s_EventAlignment = alignof(std::max_align_t);
+
+	EventQueue::EventQueue()
+	{
+		SetImmediate(EventType::WindowClose, true);
+		SetImmediate(EventType::WindowResize, true);
+	}
+
+	void EventQueue::SetImmediate(EventType type, bool immediate)
+	{
+		if (immediate)
+			m_ImmediateTypes |= 1u << (uint32_t)type;
+		else
+			m_ImmediateTypes &= ~(1u << (uint32_t)type);
+	}
+
+	void* EventQueue::Allocate(size_t size)
+	{
+		size_t offset = (m_Pending.Data.size() + s_EventAlignment - 1) & ~(s_EventAlignment - 1);
+		m_Pending.Data.resize(offset + size);
+		m_Pending.Offsets.push_back((uint32_t)offset);
+		return m_Pending.Data.data() + offset;
+	}
+
+	Event* EventQueue::GetLast(EventType type)
+	{
+		if (m_Pending.Offsets.empty())
+			return nullptr;
+
+		Event* last = (Event*)(m_Pending.Data.data() + m_Pending.Offsets.back());
+		return last->GetEventType() == type ? last : nullptr;
+	}
+
+	void EventQueue::Push(const Event& event)
+	{
+		switch (event.GetEventType())
+		{
+		case EventType::WindowClose:			Push(static_cast<const WindowCloseEvent&>(event)); return;
+		case EventType::WindowResize:			Push(static_cast<const WindowResizeEvent&>(event)); return;
+		case EventType::WindowFocus:			Push(static_cast<const WindowFocusEvent&>(event)); return;
+		case EventType::WindowLostFocus:		Push(static_cast<const WindowLostFocusEvent&>(event)); return;
+		case EventType::AppTick:				Push(static_cast<const AppTickEvent&>(event)); return;
+		case EventType::AppUpdate:				Push(static_cast<const AppUpdateEvent&>(event)); return;
+		case EventType::AppRender:				Push(static_cast<const AppRenderEvent&>(event)); return;
+		case EventType::KeyPressed:				Push(static_cast<const KeyPressedEvent&>(event)); return;
+		case EventType::KeyReleased:			Push(static_cast<const KeyReleasedEvent&>(event)); return;
+		case EventType::KeyTyped:				Push(static_cast<const KeyTypedEvent&>(event)); return;
+		case EventType::MouseButtonPressed:		Push(static_cast<const MouseButtonPressedEvent&>(event)); return;
+		case EventType::MouseButtonReleased:	Push(static_cast<const MouseButtonReleasedEvent&>(event)); return;
+		case EventType::MouseMoved:				Push(static_cast<const MouseMovedEvent&>(event)); return;
+		case EventType::MouseScrolled:			Push(static_cast<const MouseScrolledEvent&>(event)); return;
+		default:
+			break;
+		}
+
+		CH_CORE_ASSERT(false, "Event type cannot be queued!");
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Events/Event.h"
+#include "Cherry/Events/MouseEvent.h"
+
+#include <type_traits>
+#include <vector>
+
+namespace Cherry {
+
+	// Events raised during a frame, copied by value into a linear buffer that is reset every frame and
+	// dispatched in one pass. A mouse move or scroll straight after another of its kind is merged into it.
+	class EventQueue
+	{
+	public:
+		EventQueue();
+
+		template<typename T>
+		void Push(const T& event)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "Only events can be queued");
+			static_assert(std::is_trivially_destructible_v<T>, "Queued events are never destroyed");
+
+			if constexpr (std::is_same_v<T, MouseMovedEvent>)
+			{
+				if (Event* last = GetLast(EventType::MouseMoved))
+				{
+					*static_cast<MouseMovedEvent*>(last) = event;
+					return;
+				}
+			}
+			else if constexpr (std::is_same_v<T, MouseScrolledEvent>)
+			{
+				if (Event* last = GetLast(EventType::MouseScrolled))
+				{
+					auto& scrolled = *static_cast<MouseScrolledEvent*>(last);
+					scrolled = MouseScrolledEvent(scrolled.GetXOffset() + event.GetXOffset(), scrolled.GetYOffset() + event.GetYOffset());
+					return;
+				}
+			}
+
+			new (Allocate(sizeof(T))) T(event);
+		}
+
+		// Copies any engine event by its dynamic type
+		void Push(const Event& event);
+
+		// Hands every queued event to fn in arrival order. Events pushed meanwhile wait for the next call.
+		template<typename F>
+		void Dispatch(const F& fn)
+		{
+			std::swap(m_Pending, m_Dispatching);
+			for (uint32_t offset : m_Dispatching.Offsets)
+				fn(*(Event*)(m_Dispatching.Data.data() + offset));
+			m_Dispatching.Clear();
+		}
+
+		inline bool IsEmpty() const { return m_Pending.Offsets.empty(); }
+		inline size_t GetSize() const { return m_Pending.Offsets.size(); }
+
+		// Immediate events skip the queue: dispatched from inside the window callback as they arrive
+		void SetImmediate(EventType type, bool immediate);
+		inline bool IsImmediate(EventType type) const { return m_ImmediateTypes & (1u << (uint32_t)type); }
+
+	private:
+		void* Allocate(size_t size);
+		Event* GetLast(EventType type);
+
+	private:
+		struct Buffer
+		{
+			// Capacity is kept between frames, so a steady frame allocates nothing
+			std::vector<uint8_t> Data;
+			std::vector<uint32_t> Offsets;
+
+			void Clear() { Data.clear(); Offsets.clear(); }
+		};
+
+		Buffer m_Pending;
+		Buffer m_Dispatching;
+		uint32_t m_ImmediateTypes = 0;
+	};
+}
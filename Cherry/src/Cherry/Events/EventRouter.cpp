@@ -0,0 +1,43 @@
+#include "CHpch.h"
+#include "Cherry/Events/EventRouter.h"
+
+namespace Cherry {
+
+	void EventRouter::Rebuild(LayerStack& layers)
+	{
+		CH_PROFILE_FUNCTION();
+
+		for (auto& handlers : m_Handlers)
+			handlers.clear();
+
+		for (auto it = layers.end(); it != layers.begin(); )
+		{
+			Layer* layer = *--it;
+			if (!layer->HasEventSubscriptions())
+			{
+				for (auto& handlers : m_Handlers)
+					handlers.push_back(Layer::EventHandler::Bind<&Layer::OnEvent>(layer));
+				continue;
+			}
+
+			for (const auto& subscription : layer->GetEventSubscriptions())
+				m_Handlers[(uint32_t)subscription.Type].push_back(subscription.Handler);
+		}
+
+		m_Dirty = false;
+		m_Generation = Layer::GetSubscriptionGeneration();
+	}
+
+	void EventRouter::Dispatch(LayerStack& layers, Event& event)
+	{
+		if (m_Dirty || m_Generation != Layer::GetSubscriptionGeneration())
+			Rebuild(layers);
+
+		for (const auto& handler : m_Handlers[(uint32_t)event.GetEventType()])
+		{
+			handler(event);
+			if (event.Handled)
+				break;
+		}
+	}
+}
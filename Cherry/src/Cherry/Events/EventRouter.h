@@ -0,0 +1,30 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Core/LayerStack.h"
+#include "Cherry/Events/Event.h"
+
+#include <array>
+#include <vector>
+
+namespace Cherry {
+
+	// Per event type, the handlers of every layer subscribed to it, top of the stack first. Dispatch
+	// visits only those, so its cost follows the subscriber count rather than the layer count.
+	class EventRouter
+	{
+	public:
+		// Call after the stack changes; subscription changes are picked up on their own
+		inline void Invalidate() { m_Dirty = true; }
+
+		// Stops at the first handler that marks the event handled
+		void Dispatch(LayerStack& layers, Event& event);
+
+	private:
+		void Rebuild(LayerStack& layers);
+
+	private:
+		std::array<std::vector<Layer::EventHandler>, s_EventTypeCount> m_Handlers;
+		bool m_Dirty = true;
+		uint32_t m_Generation = 0;
+	};
+}
@@ -8,8 +8,8 @@ namespace Cherry {
 	public:
 		MouseMovedEvent(float x,float y)
 			:m_MouseX(x), m_MouseY(y) { }
-		inline float GetX() { return m_MouseX; }
-		inline float GetY() { return m_MouseY; }
+		inline float GetX() const { return m_MouseX; }
+		inline float GetY() const { return m_MouseY; }
 
 		std::string ToString() const override
 		{
@@ -33,8 +33,8 @@ namespace Cherry {
 		MouseScrolledEvent(float xOffset, float yOffset)
 			:m_XOffset(xOffset), m_YOffset(yOffset) {
 		}
-		inline float GetXOffset() { return m_XOffset; }
-		inline float GetYOffset() { return m_YOffset; }
+		inline float GetXOffset() const { return m_XOffset; }
+		inline float GetYOffset() const { return m_YOffset; }
 		std::string ToString() const override
 		{
 			std::stringstream ss;
@@ -52,7 +52,7 @@ namespace Cherry {
 	class CHERRY_API MouseButtonEvent : public Event
 	{
 	public:
-		inline int GetMouseButton() { return m_Button; }
+		inline int GetMouseButton() const { return m_Button; }
 		EVENT_CLASS_CATEGORY(EventCategoryMouse | EventCategoryInput)
 	protected:
 		MouseButtonEvent(int button)
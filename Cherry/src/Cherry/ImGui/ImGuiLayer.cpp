@@ -6,6 +6,9 @@
 #include "backends/imgui_impl_glfw.h"
 
 #include "Cherry/Core/Application.h"
+#include "Cherry/Core/Clock.h"
+#include "Cherry/Renderer/RendererAPI.h"
+#include "Cherry/Renderer/GPUProfiler.h"
 
 //Temporary include for GLFW and glad
 #include <GLFW/glfw3.h>
@@ -13,6 +16,8 @@
 namespace Cherry {
     ImGuiLayer::ImGuiLayer() :Layer("ImGuiLayer")
     {
+        // The GLFW backend installs its own callbacks; nothing needs routing here
+        SubscribeCategories(0);
         CH_CORE_INFO("ImGuiLayer created");
     }
     ImGuiLayer::~ImGuiLayer()
@@ -45,6 +50,18 @@ namespace Cherry {
         }
 
         Application& app = Application::Get();
+
+        // The Null renderer has no GL to draw with: frames are still built so UI code runs and can be measured
+        if (RendererAPI::GetAPI() == RendererAPI::API::Null)
+        {
+            m_HasBackends = false;
+            io.ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+            unsigned char* pixels;
+            int width, height;
+            io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+            return;
+        }
+
         GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow().GetNativeWindow());
 
 
@@ -58,8 +75,11 @@ namespace Cherry {
     {
         CH_PROFILE_FUNCTION();
 
-        ImGui_ImplOpenGL3_Shutdown();
-        ImGui_ImplGlfw_Shutdown();
+        if (m_HasBackends)
+        {
+            ImGui_ImplOpenGL3_Shutdown();
+            ImGui_ImplGlfw_Shutdown();
+        }
         ImGui::DestroyContext();
         CH_CORE_INFO("ImGuiLayer detached and resources cleaned up");
     }
@@ -69,8 +89,20 @@ namespace Cherry {
     {
         CH_PROFILE_FUNCTION();
 
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
+        if (m_HasBackends)
+        {
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+        }
+        else
+        {
+            ImGuiIO& io = ImGui::GetIO();
+            int64_t time = Clock::Now();
+            io.DeltaTime = m_time > 0 && time > m_time ? (float)Clock::ToSeconds(time - m_time) : 1.0f / 60.0f;
+            m_time = time;
+            Application& app = Application::Get();
+            io.DisplaySize = ImVec2((float)app.GetWindow().GetWidth(), (float)app.GetWindow().GetHeight());
+        }
         ImGui::NewFrame();
     }
 
@@ -78,6 +110,7 @@ namespace Cherry {
     void ImGuiLayer::End()
     {
         CH_PROFILE_FUNCTION();
+        CH_PROFILE_GPU_SCOPE("ImGuiLayer::End");
 
         ImGuiIO& io = ImGui::GetIO();
         Application& app = Application::Get();
@@ -85,6 +118,8 @@ namespace Cherry {
 
         // Rendering
         ImGui::Render();
+        if (!m_HasBackends)
+            return;
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         // Update and Render additional Platform Windows
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
@@ -18,6 +18,8 @@ namespace Cherry {
 		void Begin();
 		void End();
 	private:
-		float m_time = 0.0f;
+		int64_t m_time = 0;
+		// False with the Null renderer: frames are built but never drawn
+		bool m_HasBackends = true;
 	};
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Renderer.h"
 
 #include "Platform/OpenGL/OpenGLBuffer.h"
+#include "Platform/Null/NullBuffer.h"
 
 
 namespace Cherry {
@@ -13,6 +14,7 @@ namespace Cherry {
 		{
 		case RendererAPI::API::None:	CH_CLIENT_ASSERT(false, "RendererAPI::None is not Supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:	return std::make_shared<OpenGLVertexBuffer>(vertices, size);
+		case RendererAPI::API::Null:	return std::make_shared<NullVertexBuffer>(vertices, size);
 		}
 
 		CH_CLIENT_ASSERT(false, "UnKnown RendererAPI !");
@@ -25,6 +27,7 @@ namespace Cherry {
 		{
 		case RendererAPI::API::None:	CH_CLIENT_ASSERT(false, "RendererAPI::None is not Supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:	return std::make_shared<OpenGLIndexBuffer>(indices, count);
+		case RendererAPI::API::Null:	return std::make_shared<NullIndexBuffer>(indices, count);
 		}
 
 		return nullptr;
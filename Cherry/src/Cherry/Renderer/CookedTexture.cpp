@@ -0,0 +1,178 @@
+#include "CHpch.h"
+#include "Cherry/Renderer/CookedTexture.h"
+
+#include "Cherry/Core/Pak.h"
+
+#include <bit>
+
+namespace Cherry {
+
+	CookedTexture::CookedTexture(const std::string& cookedPath)
+	{
+		CH_PROFILE_FUNCTION();
+
+		m_File = VFS::Read(cookedPath);
+		if (!m_File)
+			return;
+
+		const uint8_t* data = m_File.GetBytes();
+		size_t size = m_File.GetSize();
+
+		if (size < sizeof(CookedTextureHeader))
+		{
+			CH_CORE_ERROR("'{0}' is too small to be a cooked texture", cookedPath);
+			return;
+		}
+
+		auto header = (const CookedTextureHeader*)data;
+		if (header->Magic != CookedTextureHeader::s_Magic || header->Version != CookedTextureHeader::s_Version)
+		{
+			CH_CORE_ERROR("'{0}' is not a version {1} cooked texture", cookedPath, CookedTextureHeader::s_Version);
+			return;
+		}
+
+		if (header->Format == CookedTextureFormat::None || header->Format > CookedTextureFormat::BC7)
+		{
+			CH_CORE_ERROR("'{0}' has unknown texture format {1}", cookedPath, (uint16_t)header->Format);
+			return;
+		}
+
+		// A full chain halves down to 1x1 in floor(log2(largest side)) + 1 levels
+		uint32_t maxMipCount = (uint32_t)std::bit_width(std::max(header->Width, header->Height));
+		if (header->MipCount == 0 || header->MipCount > maxMipCount
+			|| sizeof(CookedTextureHeader) + (uint64_t)header->MipCount * sizeof(CookedTextureMip) > size)
+		{
+			CH_CORE_ERROR("'{0}' has a corrupt mip table", cookedPath);
+			return;
+		}
+
+		auto mips = (const CookedTextureMip*)(data + sizeof(CookedTextureHeader));
+		uint32_t width = header->Width, height = header->Height;
+		for (uint32_t level = 0; level < header->MipCount; level++)
+		{
+			const CookedTextureMip& mip = mips[level];
+			if (mip.Width != width || mip.Height != height)
+			{
+				CH_CORE_ERROR("'{0}' mip {1} is {2}x{3}, expected {4}x{5}", cookedPath, level, mip.Width, mip.Height, width, height);
+				return;
+			}
+
+			uint64_t mipSize = GetMipSize(header->Format, mip.Width, mip.Height);
+			if (mipSize == 0 || mip.Size != mipSize || mip.Offset > size || mip.Size > size - mip.Offset)
+			{
+				CH_CORE_ERROR("'{0}' mip {1} is out of bounds", cookedPath, level);
+				return;
+			}
+
+			width = std::max(1u, width / 2);
+			height = std::max(1u, height / 2);
+		}
+
+		m_Header = header;
+		m_Mips = mips;
+	}
+
+	std::string CookedTexture::GetCookedPath(const std::string& sourcePath)
+	{
+		return std::filesystem::path(sourcePath).replace_extension(".chtex").string();
+	}
+
+	bool CookedTexture::HasUpToDateCooked(const std::string& sourcePath)
+	{
+		std::string cooked = GetCookedPath(sourcePath);
+		if (!VFS::Exists(cooked))
+			return false;
+
+		// A loose source edited since the .chtex was cooked wins; the stale .chtex is ignored until the next
+		// cook. Loose .chtex files are compared by timestamp, packed ones by the source stamp the pak recorded.
+		std::string looseSource = VFS::GetLoosePath(sourcePath);
+		if (looseSource.empty())
+			return true;
+
+		bool stale;
+		std::string looseCooked = VFS::GetLoosePath(cooked);
+		if (!looseCooked.empty())
+		{
+			std::error_code error;
+			stale = std::filesystem::last_write_time(looseSource, error) > std::filesystem::last_write_time(looseCooked, error);
+		}
+		else
+			stale = VFS::GetPackedSource(cooked) != PakSourceStamp::FromFile(looseSource);
+
+		if (stale)
+		{
+			CH_CORE_WARN("'{0}' is older than its source, loading '{1}' instead", cooked, sourcePath);
+			return false;
+		}
+		return true;
+	}
+
+	bool CookedTexture::IsCompressed(CookedTextureFormat format)
+	{
+		switch (format)
+		{
+			case CookedTextureFormat::RGBA8:
+			case CookedTextureFormat::RGB8:
+				return false;
+			case CookedTextureFormat::BC1:
+			case CookedTextureFormat::BC3:
+			case CookedTextureFormat::BC7:
+				return true;
+			case CookedTextureFormat::None:
+				break;
+		}
+
+		CH_CORE_ASSERT(false, "Unknown CookedTextureFormat!");
+		return false;
+	}
+
+	uint32_t CookedTexture::GetBytesPerPixel(CookedTextureFormat format)
+	{
+		switch (format)
+		{
+			case CookedTextureFormat::RGBA8: return 4;
+			case CookedTextureFormat::RGB8:  return 3;
+			case CookedTextureFormat::BC1:
+			case CookedTextureFormat::BC3:
+			case CookedTextureFormat::BC7:
+				CH_CORE_ASSERT(false, "Block compressed formats have no per-pixel size!");
+				return 0;
+			case CookedTextureFormat::None:
+				break;
+		}
+
+		CH_CORE_ASSERT(false, "Unknown CookedTextureFormat!");
+		return 0;
+	}
+
+	uint32_t CookedTexture::GetBlockBytes(CookedTextureFormat format)
+	{
+		switch (format)
+		{
+			case CookedTextureFormat::BC1: return 8;
+			case CookedTextureFormat::BC3: return 16;
+			case CookedTextureFormat::BC7: return 16;
+			case CookedTextureFormat::RGBA8:
+			case CookedTextureFormat::RGB8:
+				CH_CORE_ASSERT(false, "Uncompressed formats have no block size!");
+				return 0;
+			case CookedTextureFormat::None:
+				break;
+		}
+
+		CH_CORE_ASSERT(false, "Unknown CookedTextureFormat!");
+		return 0;
+	}
+
+	uint64_t CookedTexture::GetMipSize(CookedTextureFormat format, uint32_t width, uint32_t height)
+	{
+		if (IsCompressed(format))
+		{
+			// 4x4 blocks, partial blocks at the edges are padded
+			uint64_t blocksX = std::max(1u, (width + 3) / 4);
+			uint64_t blocksY = std::max(1u, (height + 3) / 4);
+			return blocksX * blocksY * GetBlockBytes(format);
+		}
+		return (uint64_t)width * height * GetBytesPerPixel(format);
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Core/VFS.h"
+
+#include <string>
+
+namespace Cherry {
+
+	// .chtex layout (little-endian):
+	//   CookedTextureHeader
+	//   CookedTextureMip[MipCount]	   largest level first
+	//   texel data					   each level at a 16 byte aligned offset from the start of the file
+	// Texels are stored bottom row first (already flipped for OpenGL) in their final GPU layout.
+
+	enum class CookedTextureFormat : uint16_t
+	{
+		None = 0,
+		RGBA8, RGB8,
+		BC1, BC3, BC7
+	};
+
+	enum CookedTextureFlags : uint32_t
+	{
+		CookedTextureFlag_FlippedVertically = BIT(0)
+	};
+
+	struct CookedTextureHeader
+	{
+		static constexpr uint32_t s_Magic = 0x58544843;		// "CHTX"
+		static constexpr uint16_t s_Version = 1;
+
+		uint32_t Magic = s_Magic;
+		uint16_t Version = s_Version;
+		CookedTextureFormat Format = CookedTextureFormat::None;
+		uint32_t Width = 0, Height = 0;
+		uint32_t MipCount = 0;
+		uint32_t Flags = 0;
+	};
+
+	struct CookedTextureMip
+	{
+		uint32_t Width = 0, Height = 0;
+		uint64_t Offset = 0;
+		uint64_t Size = 0;
+	};
+
+	static_assert(sizeof(CookedTextureHeader) == 24, "CookedTextureHeader layout changed");
+	static_assert(sizeof(CookedTextureMip) == 24, "CookedTextureMip layout changed");
+
+	// Validated view of a .chtex file, read zero-copy through the VFS
+	class CookedTexture
+	{
+	public:
+		explicit CookedTexture(const std::string& cookedPath);
+
+		inline bool IsValid() const { return m_Header != nullptr; }
+
+		inline const CookedTextureHeader& GetHeader() const { return *m_Header; }
+		inline const CookedTextureMip& GetMip(uint32_t level) const { return m_Mips[level]; }
+		inline const uint8_t* GetMipData(uint32_t level) const { return m_File.GetBytes() + m_Mips[level].Offset; }
+
+		// "textures/Foo.png" -> "textures/Foo.chtex"
+		static std::string GetCookedPath(const std::string& sourcePath);
+
+		// A cooked sibling exists and is not older than its source
+		static bool HasUpToDateCooked(const std::string& sourcePath);
+
+		static bool IsCompressed(CookedTextureFormat format);
+		static uint32_t GetBytesPerPixel(CookedTextureFormat format);
+		static uint32_t GetBlockBytes(CookedTextureFormat format);
+		static uint64_t GetMipSize(CookedTextureFormat format, uint32_t width, uint32_t height);
+	private:
+		FileData m_File;
+		const CookedTextureHeader* m_Header = nullptr;
+		const CookedTextureMip* m_Mips = nullptr;
+	};
+}
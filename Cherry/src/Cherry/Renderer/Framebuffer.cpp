@@ -0,0 +1,21 @@
+#include "CHpch.h"
+#include "Framebuffer.h"
+
+#include "Cherry/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLFramebuffer.h"
+#include "Platform/Null/NullFramebuffer.h"
+
+namespace Cherry {
+	REF(Framebuffer) Framebuffer::Create(const FramebufferSpecification& spec)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    CH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return SmartPointer::CreateRef<OpenGLFramebuffer>(spec);
+			case RendererAPI::API::Null:    return SmartPointer::CreateRef<NullFramebuffer>(spec);
+		}
+
+		CH_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+
+#include <functional>
+
+namespace Cherry {
+
+	enum class FramebufferTextureFormat
+	{
+		None = 0,
+
+		// Color
+		RGBA8,
+		RGBA16F,
+		RED_INTEGER,	// 32-bit signed, e.g. entity IDs for mouse picking
+
+		// Depth/stencil
+		DEPTH24STENCIL8,
+
+		Depth = DEPTH24STENCIL8
+	};
+
+	struct FramebufferSpecification
+	{
+		uint32_t Width = 0, Height = 0;
+		// Color attachments in draw buffer order, plus at most one depth format
+		std::vector<FramebufferTextureFormat> Attachments;
+		// Above 1 renders into multisampled storage that Resolve() blits into the sampleable textures
+		uint32_t Samples = 1;
+	};
+
+	// Receives the pixels of a completed readback, tightly packed rows bottom-up; the pointer is only valid during the call
+	using FramebufferReadbackCallback = std::function<void(const void* data, uint32_t width, uint32_t height)>;
+
+	// Offscreen render target: draws between Bind and Unbind land in its attachments instead of the window
+	class Framebuffer
+	{
+	public:
+		virtual ~Framebuffer() = default;
+
+		// Binds for drawing and sets the viewport to the framebuffer size
+		virtual void Bind() = 0;
+		// Restores the window as render target, resolving multisampled attachments
+		virtual void Unbind() = 0;
+
+		// Recreates every attachment; contents are lost
+		virtual void Resize(uint32_t width, uint32_t height) = 0;
+
+		// Copies multisampled attachments into their sampleable textures, nothing to do when Samples is 1
+		virtual void Resolve() = 0;
+
+		virtual void ClearAttachment(uint32_t attachmentIndex, int value) = 0;
+
+		// Synchronous single pixel read from a RED_INTEGER attachment, stalls until the GPU catches up
+		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
+
+		// Queues a copy of a color attachment region into a staging buffer; the callback runs from a later
+		// ProcessReadbacks() once the GPU is done with it. False if every staging buffer is still in flight
+		virtual bool ReadPixelsAsync(uint32_t attachmentIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+			const FramebufferReadbackCallback& callback) = 0;
+		// Once per frame: delivers finished readbacks without ever waiting on the GPU
+		virtual void ProcessReadbacks() = 0;
+		virtual uint32_t GetPendingReadbackCount() const = 0;
+
+		// Sampleable texture of a color attachment (the resolved one when multisampled)
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const = 0;
+
+		virtual const FramebufferSpecification& GetSpecification() const = 0;
+
+		static REF(Framebuffer) Create(const FramebufferSpecification& spec);
+	};
+}
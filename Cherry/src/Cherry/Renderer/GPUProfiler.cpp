@@ -0,0 +1,34 @@
+#include "CHpch.h"
+#include "Cherry/Renderer/GPUProfiler.h"
+
+#include "Cherry/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLGPUProfiler.h"
+#include "Platform/Null/NullGPUProfiler.h"
+
+namespace Cherry {
+
+	GPUProfiler* GPUProfiler::s_Instance = nullptr;
+
+	void GPUProfiler::Init()
+	{
+		CH_PROFILE_FUNCTION();
+
+		CH_CORE_ASSERT(!s_Instance, "GPUProfiler already initialized!");
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    CH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return;
+		case RendererAPI::API::OpenGL:  s_Instance = new OpenGLGPUProfiler(); return;
+		case RendererAPI::API::Null:    s_Instance = new NullGPUProfiler(); return;
+		}
+
+		CH_CORE_ASSERT(false, "Unknown RendererAPI!");
+	}
+
+	void GPUProfiler::Shutdown()
+	{
+		CH_PROFILE_FUNCTION();
+
+		delete s_Instance;
+		s_Instance = nullptr;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Debug/Instrumentor.h"
+
+namespace Cherry {
+
+	// GPU time of render scopes. Timestamps are queried around each scope and read back a few frames
+	// later, so the CPU never waits on the GPU. Results are written to the Instrumentor session on a
+	// separate "GPU" track, shifted onto the CPU clock. Dispatches to the active RendererAPI's profiler.
+	// Render thread only.
+	class GPUProfiler
+	{
+	public:
+		virtual ~GPUProfiler() = default;
+
+		static void Init();
+		static void Shutdown();
+
+		// The name is kept by pointer until the results are read back, so it must be a literal
+		inline static uint32_t BeginScope(const char* name) { return s_Instance->BeginScopeImpl(name); }
+		inline static void EndScope(uint32_t scope) { s_Instance->EndScopeImpl(scope); }
+
+		// Once per frame: closes the previous frame and emits every frame the GPU has finished
+		inline static void BeginFrame() { s_Instance->BeginFrameImpl(); }
+
+	protected:
+		virtual uint32_t BeginScopeImpl(const char* name) = 0;
+		virtual void EndScopeImpl(uint32_t scope) = 0;
+		virtual void BeginFrameImpl() = 0;
+
+	private:
+		static GPUProfiler* s_Instance;
+	};
+
+	class GPUProfileScope
+	{
+	public:
+		GPUProfileScope(const char* name)
+			: m_Scope(GPUProfiler::BeginScope(name))
+		{
+		}
+
+		~GPUProfileScope()
+		{
+			GPUProfiler::EndScope(m_Scope);
+		}
+
+	private:
+		uint32_t m_Scope;
+	};
+}
+
+#if CH_PROFILE
+	#define CH_PROFILE_GPU_SCOPE(name)  ::Cherry::GPUProfileScope gpuTimer##__LINE__(name)
+#else
+	#define CH_PROFILE_GPU_SCOPE(name)
+#endif
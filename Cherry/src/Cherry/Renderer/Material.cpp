@@ -0,0 +1,107 @@
+#include "CHpch.h"
+#include "Cherry/Renderer/Material.h"
+
+#include "Cherry/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLMaterial.h"
+#include "Platform/Null/NullMaterial.h"
+
+#include <atomic>
+
+namespace Cherry {
+
+	// 0 is reserved for "no material bound"
+	static std::atomic<uint32_t> s_NextMaterialID = 1;
+
+	REF(Material) Material::Create(const REF(Shader)& shader)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    CH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::OpenGL:  return SmartPointer::CreateRef<OpenGLMaterial>(shader);
+		case RendererAPI::API::Null:    return SmartPointer::CreateRef<NullMaterial>(shader);
+		}
+
+		CH_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Material::Material(const REF(Shader)& shader)
+		: m_Shader(shader), m_ID(s_NextMaterialID++), m_Handle(ResourcePool<Material>::Allocate(this))
+	{
+		CH_CORE_ASSERT(shader, "Material needs a shader!");
+
+		const auto& layout = m_Shader->GetMaterialLayout();
+		m_Data.resize(layout.GetSize(), 0);
+	}
+
+	void Material::SetInt(const std::string& name, int value)
+	{
+		SetValue(name, ShaderDataType::Int, &value, sizeof(int));
+	}
+
+	void Material::SetFloat(const std::string& name, float value)
+	{
+		SetValue(name, ShaderDataType::Float, &value, sizeof(float));
+	}
+
+	void Material::SetFloat2(const std::string& name, const glm::vec2& value)
+	{
+		SetValue(name, ShaderDataType::Float2, &value, sizeof(glm::vec2));
+	}
+
+	void Material::SetFloat3(const std::string& name, const glm::vec3& value)
+	{
+		SetValue(name, ShaderDataType::Float3, &value, sizeof(glm::vec3));
+	}
+
+	void Material::SetFloat4(const std::string& name, const glm::vec4& value)
+	{
+		SetValue(name, ShaderDataType::Float4, &value, sizeof(glm::vec4));
+	}
+
+	void Material::SetMat4(const std::string& name, const glm::mat4& value)
+	{
+		SetValue(name, ShaderDataType::Mat4, &value, sizeof(glm::mat4));
+	}
+
+	void Material::SetTexture(uint32_t slot, const REF(Texture2D)& texture)
+	{
+		for (auto& [boundSlot, boundTexture] : m_Textures)
+		{
+			if (boundSlot == slot)
+			{
+				boundTexture = texture;
+				return;
+			}
+		}
+		m_Textures.emplace_back(slot, texture);
+	}
+
+	void Material::SetValue(const std::string& name, ShaderDataType type, const void* data, uint32_t size)
+	{
+		const auto& uniforms = m_Shader->GetMaterialLayout().GetUniforms();
+		for (uint32_t i = 0; i < (uint32_t)uniforms.size(); i++)
+		{
+			const ShaderUniform& uniform = uniforms[i];
+			if (uniform.Name != name)
+				continue;
+
+			if (uniform.Type != type)
+			{
+				CH_CORE_WARN("Material: '{0}' type mismatch on shader '{1}'", name, m_Shader->GetName());
+				return;
+			}
+
+			uint8_t* dst = m_Data.data() + uniform.Offset;
+			if (memcmp(dst, data, size) == 0)
+				return;
+
+			memcpy(dst, data, size);
+			m_Dirty = true;
+			return;
+		}
+
+		CH_CORE_WARN("Material: shader '{0}' has no parameter '{1}'", m_Shader->GetName(), name);
+	}
+
+}
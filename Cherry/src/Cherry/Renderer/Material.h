@@ -0,0 +1,59 @@
+#pragma once
+#include "Cherry/Renderer/Shader.h"
+#include "Cherry/Renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+namespace Cherry {
+
+	// A Material references a Shader and keeps its parameter values in one compact byte block laid out
+	// by the shader's reflected material layout. Parameters never set read as zero. Values are only
+	// uploaded when the block is dirty.
+	class Material
+	{
+	public:
+		virtual ~Material() { ResourcePool<Material>::Release(m_Handle); }
+
+		Material(const Material&) = delete;
+		Material(Material&&) = delete;
+		Material& operator=(const Material&) = delete;
+		Material& operator=(Material&&) = delete;
+
+		void SetInt(const std::string& name, int value);
+		void SetFloat(const std::string& name, float value);
+		void SetFloat2(const std::string& name, const glm::vec2& value);
+		void SetFloat3(const std::string& name, const glm::vec3& value);
+		void SetFloat4(const std::string& name, const glm::vec4& value);
+		void SetMat4(const std::string& name, const glm::mat4& value);
+
+		void SetTexture(uint32_t slot, const REF(Texture2D)& texture);
+
+		// Uploads the parameter block if needed and binds it, together with the material textures
+		virtual void Bind() = 0;
+
+		inline const REF(Shader)& GetShader() const { return m_Shader; }
+		inline uint32_t GetID() const { return m_ID; }
+		// Queued draws hold this instead of a reference (see Renderer::Submit)
+		inline ResourceHandle<Material> GetHandle() const { return m_Handle; }
+		inline bool IsDirty() const { return m_Dirty; }
+
+		inline const std::vector<uint8_t>& GetData() const { return m_Data; }
+
+		static REF(Material) Create(const REF(Shader)& shader);
+
+	protected:
+		Material(const REF(Shader)& shader);
+
+		void SetValue(const std::string& name, ShaderDataType type, const void* data, uint32_t size);
+
+	protected:
+		REF(Shader) m_Shader;
+		uint32_t m_ID;
+		ResourceHandle<Material> m_Handle;
+
+		std::vector<uint8_t> m_Data;
+		std::vector<std::pair<uint32_t, REF(Texture2D)>> m_Textures;
+		bool m_Dirty = true;
+	};
+
+}
@@ -1,8 +1,7 @@
 #include "CHpch.h"
 #include "Cherry/Renderer/RenderCommand.h"
-#include "Platform/OpenGL/OpenGLRendererAPI.h"
 
 namespace Cherry {
 
-	RendererAPI* RenderCommand::s_RendererAPI = new OpenGLRendererAPI;
-}
\ No newline at end of file
+	SCOPE(RendererAPI) RenderCommand::s_RendererAPI;
+}
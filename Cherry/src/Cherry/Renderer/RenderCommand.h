@@ -9,11 +9,18 @@ namespace Cherry {
 	public:
 		//Dispatch to s_RendererAPI
 
+		// Creates the backend for the API selected with RendererAPI::SetAPI
 		inline static void Init()
 		{
+			s_RendererAPI = RendererAPI::Create();
 			s_RendererAPI->Init();
 		}
 
+		inline static void Shutdown()
+		{
+			s_RendererAPI.reset();
+		}
+
 		inline static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 		{
 			s_RendererAPI->SetViewport(x, y, width, height);
@@ -24,13 +31,18 @@ namespace Cherry {
 		inline static  void Clear() { s_RendererAPI->Clear(); }
 
 		inline static void DrawIndexed(const REF(VertexArray)& vertexArray)
+		{
+			s_RendererAPI->DrawIndexed(*vertexArray);
+		}
+
+		inline static void DrawIndexed(const VertexArray& vertexArray)
 		{
 			s_RendererAPI->DrawIndexed(vertexArray);
 		}
 		
 	
 	private:
-		static RendererAPI* s_RendererAPI;
+		static SCOPE(RendererAPI) s_RendererAPI;
 
 	};
 }
\ No newline at end of file
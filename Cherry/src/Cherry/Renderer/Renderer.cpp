@@ -1,19 +1,28 @@
 #include "CHpch.h"
 #include "Renderer.h"
 #include "Cherry/Renderer/Renderer2D.h"
+#include "Cherry/Renderer/GPUProfiler.h"
 #include "Cherry/Renderer/Shader.h"
-#include <Platform/OpenGL/OpenGLShader.h>
+#include "Cherry/Renderer/TextureLibrary.h"
+#include "Cherry/Renderer/TextureLoader.h"
+#include "Cherry/Renderer/TextureStreamer.h"
+#include "Cherry/Core/FrameAllocator.h"
 
 
 namespace Cherry {
 
 	Renderer::SceneData* Renderer::m_SceneData = new Renderer::SceneData;  // Initialize to nullptr
+	uint64_t Renderer::s_FrameIndex = 0;
 
 	void Renderer::Init()
 	{
 		CH_PROFILE_FUNCTION();
 
 		RenderCommand::Init();
+		GPUProfiler::Init();
+		TextureLoader::Init();
+		TextureStreamer::Init();
+		TextureLibrary::Init();
 		Renderer2D::Init();
 	}
 
@@ -22,13 +31,30 @@ namespace Cherry {
 		CH_PROFILE_FUNCTION();
 
 		Renderer2D::Shutdown();
+		TextureLibrary::Shutdown();
+		TextureStreamer::Shutdown();
+		TextureLoader::Shutdown();
+		GPUProfiler::Shutdown();
+		RenderCommand::Shutdown();
 		delete m_SceneData;
 		m_SceneData = nullptr;
 	}
 
+	void Renderer::BeginFrame()
+	{
+		CH_PROFILE_FUNCTION();
+
+		s_FrameIndex++;
+		GPUProfiler::BeginFrame();
+		TextureLoader::ProcessUploads();
+		TextureStreamer::Update();
+		TextureLibrary::Update(s_FrameIndex);
+	}
+
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
 	{
 		RenderCommand::SetViewport(0, 0, width, height);
+		TextureStreamer::SetViewportSize(width, height);
 
 	}
 
@@ -38,21 +64,96 @@ namespace Cherry {
 	}
 	void Renderer::EndScene()
 	{
+		CH_PROFILE_FUNCTION();
 
+		Flush();
 	}
 
 	void Renderer::Submit(const REF(Shader)& shader, const REF(VertexArray)& vertexArray,const glm::mat4& transform)
 	{
 		shader->Bind();
-		std::dynamic_pointer_cast<OpenGLShader>(shader)->UploadUniformMat4("u_ViewProjection", m_SceneData->ViewProjectionMatrix);
-		std::dynamic_pointer_cast<OpenGLShader>(shader)->UploadUniformMat4("u_Transform", transform);
+		shader->SetMat4("u_ViewProjection", m_SceneData->ViewProjectionMatrix);
+		shader->SetMat4("u_Transform", transform);
 		//mi->Bind();
 
 		vertexArray->Bind();
 		RenderCommand::DrawIndexed(vertexArray);
 	}
 
-	void Renderer::Flush() {
+	void Renderer::Submit(const REF(Material)& material, const REF(VertexArray)& vertexArray, const glm::mat4& transform)
+	{
+		m_SceneData->MaterialQueue.push_back({ material->GetHandle(), material->GetShader()->GetHandle(), vertexArray->GetHandle(), transform });
+	}
+
+	void Renderer::Flush()
+	{
+		CH_PROFILE_FUNCTION();
+
+		auto& queue = m_SceneData->MaterialQueue;
+		if (queue.empty())
+			return;
+
+		CH_PROFILE_GPU_SCOPE("Renderer::Flush");
+
+		// Group by shader first, then by material; the submission index keeps equal keys in order without
+		// the temporary buffer std::stable_sort allocates
+		struct SortKey
+		{
+			uint32_t ShaderHandle;
+			uint32_t MaterialHandle;
+			uint32_t Index;
+		};
+		FrameVector<SortKey> keys;
+		keys.reserve(queue.size());
+		for (uint32_t i = 0; i < (uint32_t)queue.size(); i++)
+			keys.push_back({ queue[i].DrawShader.Value, queue[i].DrawMaterial.Value, i });
+		std::sort(keys.begin(), keys.end(), [](const SortKey& a, const SortKey& b)
+			{
+				if (a.ShaderHandle != b.ShaderHandle)
+					return a.ShaderHandle < b.ShaderHandle;
+				if (a.MaterialHandle != b.MaterialHandle)
+					return a.MaterialHandle < b.MaterialHandle;
+				return a.Index < b.Index;
+			});
+
+		uint32_t boundShader = 0;
+		uint32_t boundMaterial = 0;
+		Shader* shader = nullptr;
+		Material* material = nullptr;
+		for (const SortKey& key : keys)
+		{
+			const MaterialDrawCommand& command = queue[key.Index];
+			if (key.ShaderHandle != boundShader)
+			{
+				shader = ResourcePool<Shader>::Get(command.DrawShader);
+				if (shader)
+				{
+					shader->Bind();
+					shader->SetMat4("u_ViewProjection", m_SceneData->ViewProjectionMatrix);
+				}
+				boundShader = key.ShaderHandle;
+				boundMaterial = 0;
+			}
+
+			if (key.MaterialHandle != boundMaterial)
+			{
+				material = ResourcePool<Material>::Get(command.DrawMaterial);
+				if (material)
+					material->Bind();
+				boundMaterial = key.MaterialHandle;
+			}
+
+			// Destroyed since it was submitted
+			VertexArray* vertexArray = ResourcePool<VertexArray>::Get(command.DrawVertexArray);
+			if (!shader || !material || !vertexArray)
+				continue;
+
+			shader->SetMat4("u_Transform", command.Transform);
+			vertexArray->Bind();
+			RenderCommand::DrawIndexed(*vertexArray);
+		}
+
+		queue.clear();
 	}
 
 
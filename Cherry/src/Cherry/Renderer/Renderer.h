@@ -3,6 +3,7 @@
 #include "Cherry/Renderer/RenderCommand.h"
 #include "Cherry/Renderer/Camera.h"
 #include "Cherry/Renderer/Shader.h"
+#include "Cherry/Renderer/Material.h"
 #include <glm/glm.hpp>
 
 
@@ -13,24 +14,44 @@ namespace Cherry {
 	public:
 		static void Init();
 		static void Shutdown();
+
+		// Once per frame before any layer renders: streams pending texture uploads and mip residency
+		static void BeginFrame();
+
 		static void OnWindowResize(uint32_t width, uint32_t height);
 		static void BeginScene(OrthographicCamera& camera);		//TODO:: All Scene Params
 		static void EndScene();
 
 		static void Submit(const REF(Shader)& shader, const REF(VertexArray)& vertexArray, const glm::mat4& transform = glm::mat4 (1.0f));
 
+		// Queued until EndScene, then drawn sorted by shader and material so state changes happen once per group.
+		// The queue holds handles, not references: the caller keeps both alive until then, or the draw is dropped.
+		static void Submit(const REF(Material)& material, const REF(VertexArray)& vertexArray, const glm::mat4& transform = glm::mat4(1.0f));
+
 		static void Flush();
 
 		inline static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
+		// Advanced by BeginFrame
+		inline static uint64_t GetFrameIndex() { return s_FrameIndex; }
 
 	private:
+		struct MaterialDrawCommand
+		{
+			ResourceHandle<Material> DrawMaterial;
+			ResourceHandle<Shader> DrawShader;
+			ResourceHandle<VertexArray> DrawVertexArray;
+			glm::mat4 Transform;
+		};
+
 		struct SceneData {
 		public:
 			glm::mat4 ViewProjectionMatrix;
+			std::vector<MaterialDrawCommand> MaterialQueue;
 		};
 
 
 		static SceneData* m_SceneData;
+		static uint64_t s_FrameIndex;
 	};
 
 }
\ No newline at end of file
@@ -5,21 +5,52 @@
 #include "Cherry/Renderer/Shader.h"
 #include "Cherry/Renderer/Camera.h"
 #include "Cherry/Renderer/RenderCommand.h"
+#include "Cherry/Renderer/TextureStreamer.h"
+#include "Cherry/Renderer/GPUProfiler.h"
 
 #include "Cherry/Core/Core.h"
 #include <glm/ext/matrix_transform.hpp>
 
 namespace Cherry {
 	
+	struct QuadCommand
+	{
+		glm::mat4 Transform;
+		glm::vec4 Color;
+		float TilingFactor;
+		ResourceHandle<Texture2D> Texture;
+	};
+
 	struct Renderer2DStorage
 	{
 		REF(VertexArray) QuadVertexArray;
 		REF(Shader) TextureShader;
 		REF(Texture2D) WhiteTexture;
+		glm::mat4 ViewProjection;
+
+		// Quads of the current scene, drawn on Flush
+		std::vector<QuadCommand> QuadQueue;
 	};
 
 	static Renderer2DStorage* s_Data;
 
+	static void SubmitQuad(const glm::mat4& transform, const glm::vec4& color, float tilingFactor, const Texture2D& texture)
+	{
+		// Texel density feeds mip streaming: the unit quad's edges projected to pixels, per texture repeat
+		if (texture.IsStreamable())
+		{
+			glm::mat4 clip = s_Data->ViewProjection * transform;
+			glm::vec2 halfViewport = TextureStreamer::GetViewportSize() * 0.5f;
+			glm::vec2 screenSize = {
+				glm::length(glm::vec2(clip[0][0], clip[0][1]) * halfViewport),
+				glm::length(glm::vec2(clip[1][0], clip[1][1]) * halfViewport)
+			};
+			TextureStreamer::ReportUsage(&texture, screenSize / tilingFactor);
+		}
+
+		s_Data->QuadQueue.push_back({ transform, color, tilingFactor, texture.GetHandle() });
+	}
+
 	void Renderer2D::Init()
 	{
 		CH_PROFILE_FUNCTION();
@@ -72,30 +103,62 @@ namespace Cherry {
 	{
 		CH_PROFILE_FUNCTION();
 
+	   s_Data->ViewProjection = camera.GetViewProjectionMatrix();
 	   s_Data->TextureShader->SetMat4("u_ViewProjection",camera.GetViewProjectionMatrix());
 	   s_Data->TextureShader->Bind();
 
+	   s_Data->QuadQueue.clear();
 	}
 	void Renderer2D::EndScene()
 	{
 		CH_PROFILE_FUNCTION();
 
-		//Flush();
+		Flush();
+	}
+
+	void Renderer2D::Flush()
+	{
+		CH_PROFILE_FUNCTION();
+
+		auto& queue = s_Data->QuadQueue;
+		if (queue.empty())
+			return;
+
+		CH_PROFILE_GPU_SCOPE("Renderer2D::Flush");
+
+		// Submission order is kept: quads share z and rely on depth test + blending order,
+		// so only consecutive runs of the same texture are grouped under one bind
+		s_Data->TextureShader->Bind();
+		s_Data->QuadVertexArray->Bind();
+
+		ResourceHandle<Texture2D> boundTexture;
+		for (const auto& quad : queue)
+		{
+			if (quad.Texture != boundTexture)
+			{
+				// Destroyed since it was submitted: draw it untextured rather than skip it
+				Texture2D* texture = ResourcePool<Texture2D>::Get(quad.Texture);
+				(texture ? texture : s_Data->WhiteTexture.get())->Bind();
+				boundTexture = quad.Texture;
+			}
+
+			s_Data->TextureShader->SetFloat4("u_Color", quad.Color);
+			s_Data->TextureShader->SetFloat("u_TilingFactor", quad.TilingFactor);
+			s_Data->TextureShader->SetMat4("u_Transform", quad.Transform);
+			RenderCommand::DrawIndexed(s_Data->QuadVertexArray);
+		}
+
+		queue.clear();
 	}
 
 	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
 	{
 		CH_PROFILE_FUNCTION();
 
-		s_Data->TextureShader->SetFloat4("u_Color", color);
-		s_Data->TextureShader->SetFloat("u_TilingFactor", 1.0f);
-		s_Data->WhiteTexture->Bind();
 		// Build transform: Translate → Rotate (Z-axis) → Scale
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) 
 			* glm::scale(glm::mat4(1.0f), { size.x,size.y,1.0f });
-		s_Data->TextureShader->SetMat4("u_Transform", transform);
-		s_Data->QuadVertexArray->Bind();
-		RenderCommand::DrawIndexed(s_Data->QuadVertexArray);
+		SubmitQuad(transform, color, 1.0f, *s_Data->WhiteTexture);
 	}
 
 
@@ -109,16 +172,10 @@ namespace Cherry {
 	{
 		CH_PROFILE_FUNCTION();
 
-		//We Can Have Tint here instead of vec4 white color
-		s_Data->TextureShader->SetFloat4("u_Color", tintColor);
-		s_Data->TextureShader->SetFloat("u_TilingFactor", tilingFactor);
-		texture->Bind();
 		// Build transform: Translate → Rotate (Z-axis) → Scale
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) 
 			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-		s_Data->TextureShader->SetMat4("u_Transform", transform);
-		s_Data->QuadVertexArray->Bind();
-		RenderCommand::DrawIndexed(s_Data->QuadVertexArray);
+		SubmitQuad(transform, tintColor, tilingFactor, *texture);
 	}
 
 
@@ -132,16 +189,11 @@ namespace Cherry {
 	{
 		CH_PROFILE_FUNCTION();
 
-		s_Data->TextureShader->SetFloat4("u_Color", color);
-		s_Data->TextureShader->SetFloat("u_TilingFactor", 1.0f);
-		s_Data->WhiteTexture->Bind();
 		// Build transform: Translate → Rotate (Z-axis) → Scale
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::rotate(glm::mat4(1.0f), rotation, glm::vec3(0.0f, 0.0f, 1.0f))
 			* glm::scale(glm::mat4(1.0f), { size.x,size.y,1.0f });
-		s_Data->TextureShader->SetMat4("u_Transform", transform);
-		s_Data->QuadVertexArray->Bind();
-		RenderCommand::DrawIndexed(s_Data->QuadVertexArray);
+		SubmitQuad(transform, color, 1.0f, *s_Data->WhiteTexture);
 	}
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color) 
@@ -153,17 +205,11 @@ namespace Cherry {
 	{
 		CH_PROFILE_FUNCTION();
 
-		//We Can Have Tint here instead of vec4 white color
-		s_Data->TextureShader->SetFloat4("u_Color", tintColor);
-		s_Data->TextureShader->SetFloat("u_TilingFactor", tilingFactor);
-		texture->Bind();
 		// Build transform: Translate → Rotate (Z-axis) → Scale
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
 			* glm::rotate(glm::mat4(1.0f), rotation, glm::vec3(0.0f, 0.0f, 1.0f))
 			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
-		s_Data->TextureShader->SetMat4("u_Transform", transform);
-		s_Data->QuadVertexArray->Bind();
-		RenderCommand::DrawIndexed(s_Data->QuadVertexArray);
+		SubmitQuad(transform, tintColor, tilingFactor, *texture);
 	}
 
 	void Renderer2D::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const REF(Texture2D)& texture, float tilingFactor, const glm::vec4& tintColor)
@@ -11,8 +11,10 @@ namespace Cherry {
 		static void Shutdown();
 		static void BeginScene(const OrthographicCamera& camera);
 		static void EndScene();
+		static void Flush();
 
 		// PRIMITIVES
+		// Quads keep a handle to their texture until EndScene; one destroyed before then draws untextured
 		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
 		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
 
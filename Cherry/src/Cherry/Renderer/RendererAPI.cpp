@@ -1,8 +1,22 @@
 #include "CHpch.h"
 #include "RendererAPI.h"
 
-
+#include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
 
 namespace Cherry {
 	RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
-}
\ No newline at end of file
+
+	SCOPE(RendererAPI) RendererAPI::Create()
+	{
+		switch (s_API)
+		{
+			case RendererAPI::API::None:    CH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CREATE_SCOPE(OpenGLRendererAPI);
+			case RendererAPI::API::Null:    return CREATE_SCOPE(NullRendererAPI);
+		}
+
+		CH_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+}
@@ -10,17 +10,24 @@ namespace Cherry {
 	public:
 		enum class API
 		{
-			None = 0, OpenGL = 1
+			None = 0, OpenGL = 1,
+			Null = 2		// Headless: accepts every call and only records it (see NullCommandLog)
 		};
 
 	public:
+		virtual ~RendererAPI() = default;
+
 		virtual void Init() = 0;
 		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 		virtual void SetClearColor(const glm::vec4& color) = 0;
 		virtual void Clear() = 0;
 
-		virtual void DrawIndexed(const REF(VertexArray)& vertexArray) = 0;
+		virtual void DrawIndexed(const VertexArray& vertexArray) = 0;
 		inline static API GetAPI() { return s_API; }
+		// Must be called before Renderer::Init, every resource is created for the API active at that time
+		inline static void SetAPI(API api) { s_API = api; }
+
+		static SCOPE(RendererAPI) Create();
 	private:
 		static API s_API;
 	};
@@ -0,0 +1,145 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace Cherry {
+
+	// A 32-bit reference to a pooled resource: its slot and the slot's generation when the resource was
+	// created. Destroying the resource moves the generation on, so a stale handle resolves to nothing
+	// rather than to whatever took the slot next. 0 is never a valid handle.
+	template<typename T>
+	struct ResourceHandle
+	{
+		static constexpr uint32_t IndexBits = 20;
+		static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+		static constexpr uint32_t GenerationMask = (1u << (32 - IndexBits)) - 1;
+
+		uint32_t Value = 0;
+
+		inline uint32_t GetIndex() const { return Value & IndexMask; }
+		inline uint32_t GetGeneration() const { return Value >> IndexBits; }
+		inline bool IsValid() const { return Value != 0; }
+
+		bool operator==(const ResourceHandle& other) const = default;
+	};
+
+	// Every live resource of kind T, by handle. Slots sit in fixed pages that never move, so Get takes no
+	// lock; resources may be created and destroyed on any thread. Pages live for the whole run, which keeps
+	// resources destroyed during static destruction safe.
+	template<typename T>
+	class ResourcePool
+	{
+	public:
+		static constexpr uint32_t MaxResources = 1u << ResourceHandle<T>::IndexBits;
+
+		static ResourceHandle<T> Allocate(T* resource)
+		{
+			std::lock_guard<std::mutex> lock(s_Data.Mutex);
+
+			// Free slots are reused oldest first, and only once enough have piled up, so a slot's
+			// generation comes round again as rarely as possible
+			uint32_t index;
+			if (s_Data.FreeHead != s_NoSlot && (s_Data.FreeCount >= s_MinFreeSlots || s_Data.SlotCount == MaxResources))
+			{
+				index = s_Data.FreeHead;
+				s_Data.FreeHead = GetSlot(index).NextFree;
+				if (s_Data.FreeHead == s_NoSlot)
+					s_Data.FreeTail = s_NoSlot;
+				s_Data.FreeCount--;
+			}
+			else
+			{
+				CH_CORE_ASSERT(s_Data.SlotCount < MaxResources, "Resource pool is full!");
+				index = s_Data.SlotCount++;
+				if (index % s_PageSize == 0)
+					s_Data.Pages[index / s_PageSize].store(new Slot[s_PageSize], std::memory_order_release);
+			}
+
+			Slot& slot = GetSlot(index);
+			slot.Resource.store(resource, std::memory_order_release);
+			s_Data.LiveCount++;
+			return { (slot.Generation.load(std::memory_order_relaxed) << ResourceHandle<T>::IndexBits) | index };
+		}
+
+		static void Release(ResourceHandle<T> handle)
+		{
+			if (!handle.IsValid())
+				return;
+
+			std::lock_guard<std::mutex> lock(s_Data.Mutex);
+			uint32_t index = handle.GetIndex();
+			Slot& slot = GetSlot(index);
+			CH_CORE_ASSERT(slot.Generation.load(std::memory_order_relaxed) == handle.GetGeneration(), "Resource released twice!");
+
+			// Generation 0 is skipped so no handle is ever 0
+			uint32_t generation = (handle.GetGeneration() + 1) & ResourceHandle<T>::GenerationMask;
+			slot.Resource.store(nullptr, std::memory_order_relaxed);
+			slot.Generation.store(generation ? generation : 1, std::memory_order_release);
+
+			slot.NextFree = s_NoSlot;
+			if (s_Data.FreeTail != s_NoSlot)
+				GetSlot(s_Data.FreeTail).NextFree = index;
+			else
+				s_Data.FreeHead = index;
+			s_Data.FreeTail = index;
+			s_Data.FreeCount++;
+			s_Data.LiveCount--;
+		}
+
+		// nullptr once the resource is gone
+		static T* Get(ResourceHandle<T> handle)
+		{
+			if (!handle.IsValid())
+				return nullptr;
+			Slot* page = s_Data.Pages[handle.GetIndex() / s_PageSize].load(std::memory_order_acquire);
+			if (!page)
+				return nullptr;
+
+			const Slot& slot = page[handle.GetIndex() % s_PageSize];
+			if (slot.Generation.load(std::memory_order_acquire) != handle.GetGeneration())
+				return nullptr;
+			return slot.Resource.load(std::memory_order_acquire);
+		}
+
+		static uint32_t GetCount()
+		{
+			std::lock_guard<std::mutex> lock(s_Data.Mutex);
+			return s_Data.LiveCount;
+		}
+
+	private:
+		static constexpr uint32_t s_PageSize = 1024;
+		static constexpr uint32_t s_MinFreeSlots = 1024;
+		static constexpr uint32_t s_NoSlot = UINT32_MAX;
+
+		struct Slot
+		{
+			std::atomic<T*> Resource = nullptr;
+			std::atomic<uint32_t> Generation = 1;
+			uint32_t NextFree = s_NoSlot;
+		};
+
+		struct PoolData
+		{
+			std::atomic<Slot*> Pages[MaxResources / s_PageSize] = {};
+
+			std::mutex Mutex;
+			uint32_t SlotCount = 0;
+			uint32_t LiveCount = 0;
+			uint32_t FreeHead = s_NoSlot;
+			uint32_t FreeTail = s_NoSlot;
+			uint32_t FreeCount = 0;
+		};
+
+		static inline Slot& GetSlot(uint32_t index)
+		{
+			return s_Data.Pages[index / s_PageSize].load(std::memory_order_relaxed)[index % s_PageSize];
+		}
+
+		// Constant-initialized, so resources created during static initialization find it ready
+		static constinit inline PoolData s_Data{};
+	};
+}
@@ -3,6 +3,7 @@
 
 #include "Cherry/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/Null/NullShader.h"
 
 namespace Cherry {
 
@@ -12,6 +13,7 @@ namespace Cherry {
 		{
 		case RendererAPI::API::None:    CH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return SmartPointer::CreateRef<OpenGLShader>(filepath);
+		case RendererAPI::API::Null:    return SmartPointer::CreateRef<NullShader>(filepath);
 		}
 
 		CH_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -24,6 +26,7 @@ namespace Cherry {
 		{
 		case RendererAPI::API::None:    CH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return SmartPointer::CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
+		case RendererAPI::API::Null:    return SmartPointer::CreateRef<NullShader>(name, vertexSrc, fragmentSrc);
 		}
 
 		CH_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -1,28 +1,105 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <glm/glm.hpp>
 
+#include "Cherry/Renderer/Buffer.h"
+#include "Cherry/Renderer/ResourcePool.h"
+
 namespace Cherry {
 
+	// A single material parameter as seen by program reflection after link.
+	// Offset/Size describe where the value lives inside the material byte block.
+	struct ShaderUniform
+	{
+		std::string Name;
+		ShaderDataType Type = ShaderDataType::None;
+		uint32_t Size = 0;
+		uint32_t Offset = 0;
+		uint32_t Count = 1;
+		int32_t Location = -1;		// Default-block location, -1 when the uniform lives in a uniform block
+
+		ShaderUniform() {}
+		ShaderUniform(const std::string& name, ShaderDataType type, uint32_t size, uint32_t offset, uint32_t count, int32_t location)
+			:Name(name), Type(type), Size(size), Offset(offset), Count(count), Location(location)
+		{
+		}
+	};
+
+	class ShaderUniformLayout
+	{
+	public:
+		ShaderUniformLayout() {}
+
+		void Add(const ShaderUniform& uniform)
+		{
+			m_Uniforms.push_back(uniform);
+			m_Size = std::max(m_Size, uniform.Offset + uniform.Size);
+		}
+
+		const ShaderUniform* Find(const std::string& name) const
+		{
+			for (const auto& uniform : m_Uniforms)
+				if (uniform.Name == name)
+					return &uniform;
+			return nullptr;
+		}
+
+		inline const std::vector<ShaderUniform>& GetUniforms() const { return m_Uniforms; }
+		inline uint32_t GetSize() const { return m_Size; }
+		inline uint32_t GetCount() const { return (uint32_t)m_Uniforms.size(); }
+
+		// When buffer backed, the block mirrors a std140 "Material" uniform block bound at GetBufferBinding()
+		inline bool IsBufferBacked() const { return m_BufferBacked; }
+		inline uint32_t GetBufferBinding() const { return m_BufferBinding; }
+		void SetBufferBacked(uint32_t binding, uint32_t size) { m_BufferBacked = true; m_BufferBinding = binding; m_Size = std::max(m_Size, size); }
+
+		std::vector<ShaderUniform>::const_iterator begin() const { return m_Uniforms.begin(); }
+		std::vector<ShaderUniform>::const_iterator end() const { return m_Uniforms.end(); }
+
+	private:
+		std::vector<ShaderUniform> m_Uniforms;
+		uint32_t m_Size = 0;
+		uint32_t m_BufferBinding = 0;
+		bool m_BufferBacked = false;
+	};
+
 	class Shader
 	{
 	public:
-		virtual ~Shader() = default;
+		virtual ~Shader() { ResourcePool<Shader>::Release(m_Handle); }
+
+		Shader(const Shader&) = delete;
+		Shader(Shader&&) = delete;
+		Shader& operator=(const Shader&) = delete;
+		Shader& operator=(Shader&&) = delete;
 
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
-		virtual void SetInt(const std::string& name, int value) = 0;
-		virtual void SetFloat(const std::string& name, float value) = 0;
-		virtual void SetFloat3(const std::string& name, const glm::vec3& value) = 0;
-		virtual void SetFloat4(const std::string& name, const glm::vec4& value) = 0;
-		virtual void SetMat4(const std::string& name, const glm::mat4& value) = 0;
+		virtual void SetInt(std::string_view name, int value) = 0;
+		virtual void SetFloat(std::string_view name, float value) = 0;
+		virtual void SetFloat3(std::string_view name, const glm::vec3& value) = 0;
+		virtual void SetFloat4(std::string_view name, const glm::vec4& value) = 0;
+		virtual void SetMat4(std::string_view name, const glm::mat4& value) = 0;
 
 		virtual const std::string& GetName() const = 0;
 
+		// Reflected material parameters, built once after the program links
+		virtual const ShaderUniformLayout& GetMaterialLayout() const = 0;
+
 		static REF(Shader) Create(const std::string& filepath);
 		static REF(Shader) Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+
+		// Identifies the shader in draw sort keys
+		inline ResourceHandle<Shader> GetHandle() const { return m_Handle; }
+
+	protected:
+		Shader() : m_Handle(ResourcePool<Shader>::Allocate(this)) {}
+
+	private:
+		ResourceHandle<Shader> m_Handle;
 	};
 
 	class ShaderLibrary
@@ -40,4 +117,4 @@ namespace Cherry {
 		std::unordered_map<std::string, REF(Shader)> m_Shaders;
 	};
 
-}
\ No newline at end of file
+}
@@ -2,7 +2,10 @@
 #include "Texture.h"
 
 #include "Cherry/Renderer/Renderer.h"
+#include "Cherry/Renderer/TextureLibrary.h"
+#include "Cherry/Renderer/TextureStreamer.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Platform/Null/NullTexture.h"
 
 namespace Cherry {
 	REF(Texture2D) Texture2D::Create(uint32_t width, uint32_t height)
@@ -11,6 +14,7 @@ namespace Cherry {
 		{
 			case RendererAPI::API::None:    CH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return SmartPointer::CreateRef<OpenGLTexture2D>(width,height);
+			case RendererAPI::API::Null:    return SmartPointer::CreateRef<NullTexture2D>(width, height);
 		}
 
 		CH_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -18,15 +22,32 @@ namespace Cherry {
 	}
 
 	REF(Texture2D) Texture2D::Create(const std::string& path)
+	{
+		return TextureLibrary::Load(path);
+	}
+
+	REF(Texture2D) Texture2D::CreateUncached(const std::string& path)
 	{
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:    CH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-			case RendererAPI::API::OpenGL:  return SmartPointer::CreateRef<OpenGLTexture2D>(path);
+			case RendererAPI::API::OpenGL:
+			{
+				REF(Texture2D) texture = SmartPointer::CreateRef<OpenGLTexture2D>(path);
+				if (texture->IsStreamable())
+					TextureStreamer::Register(texture);
+				return texture;
+			}
+			case RendererAPI::API::Null:    return SmartPointer::CreateRef<NullTexture2D>(path);
 		}
 
 		CH_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
 	}
 
+	REF(Texture2D) Texture2D::CreateAsync(const std::string& path)
+	{
+		return TextureLibrary::LoadAsync(path);
+	}
+
 }
\ No newline at end of file
@@ -1,7 +1,17 @@
 #pragma once
-
+#include "Cherry/Renderer/ResourcePool.h"
 
 namespace Cherry {
+
+	// Minification filtering; magnification keeps the texture's own setting
+	enum class TextureFilter
+	{
+		Nearest,
+		Linear,			// No mip sampling
+		Trilinear,		// Blends between the two nearest mips
+		Anisotropic		// Trilinear plus anisotropic taps for surfaces viewed at an angle
+	};
+
 	class Texture
 	{
 	public:
@@ -13,12 +23,54 @@ namespace Cherry {
 		virtual void SetData(void* data, uint32_t size) = 0;
 
 		virtual void Bind(uint32_t slot = 0) const = 0;
+
+		// False while an asynchronously created texture still shows its placeholder
+		virtual bool IsLoaded() const { return true; }
+
+		virtual void SetFilter(TextureFilter filter, float maxAnisotropy = 16.0f) = 0;
+		virtual TextureFilter GetFilter() const = 0;
+
+		virtual uint32_t GetMipCount() const = 0;
+
+		// Bytes currently resident on the GPU, mips included
+		virtual uint64_t GetMemorySize() const = 0;
+
+		// Streamable textures keep a CPU-side copy of every mip and can drop or restore their finest
+		// levels at runtime (see TextureStreamer); others are always fully resident
+		virtual bool IsStreamable() const { return false; }
+		virtual uint32_t GetResidentMip() const { return 0; }
+		virtual void SetResidentMip(uint32_t mip) {}
+		virtual uint64_t GetMemorySize(uint32_t residentMip) const { return GetMemorySize(); }
 	};
 
 	class Texture2D : public Texture
 	{
 	public:
+		virtual ~Texture2D() { ResourcePool<Texture2D>::Release(m_Handle); }
+
+		// Owns its pool slot, which a copy would release twice
+		Texture2D(const Texture2D&) = delete;
+		Texture2D(Texture2D&&) = delete;
+		Texture2D& operator=(const Texture2D&) = delete;
+		Texture2D& operator=(Texture2D&&) = delete;
+
+		// Lets renderer internals refer to the texture without holding a reference
+		inline ResourceHandle<Texture2D> GetHandle() const { return m_Handle; }
+
 		static REF(Texture2D)Create(uint32_t width, uint32_t height);
+		// Cached: every path or file with the same contents shares one texture (see TextureLibrary)
 		static REF(Texture2D)Create(const std::string& path);
+		// Always loads a new texture, bypassing the cache
+		static REF(Texture2D)CreateUncached(const std::string& path);
+
+		// Returns immediately with a usable handle bound to the white placeholder; decode happens on
+		// worker threads and the upload streams in over the next frames (see TextureLoader)
+		static REF(Texture2D)CreateAsync(const std::string& path);
+
+	protected:
+		Texture2D() : m_Handle(ResourcePool<Texture2D>::Allocate(this)) {}
+
+	private:
+		ResourceHandle<Texture2D> m_Handle;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "CHpch.h"
+#include "Cherry/Renderer/TextureLibrary.h"
+
+#include "Cherry/Core/FrameAllocator.h"
+#include "Cherry/Core/Hash.h"
+#include "Cherry/Core/VFS.h"
+#include "Cherry/Renderer/CookedTexture.h"
+#include "Cherry/Renderer/TextureLoader.h"
+
+namespace Cherry {
+
+	struct TextureLibraryEntry
+	{
+		REF(Texture2D) Texture;
+		std::vector<std::string> Paths;		// Every canonical path that resolved to this content
+		std::string KeyPath;				// The file Size and ContentHash describe
+		uint64_t Size = 0;
+		uint64_t ContentHash = 0;			// 0 until a file of the same size needs comparing against it
+		uint64_t LastUsedFrame = 0;
+	};
+
+	struct TextureLibraryData
+	{
+		std::unordered_map<uint64_t, TextureLibraryEntry> Entries;	// By entry ID
+		std::unordered_map<std::string, uint64_t> PathIndex;			// Canonical path -> entry ID
+		std::unordered_multimap<uint64_t, uint64_t> SizeIndex;		// File size -> entry ID
+		uint64_t NextEntryID = 1;
+
+		uint64_t Budget = 512ull * 1024 * 1024;
+		uint64_t Frame = 0;
+		TextureLibrary::Statistics Stats;
+	};
+
+	static TextureLibraryData* s_Data = nullptr;
+
+	static uint64_t HashFileContents(const std::string& path)
+	{
+		CH_PROFILE_FUNCTION();
+
+		FileData file = VFS::Read(path);
+		return file ? Hash::FNV1a(file.GetBytes(), file.GetSize()) : 0;
+	}
+
+	// A synchronous load must return pixels, not a placeholder still streaming in: it loads its own copy,
+	// which takes over the entry while the async copy finishes for whoever already holds it
+	static const REF(Texture2D)& ShareEntry(TextureLibraryEntry& entry, const std::string& path, bool async)
+	{
+		if (!async && !entry.Texture->IsLoaded())
+			entry.Texture = Texture2D::CreateUncached(path);
+		entry.LastUsedFrame = s_Data->Frame;
+		s_Data->Stats.Hits++;
+		return entry.Texture;
+	}
+
+	void TextureLibrary::Init()
+	{
+		s_Data = new TextureLibraryData();
+	}
+
+	void TextureLibrary::Shutdown()
+	{
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	REF(Texture2D) TextureLibrary::Load(const std::string& path)
+	{
+		return Load(path, false);
+	}
+
+	REF(Texture2D) TextureLibrary::LoadAsync(const std::string& path)
+	{
+		return Load(path, true);
+	}
+
+	REF(Texture2D) TextureLibrary::Load(const std::string& path, bool async)
+	{
+		CH_PROFILE_FUNCTION();
+		HeapAllocationScope heapAllocations;
+
+		auto load = [async](const std::string& file) { return async ? TextureLoader::LoadAsync(file) : Texture2D::CreateUncached(file); };
+
+		std::string canonicalPath = VFS::NormalizePath(path);
+
+		auto pathIt = s_Data->PathIndex.find(canonicalPath);
+		if (pathIt != s_Data->PathIndex.end())
+			return ShareEntry(s_Data->Entries[pathIt->second], path, async);
+
+		// Cooked builds ship only the .chtex, so key on that when the source isn't there. Missing files
+		// are never shared, the loader reports the error.
+		std::string keyPath = path;
+		uint64_t size;
+		if (!VFS::GetSize(keyPath, size))
+		{
+			keyPath = CookedTexture::GetCookedPath(path);
+			if (!VFS::GetSize(keyPath, size))
+			{
+				s_Data->Stats.Misses++;
+				return load(path);
+			}
+		}
+
+		// Only files of equal size can match, and those are rare enough to hash on the spot
+		uint64_t contentHash = 0;
+		auto [sizeBegin, sizeEnd] = s_Data->SizeIndex.equal_range(size);
+		for (auto sizeIt = sizeBegin; sizeIt != sizeEnd; ++sizeIt)
+		{
+			TextureLibraryEntry& entry = s_Data->Entries[sizeIt->second];
+			if (entry.ContentHash == 0)
+				entry.ContentHash = HashFileContents(entry.KeyPath);
+			if (contentHash == 0)
+				contentHash = HashFileContents(keyPath);
+			if (contentHash == 0 || entry.ContentHash != contentHash)
+				continue;
+
+			entry.Paths.push_back(canonicalPath);
+			s_Data->PathIndex[canonicalPath] = sizeIt->second;
+			return ShareEntry(entry, path, async);
+		}
+
+		s_Data->Stats.Misses++;
+		REF(Texture2D) texture = load(path);
+
+		uint64_t entryID = s_Data->NextEntryID++;
+		TextureLibraryEntry& entry = s_Data->Entries[entryID];
+		entry.Texture = texture;
+		entry.Paths.push_back(canonicalPath);
+		entry.KeyPath = std::move(keyPath);
+		entry.Size = size;
+		entry.ContentHash = contentHash;
+		entry.LastUsedFrame = s_Data->Frame;
+		s_Data->PathIndex[canonicalPath] = entryID;
+		s_Data->SizeIndex.emplace(size, entryID);
+		return texture;
+	}
+
+	void TextureLibrary::Update(uint64_t frame)
+	{
+		CH_PROFILE_FUNCTION();
+
+		s_Data->Frame = frame;
+
+		uint64_t totalBytes = 0;
+		FrameVector<std::pair<uint64_t, uint64_t>> unreferenced;	// (last used frame, entry ID)
+		for (auto& [entryID, entry] : s_Data->Entries)
+		{
+			// Still held outside the cache counts as used this frame
+			if (entry.Texture.use_count() > 1)
+				entry.LastUsedFrame = frame;
+			else
+				unreferenced.emplace_back(entry.LastUsedFrame, entryID);
+
+			totalBytes += entry.Texture->GetMemorySize();
+		}
+
+		if (totalBytes > s_Data->Budget && !unreferenced.empty())
+		{
+			std::sort(unreferenced.begin(), unreferenced.end());
+			for (const auto& [lastUsedFrame, entryID] : unreferenced)
+			{
+				if (totalBytes <= s_Data->Budget)
+					break;
+
+				auto it = s_Data->Entries.find(entryID);
+				totalBytes -= it->second.Texture->GetMemorySize();
+				for (const auto& path : it->second.Paths)
+					s_Data->PathIndex.erase(path);
+				auto [sizeBegin, sizeEnd] = s_Data->SizeIndex.equal_range(it->second.Size);
+				for (auto sizeIt = sizeBegin; sizeIt != sizeEnd; ++sizeIt)
+				{
+					if (sizeIt->second == entryID)
+					{
+						s_Data->SizeIndex.erase(sizeIt);
+						break;
+					}
+				}
+				s_Data->Entries.erase(it);
+				s_Data->Stats.Evictions++;
+			}
+		}
+
+		s_Data->Stats.TextureCount = (uint32_t)s_Data->Entries.size();
+		s_Data->Stats.GPUBytes = totalBytes;
+
+		CH_PROFILE_COUNTER("TextureLibrary Hits", s_Data->Stats.Hits);
+		CH_PROFILE_COUNTER("TextureLibrary Misses", s_Data->Stats.Misses);
+		CH_PROFILE_COUNTER("TextureLibrary Evictions", s_Data->Stats.Evictions);
+		CH_PROFILE_COUNTER("TextureLibrary GPU Bytes", s_Data->Stats.GPUBytes);
+	}
+
+	void TextureLibrary::SetBudget(uint64_t bytes)
+	{
+		s_Data->Budget = bytes;
+	}
+
+	uint64_t TextureLibrary::GetBudget()
+	{
+		return s_Data->Budget;
+	}
+
+	TextureLibrary::Statistics TextureLibrary::GetStats()
+	{
+		return s_Data->Stats;
+	}
+
+	void TextureLibrary::ResetStats()
+	{
+		s_Data->Stats.Hits = 0;
+		s_Data->Stats.Misses = 0;
+		s_Data->Stats.Evictions = 0;
+	}
+}
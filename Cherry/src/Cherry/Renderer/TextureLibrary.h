@@ -0,0 +1,45 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Renderer/Texture.h"
+
+#include <string>
+
+namespace Cherry {
+
+	// Process-wide texture cache behind Texture2D::Create(path) and CreateAsync. Entries are found by
+	// normalized VFS path first and by content second, so the same image reached through different
+	// paths or copied files shares one GPU texture. Contents are only hashed when another file of the
+	// same size is already cached, so a new path normally costs no read on the calling thread. Load never
+	// returns a texture still streaming in from LoadAsync. The cache keeps a reference to every entry;
+	// entries nobody else references are evicted least recently used first when over budget.
+	// Render thread only.
+	class TextureLibrary
+	{
+	public:
+		struct Statistics
+		{
+			uint64_t Hits = 0;
+			uint64_t Misses = 0;
+			uint64_t Evictions = 0;
+			uint32_t TextureCount = 0;
+			uint64_t GPUBytes = 0;
+		};
+
+		static void Init();
+		static void Shutdown();
+
+		static REF(Texture2D) Load(const std::string& path);
+		static REF(Texture2D) LoadAsync(const std::string& path);
+
+		// Once per frame: refreshes usage, evicts over budget and publishes the counters
+		static void Update(uint64_t frame);
+
+		static void SetBudget(uint64_t bytes);
+		static uint64_t GetBudget();
+
+		static Statistics GetStats();
+		static void ResetStats();
+	private:
+		static REF(Texture2D) Load(const std::string& path, bool async);
+	};
+}
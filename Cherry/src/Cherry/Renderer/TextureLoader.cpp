@@ -0,0 +1,34 @@
+#include "CHpch.h"
+#include "Cherry/Renderer/TextureLoader.h"
+
+#include "Cherry/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLTextureLoader.h"
+#include "Platform/Null/NullTextureLoader.h"
+
+namespace Cherry {
+
+	TextureLoader* TextureLoader::s_Instance = nullptr;
+
+	void TextureLoader::Init()
+	{
+		CH_PROFILE_FUNCTION();
+
+		CH_CORE_ASSERT(!s_Instance, "TextureLoader already initialized!");
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    CH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return;
+		case RendererAPI::API::OpenGL:  s_Instance = new OpenGLTextureLoader(); return;
+		case RendererAPI::API::Null:    s_Instance = new NullTextureLoader(); return;
+		}
+
+		CH_CORE_ASSERT(false, "Unknown RendererAPI!");
+	}
+
+	void TextureLoader::Shutdown()
+	{
+		CH_PROFILE_FUNCTION();
+
+		delete s_Instance;
+		s_Instance = nullptr;
+	}
+}
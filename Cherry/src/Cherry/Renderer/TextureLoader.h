@@ -0,0 +1,38 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Renderer/Texture.h"
+
+namespace Cherry {
+
+	// Background texture loading: images decode on worker threads and their upload to the GPU
+	// is spread over frames within a byte budget. Dispatches to the active RendererAPI's loader.
+	class TextureLoader
+	{
+	public:
+		virtual ~TextureLoader() = default;
+
+		static void Init();
+		static void Shutdown();
+
+		inline static REF(Texture2D) LoadAsync(const std::string& path) { return s_Instance->LoadAsyncImpl(path); }
+
+		// Render thread, once per frame: moves decoded images to the GPU within the budget
+		inline static void ProcessUploads() { s_Instance->ProcessUploadsImpl(); }
+
+		inline static void SetUploadBudget(uint32_t bytesPerFrame) { s_Instance->m_UploadBudget = bytesPerFrame; }
+		inline static uint32_t GetUploadBudget() { return s_Instance->m_UploadBudget; }
+
+		inline static uint32_t GetPendingCount() { return s_Instance->GetPendingCountImpl(); }
+
+	protected:
+		virtual REF(Texture2D) LoadAsyncImpl(const std::string& path) = 0;
+		virtual void ProcessUploadsImpl() = 0;
+		virtual uint32_t GetPendingCountImpl() const = 0;
+
+	protected:
+		uint32_t m_UploadBudget = 4 * 1024 * 1024;
+
+	private:
+		static TextureLoader* s_Instance;
+	};
+}
@@ -0,0 +1,225 @@
+#include "CHpch.h"
+#include "Cherry/Renderer/TextureStreamer.h"
+
+#include "Cherry/Core/Application.h"
+#include "Cherry/Core/FrameAllocator.h"
+
+#include <queue>
+
+namespace Cherry {
+
+	struct StreamedTexture
+	{
+		ResourceHandle<Texture2D> Texture;
+		uint32_t WantedMip = 0;
+		uint64_t LastUsedFrame = 0;
+		uint64_t CoarserSinceFrame = 0;	// First frame the wanted mip was coarser than the resident one
+		bool Used = false;
+	};
+
+	struct TextureStreamerData
+	{
+		std::unordered_map<const Texture2D*, StreamedTexture> Textures;
+
+		glm::vec2 ViewportSize = { 1280.0f, 720.0f };	// Default window size until the first resize
+		uint64_t Budget = 256ull * 1024 * 1024;
+		uint64_t UploadBudget = 4ull * 1024 * 1024;
+		uint64_t ResidentSize = 0;
+		uint64_t Frame = 1;
+	};
+
+	static TextureStreamerData* s_Data = nullptr;
+
+	// Detail is only dropped after the texture wanted less for this long, so zooming back and forth doesn't thrash
+	static constexpr uint64_t s_DropDelayFrames = 30;
+	// Textures not drawn for this long fall back to their coarsest mip
+	static constexpr uint64_t s_UnusedFrames = 300;
+
+	void TextureStreamer::Init()
+	{
+		s_Data = new TextureStreamerData();
+	}
+
+	void TextureStreamer::Shutdown()
+	{
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void TextureStreamer::Register(const REF(Texture2D)& texture)
+	{
+		CH_CORE_ASSERT(texture->IsStreamable(), "Texture can't stream!");
+
+		StreamedTexture& entry = s_Data->Textures[texture.get()];
+		entry.Texture = texture->GetHandle();
+		entry.WantedMip = texture->GetResidentMip();
+	}
+
+	void TextureStreamer::ReportUsage(const Texture2D* texture, const glm::vec2& screenSize)
+	{
+		auto it = s_Data->Textures.find(texture);
+		if (it == s_Data->Textures.end())
+			return;
+
+		// One mip per halving of texels per screen pixel
+		float ratio = std::max(texture->GetWidth() / std::max(screenSize.x, 1.0f), texture->GetHeight() / std::max(screenSize.y, 1.0f));
+		uint32_t mip = ratio > 1.0f ? (uint32_t)std::floor(std::log2(ratio)) : 0;
+		mip = std::min(mip, texture->GetMipCount() - 1);
+
+		StreamedTexture& entry = it->second;
+		if (entry.LastUsedFrame != s_Data->Frame)
+		{
+			entry.WantedMip = mip;
+			entry.LastUsedFrame = s_Data->Frame;
+		}
+		else
+			entry.WantedMip = std::min(entry.WantedMip, mip);
+		entry.Used = true;
+	}
+
+	void TextureStreamer::Update()
+	{
+		CH_PROFILE_FUNCTION();
+
+		// Textures are only released on the main thread, so none can go away during the update
+		struct Candidate
+		{
+			Texture2D* Texture;
+			StreamedTexture* Entry;
+			uint32_t Target;
+		};
+
+		// The frame that just ended reported with this index
+		uint64_t frame = s_Data->Frame++;
+
+		FrameVector<Candidate> candidates;
+		candidates.reserve(s_Data->Textures.size());
+		uint64_t total = 0;
+
+		for (auto it = s_Data->Textures.begin(); it != s_Data->Textures.end(); )
+		{
+			Texture2D* texture = ResourcePool<Texture2D>::Get(it->second.Texture);
+			if (!texture)
+			{
+				it = s_Data->Textures.erase(it);
+				continue;
+			}
+
+			StreamedTexture& entry = it->second;
+			uint32_t resident = texture->GetResidentMip();
+			uint32_t target = resident;
+
+			// Never drawn through the 2D renderer: leave it as loaded
+			if (entry.Used)
+			{
+				target = frame - entry.LastUsedFrame > s_UnusedFrames ? texture->GetMipCount() - 1 : entry.WantedMip;
+
+				if (target > resident)
+				{
+					if (entry.CoarserSinceFrame == 0)
+						entry.CoarserSinceFrame = frame;
+					if (frame - entry.CoarserSinceFrame < s_DropDelayFrames)
+						target = resident;
+				}
+				else
+					entry.CoarserSinceFrame = 0;
+			}
+
+			total += texture->GetMemorySize(target);
+			candidates.push_back({ texture, &entry, target });
+			++it;
+		}
+
+		// Over budget: repeatedly take the finest level of whichever texture's finest level is largest
+		if (total > s_Data->Budget)
+		{
+			auto finestLevelSize = [](const Candidate& candidate)
+			{
+				return candidate.Texture->GetMemorySize(candidate.Target) - candidate.Texture->GetMemorySize(candidate.Target + 1);
+			};
+			auto compare = [&](const Candidate* a, const Candidate* b) { return finestLevelSize(*a) < finestLevelSize(*b); };
+			FrameVector<Candidate*> heap;
+			heap.reserve(candidates.size());
+			std::priority_queue<Candidate*, FrameVector<Candidate*>, decltype(compare)> evictable(compare, std::move(heap));
+
+			for (auto& candidate : candidates)
+			{
+				if (candidate.Target + 1 < candidate.Texture->GetMipCount())
+					evictable.push(&candidate);
+			}
+
+			while (total > s_Data->Budget && !evictable.empty())
+			{
+				Candidate* candidate = evictable.top();
+				evictable.pop();
+
+				total -= finestLevelSize(*candidate);
+				candidate->Target++;
+				if (candidate->Target + 1 < candidate->Texture->GetMipCount())
+					evictable.push(candidate);
+			}
+		}
+
+		// Drops are GPU copies; restores upload from the CPU copy and share a per-frame byte budget
+		uint64_t uploaded = 0;
+		uint64_t resident = 0;
+		bool deferred = false;
+		for (auto& candidate : candidates)
+		{
+			uint32_t current = candidate.Texture->GetResidentMip();
+			if (candidate.Target < current)
+			{
+				uint64_t cost = candidate.Texture->GetMemorySize(candidate.Target) - candidate.Texture->GetMemorySize(current);
+				if (uploaded > 0 && uploaded + cost > s_Data->UploadBudget)
+				{
+					resident += candidate.Texture->GetMemorySize();
+					deferred = true;
+					continue;
+				}
+				uploaded += cost;
+			}
+
+			if (candidate.Target != current)
+			{
+				candidate.Texture->SetResidentMip(candidate.Target);
+				candidate.Entry->CoarserSinceFrame = 0;
+			}
+			resident += candidate.Texture->GetMemorySize();
+		}
+		s_Data->ResidentSize = resident;
+
+		// Restores left for the next frame must not wait for an on-demand loop to wake up on its own
+		if (deferred)
+			Application::Get().GetFramePacer().RequestRedraw();
+	}
+
+	void TextureStreamer::SetViewportSize(uint32_t width, uint32_t height)
+	{
+		s_Data->ViewportSize = { (float)width, (float)height };
+	}
+
+	glm::vec2 TextureStreamer::GetViewportSize()
+	{
+		return s_Data->ViewportSize;
+	}
+
+	void TextureStreamer::SetBudget(uint64_t bytes)
+	{
+		s_Data->Budget = bytes;
+	}
+
+	uint64_t TextureStreamer::GetBudget()
+	{
+		return s_Data->Budget;
+	}
+
+	uint64_t TextureStreamer::GetResidentSize()
+	{
+		return s_Data->ResidentSize;
+	}
+
+	void TextureStreamer::SetUploadBudget(uint64_t bytesPerFrame)
+	{
+		s_Data->UploadBudget = bytesPerFrame;
+	}
+}
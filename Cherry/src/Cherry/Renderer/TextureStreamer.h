@@ -0,0 +1,35 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+#include "Cherry/Renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+namespace Cherry {
+
+	// Keeps streamable textures at the mip their on-screen size needs and holds their combined
+	// residency under a memory budget, dropping the finest levels first when it is exceeded
+	class TextureStreamer
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static void Register(const REF(Texture2D)& texture);
+
+		// The texture was drawn this frame covering roughly screenSize pixels
+		static void ReportUsage(const Texture2D* texture, const glm::vec2& screenSize);
+
+		// Render thread, once per frame: applies residency changes
+		static void Update();
+
+		static void SetViewportSize(uint32_t width, uint32_t height);
+		static glm::vec2 GetViewportSize();
+
+		static void SetBudget(uint64_t bytes);
+		static uint64_t GetBudget();
+		static uint64_t GetResidentSize();
+
+		// Bytes of mips restored per frame; dropping levels is a GPU copy and is not limited
+		static void SetUploadBudget(uint64_t bytesPerFrame);
+	};
+}
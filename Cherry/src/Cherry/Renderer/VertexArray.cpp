@@ -2,6 +2,7 @@
 #include "VertexArray.h"
 #include "Cherry/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLVertexArray.h"
+#include "Platform/Null/NullVertexArray.h"
 
 
 namespace Cherry {
@@ -12,6 +13,7 @@ namespace Cherry {
 		{
 		case RendererAPI::API::None:	CH_CLIENT_ASSERT(false, "RendererAPI::None is not Supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:	return std::make_shared<OpenGLVertexArray>();
+		case RendererAPI::API::Null:	return std::make_shared<NullVertexArray>();
 		}
 
 		CH_CLIENT_ASSERT(false, "UnKnown RendererAPI !");
@@ -1,13 +1,19 @@
 #pragma once
 #include <memory>
 #include "Cherry/Renderer/Buffer.h"
+#include "Cherry/Renderer/ResourcePool.h"
 
 namespace Cherry {
 
 	class VertexArray
 	{
 	public:
-		virtual ~VertexArray() {}
+		virtual ~VertexArray() { ResourcePool<VertexArray>::Release(m_Handle); }
+
+		VertexArray(const VertexArray&) = delete;
+		VertexArray(VertexArray&&) = delete;
+		VertexArray& operator=(const VertexArray&) = delete;
+		VertexArray& operator=(VertexArray&&) = delete;
 
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
@@ -21,5 +27,13 @@ namespace Cherry {
 
 
 		static REF(VertexArray) Create();
+
+		inline ResourceHandle<VertexArray> GetHandle() const { return m_Handle; }
+
+	protected:
+		VertexArray() : m_Handle(ResourcePool<VertexArray>::Allocate(this)) {}
+
+	private:
+		ResourceHandle<VertexArray> m_Handle;
 	};
 }
\ No newline at end of file
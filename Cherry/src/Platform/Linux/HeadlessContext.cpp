@@ -0,0 +1,295 @@
+#include "CHpch.h"
+#include "HeadlessContext.h"
+
+#include <glad/glad.h>
+#include <dlfcn.h>
+
+namespace Cherry
+{
+	// Just the slice of EGL and OSMesa used here, so neither needs headers or link-time libraries
+	namespace EGL {
+		using Boolean = unsigned int;
+		using Int = int32_t;
+		using Enum = unsigned int;
+		using Proc = void(*)();
+
+		constexpr Int None = 0x3038;
+		constexpr Int SurfaceType = 0x3033;
+		constexpr Int PbufferBit = 0x0001;
+		constexpr Int RedSize = 0x3024;
+		constexpr Int GreenSize = 0x3023;
+		constexpr Int BlueSize = 0x3022;
+		constexpr Int AlphaSize = 0x3021;
+		constexpr Int DepthSize = 0x3025;
+		constexpr Int StencilSize = 0x3026;
+		constexpr Int Width = 0x3057;
+		constexpr Int Height = 0x3056;
+		constexpr Int RenderableType = 0x3040;
+		constexpr Int OpenGLBit = 0x0008;
+		constexpr Enum OpenGLAPI = 0x30A2;
+		constexpr Int ContextMajorVersion = 0x3098;
+		constexpr Int ContextMinorVersion = 0x30FB;
+		constexpr Int ContextOpenGLProfileMask = 0x30FD;
+		constexpr Int ContextOpenGLCoreProfileBit = 0x0001;
+		constexpr Enum PlatformSurfacelessMESA = 0x31DD;
+
+		using GetProcAddressFn = Proc(*)(const char*);
+		using GetPlatformDisplayEXTFn = void*(*)(Enum, void*, const Int*);
+		using GetDisplayFn = void*(*)(void*);
+		using InitializeFn = Boolean(*)(void*, Int*, Int*);
+		using BindAPIFn = Boolean(*)(Enum);
+		using ChooseConfigFn = Boolean(*)(void*, const Int*, void**, Int, Int*);
+		using CreateContextFn = void*(*)(void*, void*, void*, const Int*);
+		using CreatePbufferSurfaceFn = void*(*)(void*, void*, const Int*);
+		using DestroySurfaceFn = Boolean(*)(void*, void*);
+		using MakeCurrentFn = Boolean(*)(void*, void*, void*, void*);
+		using DestroyContextFn = Boolean(*)(void*, void*);
+		using TerminateFn = Boolean(*)(void*);
+	}
+
+	namespace OSMesa {
+		using Proc = void(*)();
+
+		constexpr int Format = 0x22;
+		constexpr int RGBA = 0x1908;
+		constexpr int DepthBits = 0x30;
+		constexpr int StencilBits = 0x31;
+		constexpr int Profile = 0x33;
+		constexpr int CoreProfile = 0x34;
+		constexpr int ContextMajorVersion = 0x36;
+		constexpr int ContextMinorVersion = 0x37;
+
+		using CreateContextAttribsFn = void*(*)(const int*, void*);
+		using MakeCurrentFn = unsigned char(*)(void*, void*, unsigned int, int, int);
+		using GetProcAddressFn = Proc(*)(const char*);
+		using DestroyContextFn = void(*)(void*);
+	}
+
+	// glad wants a plain function, so the active loader is parked here while it runs
+	static void* (*s_GetProcAddress)(const char*) = nullptr;
+	static void* LoadGLProc(const char* name)
+	{
+		return s_GetProcAddress(name);
+	}
+
+	static void* OpenLibrary(std::initializer_list<const char*> names)
+	{
+		for (const char* name : names)
+		{
+			if (void* library = dlopen(name, RTLD_NOW | RTLD_LOCAL))
+				return library;
+		}
+		return nullptr;
+	}
+
+	template<typename Fn>
+	static Fn Load(void* library, const char* name)
+	{
+		return reinterpret_cast<Fn>(dlsym(library, name));
+	}
+
+	static inline const char* gl_to_cstr(const GLubyte* s)
+	{
+		return reinterpret_cast<const char*>(s);
+	}
+
+
+	HeadlessContext::HeadlessContext(uint32_t width, uint32_t height)
+		: m_Width(width), m_Height(height)
+	{
+		CH_CORE_INFO("Creating headless OpenGL context ({0}, {1})", width, height);
+	}
+
+	HeadlessContext::~HeadlessContext()
+	{
+		Release();
+	}
+
+	void HeadlessContext::Release()
+	{
+		if (!m_Library)
+			return;
+
+		if (m_IsOSMesa)
+		{
+			if (m_Context)
+				Load<OSMesa::DestroyContextFn>(m_Library, "OSMesaDestroyContext")(m_Context);
+		}
+		else if (m_Display)
+		{
+			Load<EGL::MakeCurrentFn>(m_Library, "eglMakeCurrent")(m_Display, nullptr, nullptr, nullptr);
+			if (m_Context)
+				Load<EGL::DestroyContextFn>(m_Library, "eglDestroyContext")(m_Display, m_Context);
+			if (m_Surface)
+				Load<EGL::DestroySurfaceFn>(m_Library, "eglDestroySurface")(m_Display, m_Surface);
+			Load<EGL::TerminateFn>(m_Library, "eglTerminate")(m_Display);
+		}
+
+		dlclose(m_Library);
+		m_Library = nullptr;
+		m_Display = nullptr;
+		m_Context = nullptr;
+		m_Surface = nullptr;
+	}
+
+	void HeadlessContext::Init()
+	{
+		CH_PROFILE_FUNCTION();
+
+		const char* forced = std::getenv("CH_HEADLESS_CONTEXT");
+		std::string backend = forced ? forced : "";
+
+		bool success = false;
+		if (backend != "osmesa")
+			success = InitEGL();
+		if (!success && backend != "egl")
+			success = InitOSMesa();
+		CH_CORE_ASSERT(success, "Failed to create a headless OpenGL context (need libEGL with Mesa or libOSMesa)!");
+		if (!success)
+			return;
+
+		CH_CORE_INFO("OpenGL Info ({0}):", m_IsOSMesa ? "OSMesa" : "EGL pbuffer");
+		CH_CORE_INFO("	OpenGL Vendor   : {}", gl_to_cstr(glGetString(GL_VENDOR)));
+		CH_CORE_INFO("	OpenGL Renderer : {}", gl_to_cstr(glGetString(GL_RENDERER)));
+		CH_CORE_INFO("	OpenGL Version  : {}", gl_to_cstr(glGetString(GL_VERSION)));
+	}
+
+	bool HeadlessContext::InitEGL()
+	{
+		CH_PROFILE_FUNCTION();
+
+		m_Library = OpenLibrary({ "libEGL.so.1", "libEGL.so" });
+		if (!m_Library)
+			return false;
+
+		static EGL::GetProcAddressFn s_EGLGetProcAddress;
+		s_EGLGetProcAddress = Load<EGL::GetProcAddressFn>(m_Library, "eglGetProcAddress");
+		auto getDisplay = Load<EGL::GetDisplayFn>(m_Library, "eglGetDisplay");
+		auto initialize = Load<EGL::InitializeFn>(m_Library, "eglInitialize");
+		auto bindAPI = Load<EGL::BindAPIFn>(m_Library, "eglBindAPI");
+		auto chooseConfig = Load<EGL::ChooseConfigFn>(m_Library, "eglChooseConfig");
+		auto createContext = Load<EGL::CreateContextFn>(m_Library, "eglCreateContext");
+		auto createPbufferSurface = Load<EGL::CreatePbufferSurfaceFn>(m_Library, "eglCreatePbufferSurface");
+		auto makeCurrent = Load<EGL::MakeCurrentFn>(m_Library, "eglMakeCurrent");
+		if (!s_EGLGetProcAddress || !getDisplay || !initialize || !bindAPI || !chooseConfig || !createContext || !createPbufferSurface || !makeCurrent)
+			return false;
+
+		// Surfaceless needs no X/Wayland connection; the default display is only a last resort
+		auto getPlatformDisplay = (EGL::GetPlatformDisplayEXTFn)s_EGLGetProcAddress("eglGetPlatformDisplayEXT");
+		if (getPlatformDisplay)
+			m_Display = getPlatformDisplay(EGL::PlatformSurfacelessMESA, nullptr, nullptr);
+		if (!m_Display)
+			m_Display = getDisplay(nullptr);
+
+		if (!m_Display || !initialize(m_Display, nullptr, nullptr) || !bindAPI(EGL::OpenGLAPI))
+		{
+			CH_CORE_WARN("EGL: no usable display");
+			return false;
+		}
+
+		// A pbuffer gives the context a default framebuffer, so everything drawn to framebuffer 0 renders
+		// just as it would to a window
+		const EGL::Int configAttribs[] = {
+			EGL::SurfaceType, EGL::PbufferBit,
+			EGL::RenderableType, EGL::OpenGLBit,
+			EGL::RedSize, 8,
+			EGL::GreenSize, 8,
+			EGL::BlueSize, 8,
+			EGL::AlphaSize, 8,
+			EGL::DepthSize, 24,
+			EGL::StencilSize, 8,
+			EGL::None
+		};
+		void* config = nullptr;
+		EGL::Int configCount = 0;
+		if (!chooseConfig(m_Display, configAttribs, &config, 1, &configCount) || configCount == 0)
+		{
+			CH_CORE_WARN("EGL: no OpenGL pbuffer config");
+			return false;
+		}
+
+		const EGL::Int surfaceAttribs[] = {
+			EGL::Width, (EGL::Int)m_Width,
+			EGL::Height, (EGL::Int)m_Height,
+			EGL::None
+		};
+		m_Surface = createPbufferSurface(m_Display, config, surfaceAttribs);
+		if (!m_Surface)
+		{
+			CH_CORE_WARN("EGL: could not create a {0}x{1} pbuffer", m_Width, m_Height);
+			return false;
+		}
+
+		const EGL::Int contextAttribs[] = {
+			EGL::ContextMajorVersion, 4,
+			EGL::ContextMinorVersion, 5,
+			EGL::ContextOpenGLProfileMask, EGL::ContextOpenGLCoreProfileBit,
+			EGL::None
+		};
+		m_Context = createContext(m_Display, config, nullptr, contextAttribs);
+		if (!m_Context || !makeCurrent(m_Display, m_Surface, m_Surface, m_Context))
+		{
+			CH_CORE_WARN("EGL: could not create a current OpenGL 4.5 core context");
+			return false;
+		}
+
+		s_GetProcAddress = [](const char* name) { return (void*)s_EGLGetProcAddress(name); };
+		int status = gladLoadGLLoader((GLADloadproc)LoadGLProc);
+		s_GetProcAddress = nullptr;
+		return status != 0;
+	}
+
+	bool HeadlessContext::InitOSMesa()
+	{
+		CH_PROFILE_FUNCTION();
+
+		// A failed EGL attempt may have left a half-initialized display behind
+		Release();
+
+		m_Library = OpenLibrary({ "libOSMesa.so.8", "libOSMesa.so.6", "libOSMesa.so" });
+		if (!m_Library)
+			return false;
+		m_IsOSMesa = true;
+
+		static OSMesa::GetProcAddressFn s_OSMesaGetProcAddress;
+		s_OSMesaGetProcAddress = Load<OSMesa::GetProcAddressFn>(m_Library, "OSMesaGetProcAddress");
+		auto createContext = Load<OSMesa::CreateContextAttribsFn>(m_Library, "OSMesaCreateContextAttribs");
+		auto makeCurrent = Load<OSMesa::MakeCurrentFn>(m_Library, "OSMesaMakeCurrent");
+		if (!s_OSMesaGetProcAddress || !createContext || !makeCurrent)
+			return false;
+
+		const int attribs[] = {
+			OSMesa::Format, OSMesa::RGBA,
+			OSMesa::DepthBits, 24,
+			OSMesa::StencilBits, 8,
+			OSMesa::Profile, OSMesa::CoreProfile,
+			OSMesa::ContextMajorVersion, 4,
+			OSMesa::ContextMinorVersion, 5,
+			0
+		};
+		m_Context = createContext(attribs, nullptr);
+		if (!m_Context)
+		{
+			CH_CORE_WARN("OSMesa: could not create an OpenGL 4.5 core context");
+			return false;
+		}
+
+		m_ColorBuffer.resize((size_t)m_Width * m_Height * 4);
+		if (!makeCurrent(m_Context, m_ColorBuffer.data(), GL_UNSIGNED_BYTE, (int)m_Width, (int)m_Height))
+		{
+			CH_CORE_WARN("OSMesa: could not make the context current");
+			return false;
+		}
+
+		s_GetProcAddress = [](const char* name) { return (void*)s_OSMesaGetProcAddress(name); };
+		int status = gladLoadGLLoader((GLADloadproc)LoadGLProc);
+		s_GetProcAddress = nullptr;
+		return status != 0;
+	}
+
+	void HeadlessContext::SwapBuffers()
+	{
+		CH_PROFILE_FUNCTION();
+		glFinish();
+	}
+}
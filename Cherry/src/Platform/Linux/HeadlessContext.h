@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Cherry/Renderer/GraphicsContext.h"
+
+namespace Cherry
+{
+	// OpenGL 4.5 core context with no window or display. Tries EGL on Mesa's surfaceless platform
+	// first (GPU if present, llvmpipe otherwise), then falls back to OSMesa; CH_HEADLESS_CONTEXT=egl|osmesa
+	// forces one. Both libraries are loaded at runtime, so the engine links and runs without them
+	// as long as no headless GL context is requested.
+	//
+	// Either way framebuffer 0 is a window-sized offscreen target: an EGL pbuffer, or OSMesa's
+	// client-side buffer.
+	class HeadlessContext : public GraphicsContext
+	{
+	public:
+		HeadlessContext(uint32_t width, uint32_t height);
+		virtual ~HeadlessContext();
+
+		virtual void Init() override;
+		// Nothing to present; waits for the frame so timings match a presented one
+		virtual void SwapBuffers() override;
+
+	private:
+		bool InitEGL();
+		bool InitOSMesa();
+		void Release();
+
+	private:
+		uint32_t m_Width, m_Height;
+
+		void* m_Library = nullptr;
+		void* m_Display = nullptr;		// EGLDisplay
+		void* m_Context = nullptr;		// EGLContext or OSMesaContext
+		void* m_Surface = nullptr;		// EGLSurface
+		bool m_IsOSMesa = false;
+		std::vector<uint8_t> m_ColorBuffer;
+	};
+}
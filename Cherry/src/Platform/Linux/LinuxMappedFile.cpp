@@ -0,0 +1,57 @@
+#include "CHpch.h"
+#include "Cherry/Core/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Cherry {
+
+	MappedFile::MappedFile(const std::string& path)
+	{
+		Open(path);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		CH_PROFILE_FUNCTION();
+
+		Close();
+
+		int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file < 0)
+			return false;
+
+		struct stat info;
+		if (fstat(file, &info) != 0 || info.st_size == 0)
+		{
+			close(file);
+			return false;
+		}
+
+		void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		// The mapping keeps the file alive on its own, so no handles are kept
+		close(file);
+		if (data == MAP_FAILED)
+			return false;
+
+		m_Data = data;
+		m_Size = (size_t)info.st_size;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			munmap(m_Data, m_Size);
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+}
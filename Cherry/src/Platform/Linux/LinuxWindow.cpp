@@ -0,0 +1,257 @@
+#include "CHpch.h"
+#include "LinuxWindow.h"
+
+#include "Cherry/Events/KeyEvent.h"
+#include "Cherry/Events/MouseEvent.h"
+#include "Cherry/Events/ApplicationEvent.h"
+#include "Cherry/Renderer/RendererAPI.h"
+#include "Platform/OpenGL/OpenGLContext.h"
+#include "Platform/Linux/HeadlessContext.h"
+
+namespace Cherry {
+
+	// GLFW is initialized with the first window and terminated with the last
+	static uint32_t s_GLFWWindowCount = 0;
+	static void GLFWErrorCallback(int error_code, const char* description)
+	{
+		CH_CORE_ERROR("GLFW Error ({0}): {1}", error_code, description);
+	}
+
+	// CH_HEADLESS=1 forces headless even on machines with a display
+	static bool WantsHeadless()
+	{
+		const char* headless = std::getenv("CH_HEADLESS");
+		if (headless && std::strcmp(headless, "0") != 0)
+			return true;
+		return !std::getenv("DISPLAY") && !std::getenv("WAYLAND_DISPLAY");
+	}
+
+
+	Window* Window::Create(const WindowProps& props)
+	{
+		return new LinuxWindow(props);
+	}
+
+	LinuxWindow::LinuxWindow(const WindowProps& props)
+	{
+		CH_PROFILE_FUNCTION();
+		Init(props);
+	}
+
+	LinuxWindow::~LinuxWindow()
+	{
+		CH_PROFILE_FUNCTION();
+
+		Shutdown();
+	}
+
+	void LinuxWindow::Init(const WindowProps& props) {
+		CH_PROFILE_FUNCTION();
+		m_Data.Title = props.Title;
+		m_Data.Width = props.Width;
+		m_Data.Height = props.Height;
+		m_Headless = props.Headless || WantsHeadless();
+
+		CH_CORE_INFO("Creating {0}window [{1}] ({2}, {3})", m_Headless ? "headless " : "", props.Title, props.Width, props.Height);
+
+		if (s_GLFWWindowCount == 0)
+		{
+			CH_PROFILE_SCOPE("glfwInit");
+			// The null platform needs no display but still provides windows, input state and the timer
+			if (m_Headless)
+				glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+			int success = glfwInit();
+			CH_CORE_ASSERT(success, "Could not initialize GLFW!");
+			glfwSetErrorCallback(GLFWErrorCallback);
+		}
+
+		{
+			CH_PROFILE_SCOPE("glfwCreateWindow");
+
+			if (m_Headless)
+			{
+				// The GL context, if any, comes from HeadlessContext rather than GLFW
+				glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+				glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+			}
+			else
+			{
+				// Mesa only exposes 4.5 (needed for DSA) on core profile contexts
+				glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+				glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+				glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+			}
+
+			m_Window = glfwCreateWindow((int)props.Width, (int)props.Height, m_Data.Title.c_str(), nullptr, nullptr);
+			s_GLFWWindowCount++;
+		}
+
+		if (!m_Headless)
+			m_Context = new OpenGLContext(m_Window);
+		else if (RendererAPI::GetAPI() != RendererAPI::API::Null)
+			m_Context = new HeadlessContext(props.Width, props.Height);
+		else
+			m_Context = nullptr;
+
+		if (m_Context)
+			m_Context->Init();
+
+
+		glfwSetWindowUserPointer(m_Window, &m_Data);
+		SetVSync(!m_Headless);
+
+		//SITING GLFW CALLBACKS
+		glfwSetWindowSizeCallback(m_Window, [](GLFWwindow* window, int width, int height)
+			{
+				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+				data.Width = width;
+				data.Height = height;
+				WindowResizeEvent event(width, height);
+				data.EventCallback(event);
+			});
+
+		glfwSetWindowCloseCallback(m_Window, [](GLFWwindow* window)
+			{
+				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+				WindowCloseEvent event;
+				data.EventCallback(event);
+			});
+
+		glfwSetWindowFocusCallback(m_Window, [](GLFWwindow* window, int focused)
+			{
+				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+				if (focused)
+				{
+					WindowFocusEvent event;
+					data.EventCallback(event);
+				}
+				else
+				{
+					WindowLostFocusEvent event;
+					data.EventCallback(event);
+				}
+			});
+
+		glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
+			{
+				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+				switch (action)
+				{
+					case GLFW_PRESS:
+					{
+						KeyPressedEvent event(key, 0);
+						data.EventCallback(event);
+						break;
+					}
+					case GLFW_RELEASE:
+					{
+						KeyReleasedEvent event(key);
+						data.EventCallback(event);
+						break;
+					}
+					case GLFW_REPEAT:
+					{
+						KeyPressedEvent event(key, 1);
+						data.EventCallback(event);
+						break;
+					}
+					default:
+						break;
+				}
+			});
+
+		glfwSetCharCallback(m_Window, [](GLFWwindow* window, unsigned int keycode)
+			{
+				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+				KeyTypedEvent event(keycode);
+				data.EventCallback(event);
+			});
+
+		glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* window, int button, int action, int mods)
+			{
+				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+				switch (action)
+				{
+					case GLFW_PRESS:
+					{
+						MouseButtonPressedEvent event(button);
+						data.EventCallback(event);
+						break;
+					}
+					case GLFW_RELEASE:
+					{
+						MouseButtonReleasedEvent event(button);
+						data.EventCallback(event);
+						break;
+					}
+					default:
+						break;
+				}
+			});
+
+		glfwSetScrollCallback(m_Window, [](GLFWwindow* window, double xoffset, double yoffset)
+			{
+				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+				MouseScrolledEvent event((float)xoffset, (float)yoffset);
+				data.EventCallback(event);
+			});
+
+		glfwSetCursorPosCallback(m_Window, [](GLFWwindow* window, double xpos, double ypos)
+			{
+				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+				MouseMovedEvent event((float)xpos, (float)ypos);
+				data.EventCallback(event);
+			});
+	}
+
+
+	void LinuxWindow::Shutdown()
+	{
+		CH_PROFILE_FUNCTION();
+		delete m_Context;
+		m_Context = nullptr;
+		glfwDestroyWindow(m_Window);
+
+		if (--s_GLFWWindowCount == 0)
+			glfwTerminate();
+	}
+
+	void LinuxWindow::OnUpdate()
+	{
+		CH_PROFILE_FUNCTION();
+		glfwPollEvents();
+		if (m_Context)
+			m_Context->SwapBuffers();
+	}
+
+	void LinuxWindow::WaitEvents(double timeoutSeconds)
+	{
+		CH_PROFILE_FUNCTION();
+
+		// GLFW's null platform never blocks, and nothing can arrive headless anyway
+		if (m_Headless)
+			std::this_thread::sleep_for(std::chrono::duration<double>(timeoutSeconds));
+		else
+			glfwWaitEventsTimeout(timeoutSeconds);
+	}
+
+	void LinuxWindow::SetVSync(bool enabled)
+	{
+		CH_PROFILE_FUNCTION();
+
+		// Headless frames are never presented, there is nothing to sync to
+		if (!m_Headless)
+			glfwSwapInterval(enabled ? 1 : 0);
+
+		m_Data.VSync = enabled;
+	}
+
+	bool LinuxWindow::IsVSync() const
+	{
+		return m_Data.VSync;
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "Cherry/Core/Window.h"
+#include <GLFW/glfw3.h>
+#include "Cherry/Renderer/GraphicsContext.h"
+
+namespace Cherry
+{
+	class LinuxWindow : public Window
+	{
+	public:
+		LinuxWindow(const WindowProps& props);
+		virtual ~LinuxWindow();
+
+		void OnUpdate() override;
+		void WaitEvents(double timeoutSeconds) override;
+		inline unsigned int GetWidth() const override { return m_Data.Width; }
+		inline unsigned int GetHeight() const override { return m_Data.Height; }
+		// Window attributes
+		inline void SetEventCallback(const EventCallbackFn& callback) override { m_Data.EventCallback = callback; }
+		void SetVSync(bool enabled) override;
+		bool IsVSync() const override;
+
+		// GLFWwindow*, on GLFW's null platform when headless
+		inline virtual void* GetNativeWindow() const override { return m_Window; }
+
+		inline bool IsHeadless() const { return m_Headless; }
+
+	private:
+		virtual void Init(const WindowProps& props);
+		virtual void Shutdown();
+
+	private:
+		GLFWwindow* m_Window;
+		// Null when headless with the Null RendererAPI: nothing is drawn, so no GL is needed
+		GraphicsContext* m_Context;
+		bool m_Headless = false;
+
+		struct WindowData
+		{
+			std::string Title;
+			unsigned int Width, Height;
+			bool VSync;
+
+			EventCallbackFn EventCallback;
+		};
+
+		WindowData m_Data;
+	};
+
+}
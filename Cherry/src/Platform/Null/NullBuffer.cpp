@@ -0,0 +1,31 @@
+#include "CHpch.h"
+#include "Platform/Null/NullBuffer.h"
+
+#include "Platform/Null/NullCommandLog.h"
+
+namespace Cherry {
+
+	NullVertexBuffer::NullVertexBuffer(float* vertices, uint32_t size)
+		: m_Size(size)
+	{
+		m_RendererID = NullCommandLog::OnCreate(NullResourceType::VertexBuffer, m_Size);
+		NullCommandLog::Record(NullCommandType::UploadBuffer, m_RendererID, m_Size);
+	}
+
+	NullVertexBuffer::~NullVertexBuffer()
+	{
+		NullCommandLog::OnDestroy(NullResourceType::VertexBuffer, m_Size);
+	}
+
+	NullIndexBuffer::NullIndexBuffer(uint32_t* indices, uint32_t count)
+		: m_Count(count)
+	{
+		m_RendererID = NullCommandLog::OnCreate(NullResourceType::IndexBuffer, m_Count * sizeof(uint32_t));
+		NullCommandLog::Record(NullCommandType::UploadBuffer, m_RendererID, m_Count * sizeof(uint32_t));
+	}
+
+	NullIndexBuffer::~NullIndexBuffer()
+	{
+		NullCommandLog::OnDestroy(NullResourceType::IndexBuffer, m_Count * sizeof(uint32_t));
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Cherry/Renderer/Buffer.h"
+
+namespace Cherry {
+
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer(float* vertices, uint32_t size);
+		virtual ~NullVertexBuffer();
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+		uint32_t GetRendererID() const { return m_RendererID; }
+
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Size;
+		BufferLayout m_Layout;
+	};
+
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(uint32_t* indices, uint32_t count);
+		virtual ~NullIndexBuffer();
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual uint32_t GetCount() const override { return m_Count; }
+
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Count;
+	};
+}
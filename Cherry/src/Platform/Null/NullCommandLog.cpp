@@ -0,0 +1,103 @@
+#include "CHpch.h"
+#include "Platform/Null/NullCommandLog.h"
+
+#include "Cherry/Core/Hash.h"
+
+namespace Cherry {
+
+	static constexpr size_t s_CommandTypeCount = (size_t)NullCommandType::Count;
+	static constexpr size_t s_ResourceTypeCount = (size_t)NullResourceType::Count;
+
+	struct NullCommandLogData
+	{
+		std::vector<NullCommand> Commands;
+		bool Recording = false;
+
+		std::array<uint64_t, s_CommandTypeCount> CommandCounts{};
+		std::array<uint64_t, s_CommandTypeCount> CommandBytes{};
+
+		std::array<uint32_t, s_ResourceTypeCount> ResourceCounts{};
+		std::array<uint64_t, s_ResourceTypeCount> ResourceBytes{};
+		uint32_t NextResourceID = 1;
+	};
+
+	static NullCommandLogData s_Data;
+
+	void NullCommandLog::Record(NullCommandType type, uint32_t resource, uint32_t bytes)
+	{
+		s_Data.CommandCounts[(size_t)type]++;
+		s_Data.CommandBytes[(size_t)type] += bytes;
+
+		if (s_Data.Recording)
+			s_Data.Commands.push_back({ type, resource, bytes });
+	}
+
+	void NullCommandLog::SetRecording(bool recording)
+	{
+		s_Data.Recording = recording;
+	}
+
+	bool NullCommandLog::IsRecording()
+	{
+		return s_Data.Recording;
+	}
+
+	const std::vector<NullCommand>& NullCommandLog::GetCommands()
+	{
+		return s_Data.Commands;
+	}
+
+	uint64_t NullCommandLog::GetHash()
+	{
+		// Field by field, padding bytes are not part of the identity
+		uint64_t hash = Hash::s_FNVOffsetBasis;
+		for (const auto& command : s_Data.Commands)
+		{
+			hash = Hash::FNV1a(&command.Type, sizeof(command.Type), hash);
+			hash = Hash::FNV1a(&command.Resource, sizeof(command.Resource), hash);
+			hash = Hash::FNV1a(&command.Bytes, sizeof(command.Bytes), hash);
+		}
+		return hash;
+	}
+
+	uint64_t NullCommandLog::GetCommandCount(NullCommandType type)
+	{
+		return s_Data.CommandCounts[(size_t)type];
+	}
+
+	uint64_t NullCommandLog::GetCommandBytes(NullCommandType type)
+	{
+		return s_Data.CommandBytes[(size_t)type];
+	}
+
+	void NullCommandLog::Reset()
+	{
+		s_Data.Commands.clear();
+		s_Data.CommandCounts.fill(0);
+		s_Data.CommandBytes.fill(0);
+	}
+
+	uint32_t NullCommandLog::OnCreate(NullResourceType type, uint64_t bytes)
+	{
+		s_Data.ResourceCounts[(size_t)type]++;
+		s_Data.ResourceBytes[(size_t)type] += bytes;
+		return s_Data.NextResourceID++;
+	}
+
+	void NullCommandLog::OnDestroy(NullResourceType type, uint64_t bytes)
+	{
+		CH_CORE_ASSERT(s_Data.ResourceCounts[(size_t)type] > 0, "Destroying more resources than were created!");
+		s_Data.ResourceCounts[(size_t)type]--;
+		s_Data.ResourceBytes[(size_t)type] -= bytes;
+	}
+
+	uint32_t NullCommandLog::GetResourceCount(NullResourceType type)
+	{
+		return s_Data.ResourceCounts[(size_t)type];
+	}
+
+	uint64_t NullCommandLog::GetResourceBytes(NullResourceType type)
+	{
+		return s_Data.ResourceBytes[(size_t)type];
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "Cherry/Core/Core.h"
+
+namespace Cherry {
+
+	enum class NullCommandType : uint8_t
+	{
+		SetViewport,
+		SetClearColor,
+		Clear,
+		DrawIndexed,
+		BindVertexArray,
+		BindShader,
+		SetUniform,
+		BindTexture,
+		BindMaterial,
+		UploadBuffer,
+		UploadTexture,
+
+		Count
+	};
+
+	enum class NullResourceType : uint8_t
+	{
+		VertexBuffer,
+		IndexBuffer,
+		VertexArray,
+		Shader,
+		Texture,
+		Material,
+		Framebuffer,
+
+		Count
+	};
+
+	struct NullCommand
+	{
+		NullCommandType Type;
+		uint32_t Resource;		// ID of the resource the command acts on, 0 when none
+		uint32_t Bytes;			// Data the command moves: uploads, uniform values, indices read by a draw
+	};
+
+	// Bookkeeping behind the Null RendererAPI: counts every command and live resource, and when recording
+	// keeps the full command stream. Resource IDs are handed out in creation order, so a deterministic
+	// workload produces the same log and hash on every run and machine. Render thread only.
+	class NullCommandLog
+	{
+	public:
+		static void Record(NullCommandType type, uint32_t resource = 0, uint32_t bytes = 0);
+
+		// Counters are always kept, the command stream only while recording
+		static void SetRecording(bool recording);
+		static bool IsRecording();
+
+		static const std::vector<NullCommand>& GetCommands();
+		// Order-sensitive hash of the recorded stream, for comparing runs
+		static uint64_t GetHash();
+
+		static uint64_t GetCommandCount(NullCommandType type);
+		static uint64_t GetCommandBytes(NullCommandType type);
+
+		// Clears the recorded stream and command counters; live resources are untouched
+		static void Reset();
+
+		// Returns the new resource's ID
+		static uint32_t OnCreate(NullResourceType type, uint64_t bytes = 0);
+		static void OnDestroy(NullResourceType type, uint64_t bytes = 0);
+
+		static uint32_t GetResourceCount(NullResourceType type);
+		static uint64_t GetResourceBytes(NullResourceType type);
+	};
+}
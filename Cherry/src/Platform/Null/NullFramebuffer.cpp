@@ -0,0 +1,49 @@
+#include "CHpch.h"
+#include "Platform/Null/NullFramebuffer.h"
+
+#include "Platform/Null/NullCommandLog.h"
+
+namespace Cherry {
+
+	NullFramebuffer::NullFramebuffer(const FramebufferSpecification& spec)
+		: m_Specification(spec)
+	{
+		m_RendererID = NullCommandLog::OnCreate(NullResourceType::Framebuffer);
+	}
+
+	NullFramebuffer::~NullFramebuffer()
+	{
+		NullCommandLog::OnDestroy(NullResourceType::Framebuffer);
+	}
+
+	void NullFramebuffer::Bind()
+	{
+		NullCommandLog::Record(NullCommandType::SetViewport, m_RendererID);
+	}
+
+	void NullFramebuffer::Resize(uint32_t width, uint32_t height)
+	{
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+	}
+
+	bool NullFramebuffer::ReadPixelsAsync(uint32_t attachmentIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+		const FramebufferReadbackCallback& callback)
+	{
+		m_PendingReadbacks.push_back({ width, height, callback });
+		return true;
+	}
+
+	void NullFramebuffer::ProcessReadbacks()
+	{
+		// 8 bytes per pixel covers the widest attachment format
+		std::vector<uint8_t> zeros;
+		for (const auto& readback : m_PendingReadbacks)
+		{
+			zeros.assign((size_t)readback.Width * readback.Height * 8, 0);
+			if (readback.Callback)
+				readback.Callback(zeros.data(), readback.Width, readback.Height);
+		}
+		m_PendingReadbacks.clear();
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "Cherry/Renderer/Framebuffer.h"
+
+namespace Cherry {
+
+	class NullFramebuffer : public Framebuffer
+	{
+	public:
+		NullFramebuffer(const FramebufferSpecification& spec);
+		virtual ~NullFramebuffer();
+
+		virtual void Bind() override;
+		virtual void Unbind() override {}
+
+		virtual void Resize(uint32_t width, uint32_t height) override;
+		virtual void Resolve() override {}
+
+		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override {}
+		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override { return 0; }
+
+		// Delivered zero-filled on the next ProcessReadbacks, one frame late like a real readback
+		virtual bool ReadPixelsAsync(uint32_t attachmentIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+			const FramebufferReadbackCallback& callback) override;
+		virtual void ProcessReadbacks() override;
+		virtual uint32_t GetPendingReadbackCount() const override { return (uint32_t)m_PendingReadbacks.size(); }
+
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { return m_RendererID; }
+
+		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+
+	private:
+		struct PendingReadback
+		{
+			uint32_t Width, Height;
+			FramebufferReadbackCallback Callback;
+		};
+
+		FramebufferSpecification m_Specification;
+		uint32_t m_RendererID;
+		std::vector<PendingReadback> m_PendingReadbacks;
+	};
+}
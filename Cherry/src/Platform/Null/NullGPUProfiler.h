@@ -0,0 +1,14 @@
+#pragma once
+#include "Cherry/Renderer/GPUProfiler.h"
+
+namespace Cherry {
+
+	// No GPU, no GPU track
+	class NullGPUProfiler : public GPUProfiler
+	{
+	protected:
+		virtual uint32_t BeginScopeImpl(const char* name) override { return 0; }
+		virtual void EndScopeImpl(uint32_t scope) override {}
+		virtual void BeginFrameImpl() override {}
+	};
+}
@@ -0,0 +1,32 @@
+#include "CHpch.h"
+#include "Platform/Null/NullMaterial.h"
+
+#include "Platform/Null/NullCommandLog.h"
+
+namespace Cherry {
+
+	NullMaterial::NullMaterial(const REF(Shader)& shader)
+		: Material(shader)
+	{
+		NullCommandLog::OnCreate(NullResourceType::Material, m_Data.size());
+	}
+
+	NullMaterial::~NullMaterial()
+	{
+		NullCommandLog::OnDestroy(NullResourceType::Material, m_Data.size());
+	}
+
+	void NullMaterial::Bind()
+	{
+		// Material IDs are already unique, no need for a second one from the log
+		NullCommandLog::Record(NullCommandType::BindMaterial, m_ID);
+		if (m_Dirty)
+		{
+			NullCommandLog::Record(NullCommandType::UploadBuffer, m_ID, (uint32_t)m_Data.size());
+			m_Dirty = false;
+		}
+
+		for (const auto& [slot, texture] : m_Textures)
+			texture->Bind(slot);
+	}
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "Cherry/Renderer/Material.h"
+
+namespace Cherry {
+
+	class NullMaterial : public Material
+	{
+	public:
+		NullMaterial(const REF(Shader)& shader);
+		virtual ~NullMaterial();
+
+		virtual void Bind() override;
+	};
+}
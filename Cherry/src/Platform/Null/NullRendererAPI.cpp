@@ -0,0 +1,37 @@
+#include "CHpch.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+#include "Platform/Null/NullCommandLog.h"
+#include "Platform/Null/NullVertexArray.h"
+
+namespace Cherry {
+
+	void NullRendererAPI::Init()
+	{
+		CH_PROFILE_FUNCTION();
+
+		CH_CORE_INFO("Null renderer: no GPU work will be submitted");
+	}
+
+	void NullRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		NullCommandLog::Record(NullCommandType::SetViewport);
+	}
+
+	void NullRendererAPI::SetClearColor(const glm::vec4& color)
+	{
+		NullCommandLog::Record(NullCommandType::SetClearColor);
+	}
+
+	void NullRendererAPI::Clear()
+	{
+		NullCommandLog::Record(NullCommandType::Clear);
+	}
+
+	void NullRendererAPI::DrawIndexed(const VertexArray& vertexArray)
+	{
+		auto& nullVertexArray = static_cast<const NullVertexArray&>(vertexArray);
+		uint32_t indexBytes = vertexArray.GetIndexBuffers()->GetCount() * sizeof(uint32_t);
+		NullCommandLog::Record(NullCommandType::DrawIndexed, nullVertexArray.GetRendererID(), indexBytes);
+	}
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Cherry/Renderer/RendererAPI.h"
+
+namespace Cherry {
+
+	class NullRendererAPI : public RendererAPI
+	{
+	public:
+		virtual void Init() override;
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		virtual void SetClearColor(const glm::vec4& color) override;
+		virtual void Clear() override;
+
+		virtual void DrawIndexed(const VertexArray& vertexArray) override;
+	};
+}
@@ -0,0 +1,118 @@
+#include "CHpch.h"
+#include "Platform/Null/NullShader.h"
+
+#include "Platform/Null/NullCommandLog.h"
+#include "Cherry/Core/VFS.h"
+
+namespace Cherry {
+
+	static ShaderDataType ShaderDataTypeFromGLSL(const std::string& type)
+	{
+		static const std::unordered_map<std::string, ShaderDataType> s_Types = {
+			{ "float", ShaderDataType::Float }, { "vec2", ShaderDataType::Float2 },
+			{ "vec3", ShaderDataType::Float3 }, { "vec4", ShaderDataType::Float4 },
+			{ "mat3", ShaderDataType::Mat3 }, { "mat4", ShaderDataType::Mat4 },
+			{ "int", ShaderDataType::Int }, { "ivec2", ShaderDataType::Int2 },
+			{ "ivec3", ShaderDataType::Int3 }, { "ivec4", ShaderDataType::Int4 },
+			{ "bool", ShaderDataType::Int }, { "sampler2D", ShaderDataType::Int }
+		};
+
+		auto it = s_Types.find(type);
+		return it != s_Types.end() ? it->second : ShaderDataType::None;
+	}
+
+	NullShader::NullShader(const std::string& filepath)
+	{
+		CH_PROFILE_FUNCTION();
+
+		auto lastSlash = filepath.find_last_of("/\\");
+		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+		auto lastDot = filepath.rfind('.');
+		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
+		m_Name = filepath.substr(lastSlash, count);
+
+		m_RendererID = NullCommandLog::OnCreate(NullResourceType::Shader);
+
+		FileData file = VFS::Read(filepath);
+		if (!file)
+		{
+			CH_CORE_WARN("Null shader '{0}': source not found, material layout is empty", filepath);
+			return;
+		}
+		Reflect(std::string(file.AsString()));
+	}
+
+	NullShader::NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+		: m_Name(name)
+	{
+		CH_PROFILE_FUNCTION();
+
+		m_RendererID = NullCommandLog::OnCreate(NullResourceType::Shader);
+		Reflect(vertexSrc + "\n" + fragmentSrc);
+	}
+
+	NullShader::~NullShader()
+	{
+		NullCommandLog::OnDestroy(NullResourceType::Shader);
+	}
+
+	void NullShader::Reflect(const std::string& source)
+	{
+		// Top-level "uniform <type> <name>[count];" only; uniform blocks are not reflected
+		static const std::regex s_Uniform(R"(^\s*uniform\s+(\w+)\s+(\w+)\s*(?:\[\s*(\d+)\s*\])?\s*;)");
+
+		std::unordered_set<std::string> seen;
+		uint32_t packedOffset = 0;
+		std::istringstream stream(source);
+		std::string line;
+		std::smatch match;
+		while (std::getline(stream, line))
+		{
+			if (!std::regex_search(line, match, s_Uniform))
+				continue;
+
+			std::string name = match[2].str();
+			if (name == "u_ViewProjection" || name == "u_Transform" || !seen.insert(name).second)
+				continue;
+
+			ShaderDataType type = ShaderDataTypeFromGLSL(match[1].str());
+			if (type == ShaderDataType::None)
+				continue;
+
+			uint32_t arraySize = match[3].matched ? (uint32_t)std::stoul(match[3].str()) : 1;
+			uint32_t size = ShaderDataTypeSize(type) * arraySize;
+			m_MaterialLayout.Add({ name, type, size, packedOffset, arraySize, -1 });
+			packedOffset += (size + 3) & ~3u;
+		}
+	}
+
+	void NullShader::Bind() const
+	{
+		NullCommandLog::Record(NullCommandType::BindShader, m_RendererID);
+	}
+
+	void NullShader::SetInt(std::string_view name, int value)
+	{
+		NullCommandLog::Record(NullCommandType::SetUniform, m_RendererID, sizeof(int));
+	}
+
+	void NullShader::SetFloat(std::string_view name, float value)
+	{
+		NullCommandLog::Record(NullCommandType::SetUniform, m_RendererID, sizeof(float));
+	}
+
+	void NullShader::SetFloat3(std::string_view name, const glm::vec3& value)
+	{
+		NullCommandLog::Record(NullCommandType::SetUniform, m_RendererID, sizeof(glm::vec3));
+	}
+
+	void NullShader::SetFloat4(std::string_view name, const glm::vec4& value)
+	{
+		NullCommandLog::Record(NullCommandType::SetUniform, m_RendererID, sizeof(glm::vec4));
+	}
+
+	void NullShader::SetMat4(std::string_view name, const glm::mat4& value)
+	{
+		NullCommandLog::Record(NullCommandType::SetUniform, m_RendererID, sizeof(glm::mat4));
+	}
+}
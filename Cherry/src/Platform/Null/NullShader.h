@@ -0,0 +1,37 @@
+#pragma once
+#include "Cherry/Renderer/Shader.h"
+
+namespace Cherry {
+
+	class NullShader : public Shader
+	{
+	public:
+		// Missing sources are tolerated, so renderer code runs on machines without the asset tree
+		NullShader(const std::string& filepath);
+		NullShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		virtual ~NullShader();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override {}
+
+		virtual void SetInt(std::string_view name, int value) override;
+		virtual void SetFloat(std::string_view name, float value) override;
+		virtual void SetFloat3(std::string_view name, const glm::vec3& value) override;
+		virtual void SetFloat4(std::string_view name, const glm::vec4& value) override;
+		virtual void SetMat4(std::string_view name, const glm::mat4& value) override;
+
+		virtual const std::string& GetName() const override { return m_Name; }
+		virtual const ShaderUniformLayout& GetMaterialLayout() const override { return m_MaterialLayout; }
+
+		uint32_t GetRendererID() const { return m_RendererID; }
+
+	private:
+		// Builds the material layout from loose uniform declarations in the source, packed like OpenGLShader does
+		void Reflect(const std::string& source);
+
+	private:
+		uint32_t m_RendererID;
+		std::string m_Name;
+		ShaderUniformLayout m_MaterialLayout;
+	};
+}
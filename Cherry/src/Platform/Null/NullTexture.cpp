@@ -0,0 +1,63 @@
+#include "CHpch.h"
+#include "Platform/Null/NullTexture.h"
+
+#include "Platform/Null/NullCommandLog.h"
+#include "Cherry/Core/VFS.h"
+
+#include "stb_image.h"
+
+namespace Cherry {
+
+	NullTexture2D::NullTexture2D(uint32_t width, uint32_t height)
+	{
+		Create(width, height, 1);
+	}
+
+	NullTexture2D::NullTexture2D(const std::string& path)
+	{
+		CH_PROFILE_FUNCTION();
+
+		int width = 1, height = 1, channels = 0;
+		FileData file = VFS::Read(path);
+		if (!file || !stbi_info_from_memory(file.GetBytes(), (int)file.GetSize(), &width, &height, &channels))
+			CH_CORE_WARN("Null texture '{0}': image not found, using 1x1", path);
+
+		// Same full mip chain the OpenGL backend builds for loaded images
+		uint32_t mipCount = 1;
+		for (uint32_t size = (uint32_t)std::max(width, height); size > 1; size >>= 1)
+			mipCount++;
+
+		Create((uint32_t)width, (uint32_t)height, mipCount);
+		NullCommandLog::Record(NullCommandType::UploadTexture, m_RendererID, (uint32_t)std::min<uint64_t>(m_MemorySize, UINT32_MAX));
+	}
+
+	NullTexture2D::~NullTexture2D()
+	{
+		NullCommandLog::OnDestroy(NullResourceType::Texture, m_MemorySize);
+	}
+
+	void NullTexture2D::Create(uint32_t width, uint32_t height, uint32_t mipCount)
+	{
+		m_Width = width;
+		m_Height = height;
+		m_MipCount = mipCount;
+
+		// Accounted as RGBA8
+		m_MemorySize = 0;
+		for (uint32_t mip = 0; mip < m_MipCount; mip++)
+			m_MemorySize += (uint64_t)std::max(m_Width >> mip, 1u) * std::max(m_Height >> mip, 1u) * 4;
+
+		m_RendererID = NullCommandLog::OnCreate(NullResourceType::Texture, m_MemorySize);
+	}
+
+	void NullTexture2D::SetData(void* data, uint32_t size)
+	{
+		CH_CORE_ASSERT(size == m_Width * m_Height * 4 || size == m_Width * m_Height * 3, "Data must be entire texture!");
+		NullCommandLog::Record(NullCommandType::UploadTexture, m_RendererID, size);
+	}
+
+	void NullTexture2D::Bind(uint32_t slot) const
+	{
+		NullCommandLog::Record(NullCommandType::BindTexture, m_RendererID);
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Cherry/Renderer/Texture.h"
+
+namespace Cherry {
+
+	class NullTexture2D : public Texture2D
+	{
+	public:
+		NullTexture2D(uint32_t width, uint32_t height);
+		// Only the image header is read, for its dimensions; missing files become a 1x1 texture
+		NullTexture2D(const std::string& path);
+		virtual ~NullTexture2D();
+
+		virtual uint32_t GetWidth() const override { return m_Width; }
+		virtual uint32_t GetHeight() const override { return m_Height; }
+
+		virtual void SetData(void* data, uint32_t size) override;
+
+		virtual void Bind(uint32_t slot = 0) const override;
+
+		virtual void SetFilter(TextureFilter filter, float maxAnisotropy = 16.0f) override { m_Filter = filter; }
+		virtual TextureFilter GetFilter() const override { return m_Filter; }
+
+		virtual uint32_t GetMipCount() const override { return m_MipCount; }
+		virtual uint64_t GetMemorySize() const override { return m_MemorySize; }
+
+		uint32_t GetRendererID() const { return m_RendererID; }
+
+	private:
+		void Create(uint32_t width, uint32_t height, uint32_t mipCount);
+
+	private:
+		uint32_t m_RendererID = 0;
+		uint32_t m_Width = 1, m_Height = 1;
+		uint32_t m_MipCount = 1;
+		uint64_t m_MemorySize = 0;
+		TextureFilter m_Filter = TextureFilter::Trilinear;
+	};
+}
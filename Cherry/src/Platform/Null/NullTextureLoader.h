@@ -0,0 +1,14 @@
+#pragma once
+#include "Cherry/Renderer/TextureLoader.h"
+
+namespace Cherry {
+
+	// Loads synchronously: there is no upload to hide, and results stay deterministic
+	class NullTextureLoader : public TextureLoader
+	{
+	protected:
+		virtual REF(Texture2D) LoadAsyncImpl(const std::string& path) override { return Texture2D::CreateUncached(path); }
+		virtual void ProcessUploadsImpl() override {}
+		virtual uint32_t GetPendingCountImpl() const override { return 0; }
+	};
+}
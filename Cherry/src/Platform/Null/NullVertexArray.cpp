@@ -0,0 +1,28 @@
+#include "CHpch.h"
+#include "Platform/Null/NullVertexArray.h"
+
+#include "Platform/Null/NullCommandLog.h"
+
+namespace Cherry {
+
+	NullVertexArray::NullVertexArray()
+	{
+		m_RendererID = NullCommandLog::OnCreate(NullResourceType::VertexArray);
+	}
+
+	NullVertexArray::~NullVertexArray()
+	{
+		NullCommandLog::OnDestroy(NullResourceType::VertexArray);
+	}
+
+	void NullVertexArray::Bind() const
+	{
+		NullCommandLog::Record(NullCommandType::BindVertexArray, m_RendererID);
+	}
+
+	void NullVertexArray::AddVertexBuffer(const REF(VertexBuffer)& vertexBuffer)
+	{
+		CH_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+}
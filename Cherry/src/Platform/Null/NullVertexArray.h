@@ -0,0 +1,29 @@
+#pragma once
+#include "Cherry/Renderer/VertexArray.h"
+
+namespace Cherry {
+
+	class NullVertexArray : public VertexArray
+	{
+	public:
+		NullVertexArray();
+		virtual ~NullVertexArray();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override {}
+
+		virtual void AddVertexBuffer(const REF(VertexBuffer)& vertexBuffer) override;
+		virtual void SetIndexBuffer(const REF(IndexBuffer)& indexBuffer) override { m_IndexBuffer = indexBuffer; }
+
+		virtual const std::vector<REF(VertexBuffer)>& GetVertexBuffers() const override { return m_VertexBuffers; }
+		virtual const REF(IndexBuffer)& GetIndexBuffers() const override { return m_IndexBuffer; }
+
+		uint32_t GetRendererID() const { return m_RendererID; }
+
+	private:
+		std::vector<REF(VertexBuffer)> m_VertexBuffers;
+		REF(IndexBuffer) m_IndexBuffer;
+
+		uint32_t m_RendererID;
+	};
+}
@@ -0,0 +1,328 @@
+#include "CHpch.h"
+#include "OpenGLFramebuffer.h"
+
+#include <glad/glad.h>
+
+namespace Cherry {
+
+	static constexpr uint32_t s_MaxFramebufferSize = 8192;
+
+	static bool IsDepthFormat(FramebufferTextureFormat format)
+	{
+		return format == FramebufferTextureFormat::DEPTH24STENCIL8;
+	}
+
+	static GLenum ToGLInternalFormat(FramebufferTextureFormat format)
+	{
+		switch (format)
+		{
+			case FramebufferTextureFormat::RGBA8:           return GL_RGBA8;
+			case FramebufferTextureFormat::RGBA16F:         return GL_RGBA16F;
+			case FramebufferTextureFormat::RED_INTEGER:     return GL_R32I;
+			case FramebufferTextureFormat::DEPTH24STENCIL8: return GL_DEPTH24_STENCIL8;
+			case FramebufferTextureFormat::None:            CH_CORE_ASSERT(false, "Attachment has no format!"); return 0;
+		}
+
+		CH_CORE_ASSERT(false, "Unknown FramebufferTextureFormat!");
+		return 0;
+	}
+
+	// Client-side layout of a color attachment when read back
+	static void GetReadFormat(FramebufferTextureFormat format, GLenum& dataFormat, GLenum& type, uint32_t& bytesPerPixel)
+	{
+		switch (format)
+		{
+			case FramebufferTextureFormat::RGBA8:       dataFormat = GL_RGBA;        type = GL_UNSIGNED_BYTE; bytesPerPixel = 4; return;
+			case FramebufferTextureFormat::RGBA16F:     dataFormat = GL_RGBA;        type = GL_HALF_FLOAT;    bytesPerPixel = 8; return;
+			case FramebufferTextureFormat::RED_INTEGER: dataFormat = GL_RED_INTEGER; type = GL_INT;           bytesPerPixel = 4; return;
+			case FramebufferTextureFormat::DEPTH24STENCIL8:
+			case FramebufferTextureFormat::None:
+				break;
+		}
+
+		CH_CORE_ASSERT(false, "Attachment format cannot be read back!");
+		dataFormat = 0;
+		type = 0;
+		bytesPerPixel = 0;
+	}
+
+	static uint32_t CreateAttachmentTexture(FramebufferTextureFormat format, uint32_t width, uint32_t height, uint32_t samples)
+	{
+		uint32_t id;
+		if (samples > 1)
+		{
+			glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &id);
+			glTextureStorage2DMultisample(id, samples, ToGLInternalFormat(format), width, height, GL_FALSE);
+			return id;
+		}
+
+		glCreateTextures(GL_TEXTURE_2D, 1, &id);
+		glTextureStorage2D(id, 1, ToGLInternalFormat(format), width, height);
+
+		// Integer textures cannot be filtered
+		GLenum filter = format == FramebufferTextureFormat::RED_INTEGER ? GL_NEAREST : GL_LINEAR;
+		glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, filter);
+		glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, filter);
+		glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		return id;
+	}
+
+	static void SetDrawBuffers(uint32_t framebuffer, uint32_t colorCount)
+	{
+		if (colorCount == 0)
+		{
+			// Depth only
+			glNamedFramebufferDrawBuffer(framebuffer, GL_NONE);
+			return;
+		}
+
+		std::vector<GLenum> buffers(colorCount);
+		for (uint32_t i = 0; i < colorCount; i++)
+			buffers[i] = GL_COLOR_ATTACHMENT0 + i;
+		glNamedFramebufferDrawBuffers(framebuffer, (GLsizei)colorCount, buffers.data());
+	}
+
+	OpenGLFramebuffer::OpenGLFramebuffer(const FramebufferSpecification& spec)
+		: m_Specification(spec)
+	{
+		CH_PROFILE_FUNCTION();
+
+		for (auto format : m_Specification.Attachments)
+		{
+			if (IsDepthFormat(format))
+			{
+				CH_CORE_ASSERT(m_DepthAttachmentFormat == FramebufferTextureFormat::None, "Framebuffer supports a single depth attachment!");
+				m_DepthAttachmentFormat = format;
+			}
+			else
+				m_ColorAttachmentFormats.push_back(format);
+		}
+
+		Invalidate();
+	}
+
+	OpenGLFramebuffer::~OpenGLFramebuffer()
+	{
+		CH_PROFILE_FUNCTION();
+
+		Release();
+
+		for (auto& readback : m_ReadbackBuffers)
+		{
+			if (readback.Fence)
+				glDeleteSync(readback.Fence);
+			if (readback.RendererID)
+				glDeleteBuffers(1, &readback.RendererID);
+		}
+	}
+
+	void OpenGLFramebuffer::Invalidate()
+	{
+		CH_PROFILE_FUNCTION();
+
+		if (m_RendererID)
+			Release();
+
+		uint32_t width = m_Specification.Width, height = m_Specification.Height;
+		uint32_t samples = std::max(m_Specification.Samples, 1u);
+
+		glCreateFramebuffers(1, &m_RendererID);
+
+		m_ColorAttachments.resize(m_ColorAttachmentFormats.size());
+		for (size_t i = 0; i < m_ColorAttachmentFormats.size(); i++)
+		{
+			m_ColorAttachments[i] = CreateAttachmentTexture(m_ColorAttachmentFormats[i], width, height, samples);
+			glNamedFramebufferTexture(m_RendererID, GL_COLOR_ATTACHMENT0 + (GLenum)i, m_ColorAttachments[i], 0);
+		}
+
+		if (m_DepthAttachmentFormat != FramebufferTextureFormat::None)
+		{
+			m_DepthAttachment = CreateAttachmentTexture(m_DepthAttachmentFormat, width, height, samples);
+			glNamedFramebufferTexture(m_RendererID, GL_DEPTH_STENCIL_ATTACHMENT, m_DepthAttachment, 0);
+		}
+
+		SetDrawBuffers(m_RendererID, (uint32_t)m_ColorAttachments.size());
+		CH_CORE_ASSERT(glCheckNamedFramebufferStatus(m_RendererID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
+
+		// Multisampled textures cannot be sampled like regular ones, keep a resolved copy of every color attachment
+		if (samples > 1 && !m_ColorAttachments.empty())
+		{
+			glCreateFramebuffers(1, &m_ResolveRendererID);
+
+			m_ResolvedAttachments.resize(m_ColorAttachmentFormats.size());
+			for (size_t i = 0; i < m_ColorAttachmentFormats.size(); i++)
+			{
+				m_ResolvedAttachments[i] = CreateAttachmentTexture(m_ColorAttachmentFormats[i], width, height, 1);
+				glNamedFramebufferTexture(m_ResolveRendererID, GL_COLOR_ATTACHMENT0 + (GLenum)i, m_ResolvedAttachments[i], 0);
+			}
+
+			CH_CORE_ASSERT(glCheckNamedFramebufferStatus(m_ResolveRendererID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Resolve framebuffer is incomplete!");
+		}
+	}
+
+	void OpenGLFramebuffer::Release()
+	{
+		glDeleteFramebuffers(1, &m_RendererID);
+		glDeleteTextures((GLsizei)m_ColorAttachments.size(), m_ColorAttachments.data());
+		glDeleteTextures(1, &m_DepthAttachment);
+		m_RendererID = 0;
+		m_ColorAttachments.clear();
+		m_DepthAttachment = 0;
+
+		if (m_ResolveRendererID)
+		{
+			glDeleteFramebuffers(1, &m_ResolveRendererID);
+			glDeleteTextures((GLsizei)m_ResolvedAttachments.size(), m_ResolvedAttachments.data());
+			m_ResolveRendererID = 0;
+			m_ResolvedAttachments.clear();
+		}
+	}
+
+	void OpenGLFramebuffer::Bind()
+	{
+		glGetIntegerv(GL_VIEWPORT, m_PreviousViewport);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+		glViewport(0, 0, m_Specification.Width, m_Specification.Height);
+	}
+
+	void OpenGLFramebuffer::Unbind()
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(m_PreviousViewport[0], m_PreviousViewport[1], m_PreviousViewport[2], m_PreviousViewport[3]);
+
+		Resolve();
+	}
+
+	void OpenGLFramebuffer::Resize(uint32_t width, uint32_t height)
+	{
+		if (width == 0 || height == 0 || width > s_MaxFramebufferSize || height > s_MaxFramebufferSize)
+		{
+			CH_CORE_WARN("Attempted to resize framebuffer to {0}, {1}", width, height);
+			return;
+		}
+
+		if (width == m_Specification.Width && height == m_Specification.Height)
+			return;
+
+		// Readbacks already queued keep copying from the old textures, GL frees them once the copies are done
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+		Invalidate();
+	}
+
+	void OpenGLFramebuffer::Resolve()
+	{
+		if (!m_ResolveRendererID)
+			return;
+
+		CH_PROFILE_FUNCTION();
+
+		uint32_t width = m_Specification.Width, height = m_Specification.Height;
+		for (size_t i = 0; i < m_ColorAttachments.size(); i++)
+		{
+			// Blits copy one buffer at a time, integer formats require nearest filtering
+			glNamedFramebufferReadBuffer(m_RendererID, GL_COLOR_ATTACHMENT0 + (GLenum)i);
+			glNamedFramebufferDrawBuffer(m_ResolveRendererID, GL_COLOR_ATTACHMENT0 + (GLenum)i);
+			glBlitNamedFramebuffer(m_RendererID, m_ResolveRendererID, 0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		}
+	}
+
+	void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
+	{
+		CH_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Framebuffer attachment index out of range!");
+		CH_CORE_ASSERT(m_ColorAttachmentFormats[attachmentIndex] == FramebufferTextureFormat::RED_INTEGER, "Attachment is not an integer format!");
+
+		glClearNamedFramebufferiv(m_RendererID, GL_COLOR, (GLint)attachmentIndex, &value);
+	}
+
+	int OpenGLFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
+	{
+		CH_PROFILE_FUNCTION();
+
+		CH_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Framebuffer attachment index out of range!");
+		CH_CORE_ASSERT(m_ColorAttachmentFormats[attachmentIndex] == FramebufferTextureFormat::RED_INTEGER, "Attachment is not an integer format!");
+
+		int value = 0;
+		glGetTextureSubImage(GetColorAttachmentRendererID(attachmentIndex), 0, x, y, 0, 1, 1, 1, GL_RED_INTEGER, GL_INT, sizeof(int), &value);
+		return value;
+	}
+
+	bool OpenGLFramebuffer::ReadPixelsAsync(uint32_t attachmentIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+		const FramebufferReadbackCallback& callback)
+	{
+		CH_PROFILE_FUNCTION();
+
+		CH_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Framebuffer attachment index out of range!");
+		CH_CORE_ASSERT(x + width <= m_Specification.Width && y + height <= m_Specification.Height, "Readback region out of bounds!");
+
+		ReadbackBuffer& readback = m_ReadbackBuffers[m_ReadbackIndex];
+		if (readback.Fence)
+			return false;
+
+		GLenum dataFormat, type;
+		uint32_t bytesPerPixel;
+		GetReadFormat(m_ColorAttachmentFormats[attachmentIndex], dataFormat, type, bytesPerPixel);
+		uint32_t size = width * height * bytesPerPixel;
+
+		if (size > readback.Capacity)
+		{
+			if (readback.RendererID)
+				glDeleteBuffers(1, &readback.RendererID);
+
+			// Persistent coherent mapping: once the fence signals the pixels are visible without another map call
+			GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glCreateBuffers(1, &readback.RendererID);
+			glNamedBufferStorage(readback.RendererID, size, nullptr, flags);
+			readback.Mapped = (const uint8_t*)glMapNamedBufferRange(readback.RendererID, 0, size, flags);
+			readback.Capacity = size;
+		}
+
+		// The copy into the pack buffer is queued like any other command, nothing waits on it here
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.RendererID);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glGetTextureSubImage(GetColorAttachmentRendererID(attachmentIndex), 0, x, y, 0, width, height, 1, dataFormat, type, size, nullptr);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		readback.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		readback.Width = width;
+		readback.Height = height;
+		readback.Callback = callback;
+
+		m_ReadbackIndex = (m_ReadbackIndex + 1) % s_ReadbackBufferCount;
+		m_PendingReadbacks++;
+		return true;
+	}
+
+	void OpenGLFramebuffer::ProcessReadbacks()
+	{
+		CH_PROFILE_FUNCTION();
+
+		while (m_PendingReadbacks > 0)
+		{
+			uint32_t oldest = (m_ReadbackIndex + s_ReadbackBufferCount - m_PendingReadbacks) % s_ReadbackBufferCount;
+			ReadbackBuffer& readback = m_ReadbackBuffers[oldest];
+
+			// Zero timeout never blocks; the flush makes sure the fence actually reaches the GPU
+			GLenum status = glClientWaitSync(readback.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			if (status == GL_TIMEOUT_EXPIRED)
+				return;
+
+			glDeleteSync(readback.Fence);
+			readback.Fence = nullptr;
+			m_PendingReadbacks--;
+
+			if (status != GL_WAIT_FAILED && readback.Callback)
+				readback.Callback(readback.Mapped, readback.Width, readback.Height);
+			readback.Callback = nullptr;
+		}
+	}
+
+	uint32_t OpenGLFramebuffer::GetColorAttachmentRendererID(uint32_t index) const
+	{
+		CH_CORE_ASSERT(index < m_ColorAttachments.size(), "Framebuffer attachment index out of range!");
+		return m_ResolveRendererID ? m_ResolvedAttachments[index] : m_ColorAttachments[index];
+	}
+}
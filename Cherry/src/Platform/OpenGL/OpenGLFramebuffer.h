@@ -0,0 +1,72 @@
+#pragma once
+#include "Cherry/Renderer/Framebuffer.h"
+
+#include <array>
+
+typedef struct __GLsync* GLsync;
+
+namespace Cherry {
+
+	class OpenGLFramebuffer : public Framebuffer
+	{
+	public:
+		OpenGLFramebuffer(const FramebufferSpecification& spec);
+		virtual ~OpenGLFramebuffer();
+
+		virtual void Bind() override;
+		virtual void Unbind() override;
+
+		virtual void Resize(uint32_t width, uint32_t height) override;
+		virtual void Resolve() override;
+
+		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
+		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+
+		virtual bool ReadPixelsAsync(uint32_t attachmentIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+			const FramebufferReadbackCallback& callback) override;
+		virtual void ProcessReadbacks() override;
+		virtual uint32_t GetPendingReadbackCount() const override { return m_PendingReadbacks; }
+
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override;
+
+		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+
+	private:
+		// (Re)creates the framebuffers and every attachment from the specification
+		void Invalidate();
+		void Release();
+
+	private:
+		// Pack buffers are used round-robin and delivered in submission order, each fenced after its copy
+		struct ReadbackBuffer
+		{
+			uint32_t RendererID = 0;
+			const uint8_t* Mapped = nullptr;
+			uint32_t Capacity = 0;
+			GLsync Fence = nullptr;
+			uint32_t Width = 0, Height = 0;
+			FramebufferReadbackCallback Callback;
+		};
+
+		static constexpr uint32_t s_ReadbackBufferCount = 3;
+
+		FramebufferSpecification m_Specification;
+
+		uint32_t m_RendererID = 0;
+		// Single-sampled copy of the color attachments, only when multisampled
+		uint32_t m_ResolveRendererID = 0;
+
+		std::vector<FramebufferTextureFormat> m_ColorAttachmentFormats;
+		FramebufferTextureFormat m_DepthAttachmentFormat = FramebufferTextureFormat::None;
+
+		std::vector<uint32_t> m_ColorAttachments;
+		std::vector<uint32_t> m_ResolvedAttachments;
+		uint32_t m_DepthAttachment = 0;
+
+		int m_PreviousViewport[4] = { 0, 0, 0, 0 };
+
+		std::array<ReadbackBuffer, s_ReadbackBufferCount> m_ReadbackBuffers;
+		uint32_t m_ReadbackIndex = 0;
+		uint32_t m_PendingReadbacks = 0;
+	};
+}
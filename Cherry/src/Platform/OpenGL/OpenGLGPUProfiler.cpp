@@ -0,0 +1,144 @@
+#include "CHpch.h"
+#include "Platform/OpenGL/OpenGLGPUProfiler.h"
+
+#include <glad/glad.h>
+
+namespace Cherry {
+
+	OpenGLGPUProfiler::OpenGLGPUProfiler()
+	{
+		CH_PROFILE_FUNCTION();
+
+		Calibrate();
+	}
+
+	OpenGLGPUProfiler::~OpenGLGPUProfiler()
+	{
+		CH_PROFILE_FUNCTION();
+
+		// Whatever is still in flight is not worth a stall at shutdown
+		for (const auto& frame : m_PendingFrames)
+			ReleaseQueries(frame);
+		ReleaseQueries(m_CurrentFrame);
+
+		if (!m_FreeQueries.empty())
+			glDeleteQueries((GLsizei)m_FreeQueries.size(), m_FreeQueries.data());
+	}
+
+	uint32_t OpenGLGPUProfiler::BeginScopeImpl(const char* name)
+	{
+		uint32_t query = AcquireQuery();
+		glQueryCounter(query, GL_TIMESTAMP);
+
+		m_CurrentFrame.Scopes.push_back({ name, query, 0 });
+		return (uint32_t)m_CurrentFrame.Scopes.size() - 1;
+	}
+
+	void OpenGLGPUProfiler::EndScopeImpl(uint32_t scope)
+	{
+		uint32_t query = AcquireQuery();
+		glQueryCounter(query, GL_TIMESTAMP);
+
+		m_CurrentFrame.Scopes[scope].EndQuery = query;
+	}
+
+	void OpenGLGPUProfiler::BeginFrameImpl()
+	{
+		CH_PROFILE_FUNCTION();
+
+		if (!m_CurrentFrame.Scopes.empty())
+		{
+			m_PendingFrames.push_back(std::move(m_CurrentFrame));
+			m_CurrentFrame.Scopes.clear();
+		}
+
+		while (!m_PendingFrames.empty())
+		{
+			Frame& oldest = m_PendingFrames.front();
+			if (IsFrameReady(oldest))
+				EmitFrame(oldest);
+			else if (m_PendingFrames.size() <= s_MaxPendingFrames)
+				break;
+			else
+				CH_CORE_WARN("GPUProfiler: GPU is more than {0} frames behind, dropping a frame of timings", s_MaxPendingFrames);
+
+			ReleaseQueries(oldest);
+			m_PendingFrames.pop_front();
+		}
+
+		if (++m_FramesSinceCalibration >= s_CalibrationInterval)
+			Calibrate();
+	}
+
+	uint32_t OpenGLGPUProfiler::AcquireQuery()
+	{
+		if (m_FreeQueries.empty())
+		{
+			// Grown in batches; a frame's worth of scopes usually fits in one
+			m_FreeQueries.resize(64);
+			glGenQueries((GLsizei)m_FreeQueries.size(), m_FreeQueries.data());
+		}
+
+		uint32_t query = m_FreeQueries.back();
+		m_FreeQueries.pop_back();
+		return query;
+	}
+
+	void OpenGLGPUProfiler::ReleaseQueries(const Frame& frame)
+	{
+		for (const auto& scope : frame.Scopes)
+		{
+			m_FreeQueries.push_back(scope.StartQuery);
+			if (scope.EndQuery)
+				m_FreeQueries.push_back(scope.EndQuery);
+		}
+	}
+
+	bool OpenGLGPUProfiler::IsFrameReady(const Frame& frame) const
+	{
+		for (const auto& scope : frame.Scopes)
+		{
+			GLuint available = GL_FALSE;
+			glGetQueryObjectuiv(scope.EndQuery ? scope.EndQuery : scope.StartQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return false;
+		}
+		return true;
+	}
+
+	void OpenGLGPUProfiler::EmitFrame(const Frame& frame)
+	{
+		CH_PROFILE_FUNCTION();
+
+		if (!Instrumentor::Get().IsSessionActive())
+			return;
+
+		for (const auto& scope : frame.Scopes)
+		{
+			// A scope still open at the end of its frame has nothing to report
+			if (!scope.EndQuery)
+				continue;
+
+			GLuint64 start = 0, end = 0;
+			glGetQueryObjectui64v(scope.StartQuery, GL_QUERY_RESULT, &start);
+			glGetQueryObjectui64v(scope.EndQuery, GL_QUERY_RESULT, &end);
+
+			uint64_t startTicks = ProfileClock::FromNanoseconds((int64_t)start + m_ClockOffset);
+			uint64_t endTicks = ProfileClock::FromNanoseconds((int64_t)end + m_ClockOffset);
+			Instrumentor::Get().WriteProfile(scope.Name, startTicks, endTicks, Instrumentor::GPUThreadID);
+		}
+	}
+
+	void OpenGLGPUProfiler::Calibrate()
+	{
+		CH_PROFILE_FUNCTION();
+
+		// Same clock the Instrumentor stamps CPU scopes with
+		GLint64 gpuTime = 0;
+		glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+		int64_t cpuTime = ProfileClock::ToNanoseconds(ProfileClock::Now());
+
+		m_ClockOffset = cpuTime - gpuTime;
+		m_FramesSinceCalibration = 0;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "Cherry/Renderer/GPUProfiler.h"
+
+#include <deque>
+
+namespace Cherry {
+
+	class OpenGLGPUProfiler : public GPUProfiler
+	{
+	public:
+		OpenGLGPUProfiler();
+		virtual ~OpenGLGPUProfiler();
+
+	protected:
+		virtual uint32_t BeginScopeImpl(const char* name) override;
+		virtual void EndScopeImpl(uint32_t scope) override;
+		virtual void BeginFrameImpl() override;
+
+	private:
+		// A GL_TIMESTAMP query at each end rather than GL_TIME_ELAPSED, which cannot nest
+		struct Scope
+		{
+			const char* Name;
+			uint32_t StartQuery;
+			uint32_t EndQuery;
+		};
+
+		struct Frame
+		{
+			std::vector<Scope> Scopes;
+		};
+
+		uint32_t AcquireQuery();
+		void ReleaseQueries(const Frame& frame);
+		// Only ends of scopes are checked: a scope's start always completes before its end
+		bool IsFrameReady(const Frame& frame) const;
+		void EmitFrame(const Frame& frame);
+		// Re-measures the CPU/GPU clock offset; the two drift apart slowly
+		void Calibrate();
+
+	private:
+		// Beyond this the GPU is hopelessly behind and the oldest results are dropped instead of waited for
+		static constexpr uint32_t s_MaxPendingFrames = 4;
+		static constexpr uint32_t s_CalibrationInterval = 256;
+
+		Frame m_CurrentFrame;
+		std::deque<Frame> m_PendingFrames;	// Oldest first
+		std::vector<uint32_t> m_FreeQueries;
+
+		int64_t m_ClockOffset = 0;	// ProfileClock nanoseconds minus GPU nanoseconds
+		uint32_t m_FramesSinceCalibration = 0;
+	};
+}
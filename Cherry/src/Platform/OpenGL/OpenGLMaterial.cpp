@@ -0,0 +1,98 @@
+#include "CHpch.h"
+#include "Platform/OpenGL/OpenGLMaterial.h"
+#include "Platform/OpenGL/OpenGLShader.h"
+
+#include <glad/glad.h>
+
+namespace Cherry {
+
+	OpenGLMaterial::OpenGLMaterial(const REF(Shader)& shader)
+		: Material(shader)
+	{
+		CH_PROFILE_FUNCTION();
+
+		const auto& layout = m_Shader->GetMaterialLayout();
+		if (layout.IsBufferBacked())
+		{
+			glCreateBuffers(1, &m_UniformBufferID);
+			glNamedBufferStorage(m_UniformBufferID, layout.GetSize(), nullptr, GL_DYNAMIC_STORAGE_BIT);
+		}
+	}
+
+	OpenGLMaterial::~OpenGLMaterial()
+	{
+		CH_PROFILE_FUNCTION();
+
+		if (m_UniformBufferID)
+			glDeleteBuffers(1, &m_UniformBufferID);
+	}
+
+	void OpenGLMaterial::Bind()
+	{
+		CH_PROFILE_FUNCTION();
+
+		const auto& layout = m_Shader->GetMaterialLayout();
+		if (layout.IsBufferBacked())
+		{
+			// Each material owns its block, so switching materials of one shader is a single buffer bind
+			if (m_Dirty)
+				UploadUniformBuffer();
+			glBindBufferBase(GL_UNIFORM_BUFFER, layout.GetBufferBinding(), m_UniformBufferID);
+		}
+		else
+		{
+			// Program state is shared by all materials of this shader, re-upload only when another material
+			// (or none) was the last one applied to it. Every parameter goes up, so values a previous
+			// material set don't leak into this one.
+			auto glShader = static_cast<const OpenGLShader*>(m_Shader.get());
+			if (m_Dirty || glShader->GetBoundMaterialID() != m_ID)
+			{
+				UploadProgramUniforms();
+				glShader->SetBoundMaterialID(m_ID);
+			}
+		}
+
+		for (const auto& [slot, texture] : m_Textures)
+			texture->Bind(slot);
+	}
+
+	void OpenGLMaterial::UploadUniformBuffer()
+	{
+		CH_PROFILE_FUNCTION();
+
+		glNamedBufferSubData(m_UniformBufferID, 0, (GLsizeiptr)m_Data.size(), m_Data.data());
+		m_Dirty = false;
+	}
+
+	void OpenGLMaterial::UploadProgramUniforms()
+	{
+		CH_PROFILE_FUNCTION();
+
+		auto program = static_cast<const OpenGLShader*>(m_Shader.get())->GetRendererID();
+		const auto& uniforms = m_Shader->GetMaterialLayout().GetUniforms();
+		for (uint32_t i = 0; i < (uint32_t)uniforms.size(); i++)
+		{
+			const ShaderUniform& uniform = uniforms[i];
+			if (uniform.Location == -1)
+				continue;
+
+			const void* data = m_Data.data() + uniform.Offset;
+			GLsizei count = (GLsizei)uniform.Count;
+			switch (uniform.Type)
+			{
+			case ShaderDataType::Float:		glProgramUniform1fv(program, uniform.Location, count, (const float*)data); break;
+			case ShaderDataType::Float2:	glProgramUniform2fv(program, uniform.Location, count, (const float*)data); break;
+			case ShaderDataType::Float3:	glProgramUniform3fv(program, uniform.Location, count, (const float*)data); break;
+			case ShaderDataType::Float4:	glProgramUniform4fv(program, uniform.Location, count, (const float*)data); break;
+			case ShaderDataType::Mat3:		glProgramUniformMatrix3fv(program, uniform.Location, count, GL_FALSE, (const float*)data); break;
+			case ShaderDataType::Mat4:		glProgramUniformMatrix4fv(program, uniform.Location, count, GL_FALSE, (const float*)data); break;
+			case ShaderDataType::Int:		glProgramUniform1iv(program, uniform.Location, count, (const int*)data); break;
+			case ShaderDataType::Int2:		glProgramUniform2iv(program, uniform.Location, count, (const int*)data); break;
+			case ShaderDataType::Int3:		glProgramUniform3iv(program, uniform.Location, count, (const int*)data); break;
+			case ShaderDataType::Int4:		glProgramUniform4iv(program, uniform.Location, count, (const int*)data); break;
+			default: break;
+			}
+		}
+		m_Dirty = false;
+	}
+}
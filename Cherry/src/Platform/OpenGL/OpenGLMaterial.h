@@ -0,0 +1,21 @@
+#pragma once
+#include "Cherry/Renderer/Material.h"
+
+namespace Cherry {
+
+	class OpenGLMaterial : public Material
+	{
+	public:
+		OpenGLMaterial(const REF(Shader)& shader);
+		virtual ~OpenGLMaterial();
+
+		virtual void Bind() override;
+
+	private:
+		void UploadUniformBuffer();
+		void UploadProgramUniforms();
+
+	private:
+		uint32_t m_UniformBufferID = 0;
+	};
+}
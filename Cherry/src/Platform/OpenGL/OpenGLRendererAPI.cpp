@@ -28,11 +28,10 @@ namespace Cherry {
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	}
-	void OpenGLRendererAPI::DrawIndexed(const REF(VertexArray)& vertexArray)
+	void OpenGLRendererAPI::DrawIndexed(const VertexArray& vertexArray)
 	{
-		//TODO
-		glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffers()->GetCount(), GL_UNSIGNED_INT, nullptr);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		// Texture bindings are left alone so grouped draws sharing a material/texture bind it once
+		glDrawElements(GL_TRIANGLES, vertexArray.GetIndexBuffers()->GetCount(), GL_UNSIGNED_INT, nullptr);
 	}
 
 	
@@ -12,7 +12,7 @@ namespace Cherry {
 		virtual void SetClearColor(const glm::vec4& color) override;
 		virtual void Clear() override;
 
-		virtual void DrawIndexed(const REF(VertexArray)& vertexArray) override;
+		virtual void DrawIndexed(const VertexArray& vertexArray) override;
 
 	private:
 
@@ -1,13 +1,17 @@
 #include "CHpch.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
-#include <fstream>
+#include "Cherry/Core/VFS.h"
+
 #include <glad/glad.h>
 
 #include <glm/gtc/type_ptr.hpp>
 
 namespace Cherry {
 
+	// Binding point every reflected "Material" uniform block is assigned to
+	static constexpr uint32_t s_MaterialBlockBinding = 1;
+
 	static GLenum ShaderTypeFromString(const std::string& type)
 	{
 		if (type == "vertex")
@@ -19,20 +23,53 @@ namespace Cherry {
 		return 0;
 	}
 
+	static ShaderDataType ShaderDataTypeFromGLType(GLenum type)
+	{
+		switch (type)
+		{
+		case GL_FLOAT:				return ShaderDataType::Float;
+		case GL_FLOAT_VEC2:			return ShaderDataType::Float2;
+		case GL_FLOAT_VEC3:			return ShaderDataType::Float3;
+		case GL_FLOAT_VEC4:			return ShaderDataType::Float4;
+		case GL_FLOAT_MAT3:			return ShaderDataType::Mat3;
+		case GL_FLOAT_MAT4:			return ShaderDataType::Mat4;
+		case GL_INT:				return ShaderDataType::Int;
+		case GL_INT_VEC2:			return ShaderDataType::Int2;
+		case GL_INT_VEC3:			return ShaderDataType::Int3;
+		case GL_INT_VEC4:			return ShaderDataType::Int4;
+		case GL_BOOL:				return ShaderDataType::Int;		// Bools are 4 bytes in program state and in std140
+		case GL_SAMPLER_2D:			return ShaderDataType::Int;
+		}
+		return ShaderDataType::None;
+	}
+
+	// Per-scene/per-draw uniforms owned by the Renderer, never part of a material
+	static bool IsRendererUniform(const std::string& name)
+	{
+		return name == "u_ViewProjection" || name == "u_Transform";
+	}
+
+	// Arrays reflect as "name[0]", materials address them by their base name
+	static std::string StripArraySuffix(const std::string& name)
+	{
+		auto bracket = name.find('[');
+		return bracket == std::string::npos ? name : name.substr(0, bracket);
+	}
+
 	OpenGLShader::OpenGLShader(const std::string& filepath)
 	{
 		CH_PROFILE_FUNCTION();
 
-		std::string source = ReadFile(filepath);
-		auto shaderSources = PreProcess(source);
-		Compile(shaderSources);
-
 		// Extract name from filepath
 		auto lastSlash = filepath.find_last_of("/\\");
 		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
 		auto lastDot = filepath.rfind('.');
 		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
 		m_Name = filepath.substr(lastSlash, count);
+
+		std::string source = ReadFile(filepath);
+		auto shaderSources = PreProcess(source);
+		Compile(shaderSources);
 	}
 
 	OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
@@ -57,31 +94,14 @@ namespace Cherry {
 	{
 		CH_PROFILE_FUNCTION();
 
-		std::string result;
-		std::ifstream in(filepath, std::ios::in | std::ios::binary);
-		if (in)
-		{
-			in.seekg(0, std::ios::end);
-			std::streampos pos = in.tellg();
-			if (pos != std::streampos(-1) && in.good())
-			{
-				size_t size = static_cast<size_t>(pos);
-				result.resize(size);
-				in.seekg(0, std::ios::beg);
-				in.read(&result[0], size);
-				in.close();
-			}
-			else
-			{
-				CH_CORE_ERROR("Could not read from file '{0}'", filepath);
-			}
-		}
-		else
+		FileData file = VFS::Read(filepath);
+		if (!file)
 		{
 			CH_CORE_ERROR("Could not open file '{0}'", filepath);
+			return std::string();
 		}
 
-		return result;
+		return std::string(file.AsString());
 	}
 
 	std::unordered_map<GLenum, std::string> OpenGLShader::PreProcess(const std::string& source)
@@ -185,6 +205,105 @@ namespace Cherry {
 			glDetachShader(program, id);
 			glDeleteShader(id);
 		}
+
+		Reflect();
+	}
+
+	void OpenGLShader::Reflect()
+	{
+		CH_PROFILE_FUNCTION();
+
+		m_UniformLocations.clear();
+		m_MaterialLocations.clear();
+		m_MaterialLayout = ShaderUniformLayout();
+
+		GLint uniformCount = 0;
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &uniformCount);
+		GLint maxNameLength = 0;
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+		std::vector<GLchar> nameBuffer(std::max(maxNameLength, 1));
+
+		// A std140 block named "Material" takes precedence: its layout is the material block byte for byte
+		GLuint blockIndex = glGetUniformBlockIndex(m_RendererID, "Material");
+		if (blockIndex != GL_INVALID_INDEX)
+		{
+			GLint blockSize = 0;
+			glGetActiveUniformBlockiv(m_RendererID, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &blockSize);
+			glUniformBlockBinding(m_RendererID, blockIndex, s_MaterialBlockBinding);
+			m_MaterialLayout.SetBufferBacked(s_MaterialBlockBinding, (uint32_t)blockSize);
+		}
+
+		uint32_t packedOffset = 0;
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			GLuint index = (GLuint)i;
+			GLsizei length = 0;
+			GLint arraySize = 0;
+			GLenum glType = 0;
+			glGetActiveUniform(m_RendererID, index, (GLsizei)nameBuffer.size(), &length, &arraySize, &glType, nameBuffer.data());
+			std::string name = StripArraySuffix(std::string(nameBuffer.data(), length));
+
+			GLint uniformBlock = -1, offset = -1, arrayStride = 0;
+			glGetActiveUniformsiv(m_RendererID, 1, &index, GL_UNIFORM_BLOCK_INDEX, &uniformBlock);
+			glGetActiveUniformsiv(m_RendererID, 1, &index, GL_UNIFORM_OFFSET, &offset);
+			glGetActiveUniformsiv(m_RendererID, 1, &index, GL_UNIFORM_ARRAY_STRIDE, &arrayStride);
+
+			ShaderDataType type = ShaderDataTypeFromGLType(glType);
+			uint32_t elementSize = ShaderDataTypeSize(type);
+			if (type == ShaderDataType::None)
+			{
+				CH_CORE_WARN("Shader '{0}': uniform '{1}' has an unsupported type, skipping", m_Name, name);
+				continue;
+			}
+
+			if (uniformBlock == -1)
+			{
+				GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+				m_UniformLocations[name] = location;
+
+				// Loose uniforms only become material parameters when there is no Material block
+				if (!m_MaterialLayout.IsBufferBacked() && !IsRendererUniform(name))
+				{
+					if (location >= 0)
+					{
+						if ((size_t)location >= m_MaterialLocations.size())
+							m_MaterialLocations.resize(location + 1, false);
+						m_MaterialLocations[location] = true;
+					}
+
+					uint32_t size = elementSize * (uint32_t)arraySize;
+					m_MaterialLayout.Add({ name, type, size, packedOffset, (uint32_t)arraySize, location });
+					packedOffset += (size + 3) & ~3u;
+				}
+			}
+			else if ((GLuint)uniformBlock == blockIndex)
+			{
+				uint32_t size = arraySize > 1 ? (uint32_t)arrayStride * (uint32_t)arraySize : elementSize;
+				m_MaterialLayout.Add({ name, type, size, (uint32_t)offset, (uint32_t)arraySize, -1 });
+			}
+		}
+
+		CH_CORE_TRACE("Shader '{0}': reflected {1} material parameters ({2} bytes{3})", m_Name, m_MaterialLayout.GetCount(),
+			m_MaterialLayout.GetSize(), m_MaterialLayout.IsBufferBacked() ? ", UBO" : "");
+	}
+
+	void OpenGLShader::InvalidateMaterialLocation(int location)
+	{
+		// Setting a material parameter by hand leaves program state out of sync with the last bound material
+		if ((size_t)location < m_MaterialLocations.size() && m_MaterialLocations[location])
+			m_BoundMaterialID = 0;
+	}
+
+	int OpenGLShader::GetUniformLocation(std::string_view name)
+	{
+		auto it = m_UniformLocations.find(name);
+		if (it != m_UniformLocations.end())
+			return it->second;
+
+		// Not active after link: warn once and remember the miss
+		CH_CORE_WARN("Uniform '{0}' not found in shader", name);
+		m_UniformLocations.emplace(name, -1);
+		return -1;
 	}
 
 	void OpenGLShader::Bind() const
@@ -201,115 +320,101 @@ namespace Cherry {
 		glUseProgram(0);
 	}
 
-	void OpenGLShader::SetInt(const std::string& name, int value)
+	void OpenGLShader::SetInt(std::string_view name, int value)
 	{
 		CH_PROFILE_FUNCTION();
 
 		UploadUniformInt(name, value);
 	}
 
-	void OpenGLShader::SetFloat(const std::string& name, float value) 
+	void OpenGLShader::SetFloat(std::string_view name, float value) 
 	{
 		CH_PROFILE_FUNCTION();
 
 		UploadUniformFloat(name, value);
 	}
 
-	void OpenGLShader::SetFloat3(const std::string& name, const glm::vec3& value)
+	void OpenGLShader::SetFloat3(std::string_view name, const glm::vec3& value)
 	{
 		CH_PROFILE_FUNCTION();
 
 		UploadUniformFloat3(name, value);
 	}
 
-	void OpenGLShader::SetFloat4(const std::string& name, const glm::vec4& value)
+	void OpenGLShader::SetFloat4(std::string_view name, const glm::vec4& value)
 	{
 		CH_PROFILE_FUNCTION();
 
 		UploadUniformFloat4(name, value);
 	}
 
-	void OpenGLShader::SetMat4(const std::string& name, const glm::mat4& value)
+	void OpenGLShader::SetMat4(std::string_view name, const glm::mat4& value)
 	{
 		CH_PROFILE_FUNCTION();
 
 		UploadUniformMat4(name, value);
 	}
 
-	void OpenGLShader::UploadUniformInt(const std::string& name, int value)
+	void OpenGLShader::UploadUniformInt(std::string_view name, int value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		if (location == -1)
-		{
-			CH_CORE_WARN("Uniform '{0}' not found in shader", name);
 			return;
-		}
+		InvalidateMaterialLocation(location);
 		glUniform1i(location, value);
 	}
 
-	void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
+	void OpenGLShader::UploadUniformFloat(std::string_view name, float value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		if (location == -1)
-		{
-			CH_CORE_WARN("Uniform '{0}' not found in shader", name);
 			return;
-		}
+		InvalidateMaterialLocation(location);
 		glUniform1f(location, value);
 	}
 
-	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& value)
+	void OpenGLShader::UploadUniformFloat2(std::string_view name, const glm::vec2& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		if (location == -1)
-		{
-			CH_CORE_WARN("Uniform '{0}' not found in shader", name);
 			return;
-		}
+		InvalidateMaterialLocation(location);
 		glUniform2f(location, value.x, value.y);
 	}
 
-	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& value)
+	void OpenGLShader::UploadUniformFloat3(std::string_view name, const glm::vec3& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		if (location == -1)
-		{
-			CH_CORE_WARN("Uniform '{0}' not found in shader", name);
 			return;
-		}
+		InvalidateMaterialLocation(location);
 		glUniform3f(location, value.x, value.y, value.z);
 	}
 
-	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& value)
+	void OpenGLShader::UploadUniformFloat4(std::string_view name, const glm::vec4& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		if (location == -1)
-		{
-			CH_CORE_WARN("Uniform '{0}' not found in shader", name);
 			return;
-		}
+		InvalidateMaterialLocation(location);
 		glUniform4f(location, value.x, value.y, value.z, value.w);
 	}
 
-	void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix)
+	void OpenGLShader::UploadUniformMat3(std::string_view name, const glm::mat3& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		if (location == -1)
-		{
-			CH_CORE_WARN("Uniform '{0}' not found in shader", name);
 			return;
-		}
+		InvalidateMaterialLocation(location);
 		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
-	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix)
+	void OpenGLShader::UploadUniformMat4(std::string_view name, const glm::mat4& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		if (location == -1)
-		{
-			CH_CORE_WARN("Uniform '{0}' not found in shader", name);
 			return;
-		}
+		InvalidateMaterialLocation(location);
 		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
@@ -17,30 +17,53 @@ namespace Cherry {
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
-		virtual void SetInt(const std::string& name, int value) override;
-		virtual void SetFloat(const std::string& name, float value) override;
-		virtual void SetFloat3(const std::string& name, const glm::vec3& value) override;
-		virtual void SetFloat4(const std::string& name, const glm::vec4& value) override;
-		virtual void SetMat4(const std::string& name, const glm::mat4& value) override;
+		virtual void SetInt(std::string_view name, int value) override;
+		virtual void SetFloat(std::string_view name, float value) override;
+		virtual void SetFloat3(std::string_view name, const glm::vec3& value) override;
+		virtual void SetFloat4(std::string_view name, const glm::vec4& value) override;
+		virtual void SetMat4(std::string_view name, const glm::mat4& value) override;
 
 		virtual const std::string& GetName() const override { return m_Name; }
+		virtual const ShaderUniformLayout& GetMaterialLayout() const override { return m_MaterialLayout; }
 
-		void UploadUniformInt(const std::string& name, int value);
+		uint32_t GetRendererID() const { return m_RendererID; }
 
-		void UploadUniformFloat(const std::string& name, float value);
-		void UploadUniformFloat2(const std::string& name, const glm::vec2& value);
-		void UploadUniformFloat3(const std::string& name, const glm::vec3& value);
-		void UploadUniformFloat4(const std::string& name, const glm::vec4& value);
+		// Loose (non-UBO) material parameters live in program state shared by every material of this shader,
+		// so materials record which of them was last uploaded to skip redundant uploads
+		uint32_t GetBoundMaterialID() const { return m_BoundMaterialID; }
+		void SetBoundMaterialID(uint32_t id) const { m_BoundMaterialID = id; }
 
-		void UploadUniformMat3(const std::string& name, const glm::mat3& matrix);
-		void UploadUniformMat4(const std::string& name, const glm::mat4& matrix);
+		void UploadUniformInt(std::string_view name, int value);
+
+		void UploadUniformFloat(std::string_view name, float value);
+		void UploadUniformFloat2(std::string_view name, const glm::vec2& value);
+		void UploadUniformFloat3(std::string_view name, const glm::vec3& value);
+		void UploadUniformFloat4(std::string_view name, const glm::vec4& value);
+
+		void UploadUniformMat3(std::string_view name, const glm::mat3& matrix);
+		void UploadUniformMat4(std::string_view name, const glm::mat4& matrix);
 	private:
 		std::string ReadFile(const std::string& filepath);
 		std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
 		void Compile(const std::unordered_map<GLenum, std::string>& shaderSources);
+		void Reflect();
+
+		int GetUniformLocation(std::string_view name);
+		void InvalidateMaterialLocation(int location);
 	private:
 		uint32_t m_RendererID;
 		std::string m_Name;
+
+		// Transparent lookup, so setters called with string literals do not build a std::string per call
+		struct UniformNameHash
+		{
+			using is_transparent = void;
+			size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+		};
+		std::unordered_map<std::string, int, UniformNameHash, std::equal_to<>> m_UniformLocations;
+		std::vector<bool> m_MaterialLocations;
+		ShaderUniformLayout m_MaterialLayout;
+		mutable uint32_t m_BoundMaterialID = 0;
 	};
 
 }
\ No newline at end of file
@@ -1,10 +1,46 @@
 #include "CHpch.h"
 #include "OpenGLTexture.h"
 
+#include "Cherry/Core/VFS.h"
+
 #include "stb_image.h"
 
+// Not exposed by the loader, which only carries core profile enums
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 
 namespace Cherry {
+
+    static uint32_t CalculateMipCount(uint32_t width, uint32_t height)
+    {
+        uint32_t levels = 1;
+        for (uint32_t size = std::max(width, height); size > 1; size >>= 1)
+            levels++;
+        return levels;
+    }
+
+    // What the driver stores for one level, by internal format: RGB8 is padded to four bytes per texel
+    static uint64_t CalculateLevelSize(GLenum internalFormat, uint32_t width, uint32_t height)
+    {
+        uint64_t blocks = (uint64_t)((width + 3) / 4) * ((height + 3) / 4);
+        switch (internalFormat)
+        {
+            case GL_RGBA8:
+            case GL_RGB8:                          return (uint64_t)width * height * 4;
+            case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT: return blocks * 8;
+            case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            case GL_COMPRESSED_RGBA_BPTC_UNORM:    return blocks * 16;
+        }
+
+        CH_CORE_ASSERT(false, "Unknown texture internal format!");
+        return 0;
+    }
+
 	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
 		:m_Width(width),m_Height(height)
 	{
@@ -14,15 +50,11 @@ namespace Cherry {
        m_InternalFormat = GL_RGBA8;
        m_DataFormat = GL_RGBA;
 
+        // SetData only fills level 0, so no mip chain here
         glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
         glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
 
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
+        ApplyParameters();
 	}
 
     OpenGLTexture2D::OpenGLTexture2D(const std::string& path)
@@ -30,18 +62,97 @@ namespace Cherry {
     {
         CH_PROFILE_FUNCTION();
 
+        if (CookedTexture::HasUpToDateCooked(path) && LoadCooked(CookedTexture::GetCookedPath(path)))
+            return;
+
+        FileData file = VFS::Read(path);
+
         int width, height, channels;
         stbi_set_flip_vertically_on_load(1);
         stbi_uc* data = nullptr;
+        if (file)
         {
             CH_PROFILE_SCOPE("stbi_load - OpenGLTexture2D::OpenGLTexture2D(const std::string&)");
-            data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+            data = stbi_load_from_memory(file.GetBytes(), (int)file.GetSize(), &width, &height, &channels, 0);
 
         }
         CH_CORE_ASSERT(data, "Failed to load image!");
 
+        AllocateStorage(width, height, channels);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        if (m_MipCount > 1)
+            glGenerateTextureMipmap(m_RendererID);
+
+        stbi_image_free(data);
+    }
+
+    bool OpenGLTexture2D::LoadCooked(const std::string& cookedPath)
+    {
+        CH_PROFILE_FUNCTION();
+
+        auto cooked = CREATE_SCOPE(CookedTexture, cookedPath);
+        if (!cooked->IsValid())
+            return false;
+
+        const CookedTextureHeader& header = cooked->GetHeader();
+        switch (header.Format)
+        {
+            case CookedTextureFormat::RGBA8: m_InternalFormat = GL_RGBA8; m_DataFormat = GL_RGBA; break;
+            case CookedTextureFormat::RGB8:  m_InternalFormat = GL_RGB8;  m_DataFormat = GL_RGB;  break;
+            case CookedTextureFormat::BC1:   m_InternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; m_DataFormat = GL_RGBA; break;
+            case CookedTextureFormat::BC3:   m_InternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; m_DataFormat = GL_RGBA; break;
+            case CookedTextureFormat::BC7:   m_InternalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;    m_DataFormat = GL_RGBA; break;
+            default:
+                CH_CORE_ERROR("'{0}' has an unknown texel format", cookedPath);
+                return false;
+        }
+
+        m_Width = header.Width;
+        m_Height = header.Height;
+        m_MipCount = header.MipCount;
+        m_Compressed = CookedTexture::IsCompressed(header.Format);
+
+        // Only mip chains can stream, a single level stays put
+        if (m_MipCount > 1)
+            m_Cooked = std::move(cooked);
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+        glTextureStorage2D(m_RendererID, m_MipCount, m_InternalFormat, m_Width, m_Height);
+        ApplyParameters();
+
+        // No decode: the driver copies straight out of the mapped pages
+        const CookedTexture& source = m_Cooked ? *m_Cooked : *cooked;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (uint32_t level = 0; level < m_MipCount; level++)
+        {
+            const CookedTextureMip& mip = source.GetMip(level);
+            if (m_Compressed)
+                glCompressedTextureSubImage2D(m_RendererID, level, 0, 0, mip.Width, mip.Height, m_InternalFormat, (GLsizei)mip.Size, source.GetMipData(level));
+            else
+                glTextureSubImage2D(m_RendererID, level, 0, 0, mip.Width, mip.Height, m_DataFormat, GL_UNSIGNED_BYTE, source.GetMipData(level));
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        return true;
+    }
+
+    OpenGLTexture2D::OpenGLTexture2D(const std::string& path, const REF(Texture2D)& placeholder)
+        : m_Path(path), m_Width(placeholder->GetWidth()), m_Height(placeholder->GetHeight()),
+          m_Loaded(false), m_Placeholder(placeholder)
+    {
+    }
+
+    void OpenGLTexture2D::AllocateStorage(uint32_t width, uint32_t height, uint32_t channels)
+    {
+        CH_PROFILE_FUNCTION();
+
         m_Width = width;
         m_Height = height;
+        m_MipCount = CalculateMipCount(width, height);
 
         GLenum internalFormat = 0, dataFormat = 0;
         if (channels == 4)
@@ -60,40 +171,149 @@ namespace Cherry {
         CH_CORE_ASSERT(internalFormat != 0 && dataFormat != 0, "Format not supported!");
 
         glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-        glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
+        glTextureStorage2D(m_RendererID, m_MipCount, internalFormat, m_Width, m_Height);
 
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        ApplyParameters();
+    }
 
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    void OpenGLTexture2D::MarkLoaded()
+    {
+        CH_PROFILE_FUNCTION();
 
-        glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
+        if (m_MipCount > 1)
+            glGenerateTextureMipmap(m_RendererID);
 
-        stbi_image_free(data);
+        m_Loaded = true;
+        m_Placeholder.reset();
     }
 
 	OpenGLTexture2D::~OpenGLTexture2D()
 	{
         CH_PROFILE_FUNCTION();
 
-		glDeleteTextures(1, &m_RendererID);
+		if (m_RendererID)
+			glDeleteTextures(1, &m_RendererID);
 	}
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
 	{
         CH_PROFILE_FUNCTION();
 
+        CH_CORE_ASSERT(m_Loaded, "Texture is still loading!");
+        CH_CORE_ASSERT(!m_Compressed, "SetData does not support compressed textures!");
         //Bytes Per Pixel
         uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
         CH_CORE_ASSERT(size == m_Width * m_Height * bpp , "Data Must be Entire Texture!");
         glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+
+        if (m_MipCount > 1)
+            glGenerateTextureMipmap(m_RendererID);
+    }
+
+    void OpenGLTexture2D::SetFilter(TextureFilter filter, float maxAnisotropy)
+    {
+        m_Filter = filter;
+        m_MaxAnisotropy = maxAnisotropy;
+
+        if (m_RendererID)
+            ApplyParameters();
+    }
+
+    void OpenGLTexture2D::ApplyParameters() const
+    {
+        // Mip filters on a single level texture would only cost, fall back to plain linear
+        bool hasMips = m_MipCount - m_ResidentMip > 1;
+        TextureFilter filter = m_Filter;
+        if (!hasMips && (filter == TextureFilter::Trilinear || filter == TextureFilter::Anisotropic))
+            filter = TextureFilter::Linear;
+
+        GLenum minFilter = GL_LINEAR;
+        switch (filter)
+        {
+            case TextureFilter::Nearest:     minFilter = hasMips ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST; break;
+            case TextureFilter::Linear:      minFilter = GL_LINEAR; break;
+            case TextureFilter::Trilinear:
+            case TextureFilter::Anisotropic: minFilter = GL_LINEAR_MIPMAP_LINEAR; break;
+        }
+
+        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        float anisotropy = 1.0f;
+        if (filter == TextureFilter::Anisotropic)
+        {
+            static float s_MaxSupported = 0.0f;
+            if (s_MaxSupported == 0.0f)
+                glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &s_MaxSupported);
+            anisotropy = std::clamp(m_MaxAnisotropy, 1.0f, std::max(1.0f, s_MaxSupported));
+        }
+        glTextureParameterf(m_RendererID, GL_TEXTURE_MAX_ANISOTROPY, anisotropy);
+    }
+
+    uint64_t OpenGLTexture2D::GetMemorySize(uint32_t residentMip) const
+    {
+        // Pending async loads have no storage yet
+        if (!m_Cooked && !m_RendererID)
+            return 0;
+
+        uint64_t size = 0;
+        for (uint32_t level = residentMip; level < m_MipCount; level++)
+            size += CalculateLevelSize(m_InternalFormat, std::max(1u, m_Width >> level), std::max(1u, m_Height >> level));
+        return size;
+    }
+
+    void OpenGLTexture2D::SetResidentMip(uint32_t mip)
+    {
+        CH_PROFILE_FUNCTION();
+
+        CH_CORE_ASSERT(m_Cooked, "Only cooked textures with a mip chain can stream!");
+        mip = std::min(mip, m_MipCount - 1);
+        if (mip == m_ResidentMip)
+            return;
+
+        // Immutable storage can't shrink in place: build a texture holding only [mip, last] and swap it in.
+        // Levels both textures share are copied on the GPU, newly needed fine levels come from the mapping.
+        const CookedTextureMip& top = m_Cooked->GetMip(mip);
+        uint32_t levelCount = m_MipCount - mip;
+
+        uint32_t rendererID = 0;
+        glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+        glTextureStorage2D(rendererID, levelCount, m_InternalFormat, top.Width, top.Height);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (uint32_t level = mip; level < m_MipCount; level++)
+        {
+            const CookedTextureMip& source = m_Cooked->GetMip(level);
+            if (level >= m_ResidentMip)
+            {
+                glCopyImageSubData(m_RendererID, GL_TEXTURE_2D, level - m_ResidentMip, 0, 0, 0,
+                    rendererID, GL_TEXTURE_2D, level - mip, 0, 0, 0, source.Width, source.Height, 1);
+            }
+            else if (m_Compressed)
+                glCompressedTextureSubImage2D(rendererID, level - mip, 0, 0, source.Width, source.Height, m_InternalFormat, (GLsizei)source.Size, m_Cooked->GetMipData(level));
+            else
+                glTextureSubImage2D(rendererID, level - mip, 0, 0, source.Width, source.Height, m_DataFormat, GL_UNSIGNED_BYTE, m_Cooked->GetMipData(level));
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        glDeleteTextures(1, &m_RendererID);
+        m_RendererID = rendererID;
+        m_ResidentMip = mip;
+        ApplyParameters();
     }
 
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
         CH_PROFILE_FUNCTION();
 
+        if (!m_Loaded)
+        {
+            m_Placeholder->Bind(slot);
+            return;
+        }
 		glBindTextureUnit(slot, m_RendererID);
 	}
-}
\ No newline at end of file
+}
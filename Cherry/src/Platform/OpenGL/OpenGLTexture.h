@@ -1,6 +1,7 @@
 #pragma once
 #include "OpenGLShader.h"
 #include "Cherry/Renderer/Texture.h"
+#include "Cherry/Renderer/CookedTexture.h"
 #include <glad/glad.h>
 
 
@@ -10,6 +11,8 @@ namespace Cherry {
 	public:
 		OpenGLTexture2D(uint32_t width, uint32_t height);
 		OpenGLTexture2D(const std::string& path);
+		// Asynchronous load: binds the placeholder until OpenGLTextureLoader completes the upload
+		OpenGLTexture2D(const std::string& path, const REF(Texture2D)& placeholder);
 		virtual ~OpenGLTexture2D();
 
 		virtual uint32_t GetWidth() const override { return m_Width; }
@@ -19,10 +22,47 @@ namespace Cherry {
 
 
 		virtual void Bind(uint32_t slot = 0) const override;
+		virtual bool IsLoaded() const override { return m_Loaded; }
+
+		virtual void SetFilter(TextureFilter filter, float maxAnisotropy = 16.0f) override;
+		virtual TextureFilter GetFilter() const override { return m_Filter; }
+
+		virtual uint32_t GetMipCount() const override { return m_MipCount; }
+		virtual uint64_t GetMemorySize() const override { return GetMemorySize(m_ResidentMip); }
+
+		virtual bool IsStreamable() const override { return m_Cooked != nullptr; }
+		virtual uint32_t GetResidentMip() const override { return m_ResidentMip; }
+		virtual void SetResidentMip(uint32_t mip) override;
+		virtual uint64_t GetMemorySize(uint32_t residentMip) const override;
+
+		const std::string& GetPath() const { return m_Path; }
+		uint32_t GetRendererID() const { return m_RendererID; }
+		GLenum GetDataFormat() const { return m_DataFormat; }
+
+		// Creates the immutable storage for an image with the given channel count (3 or 4), full mip chain included
+		void AllocateStorage(uint32_t width, uint32_t height, uint32_t channels);
+		// Level 0 is uploaded: builds the remaining mips and swaps out the placeholder
+		void MarkLoaded();
+	private:
+		// Maps a .chtex and uploads every mip straight from the mapping, false if it is missing or invalid
+		bool LoadCooked(const std::string& cookedPath);
+		void ApplyParameters() const;
 	private:
 		std::string m_Path;
-		uint32_t m_Width, m_Height;
-		uint32_t m_RendererID;
-		GLenum m_InternalFormat, m_DataFormat;
+		uint32_t m_Width = 0, m_Height = 0;
+		uint32_t m_RendererID = 0;
+		GLenum m_InternalFormat = 0, m_DataFormat = 0;
+		uint32_t m_MipCount = 1;
+		bool m_Compressed = false;
+
+		TextureFilter m_Filter = TextureFilter::Trilinear;
+		float m_MaxAnisotropy = 16.0f;
+
+		// Cooked textures keep their mapping open so dropped mips can be restored
+		SCOPE(CookedTexture) m_Cooked;
+		uint32_t m_ResidentMip = 0;
+
+		bool m_Loaded = true;
+		REF(Texture2D) m_Placeholder;
 	};
-}
\ No newline at end of file
+}
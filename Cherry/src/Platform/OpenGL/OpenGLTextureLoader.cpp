@@ -0,0 +1,245 @@
+#include "CHpch.h"
+#include "Platform/OpenGL/OpenGLTextureLoader.h"
+
+#include "Cherry/Core/Application.h"
+#include "Cherry/Core/FrameAllocator.h"
+#include "Cherry/Core/VFS.h"
+#include "Cherry/Renderer/CookedTexture.h"
+
+#include <glad/glad.h>
+#include "stb_image.h"
+
+namespace Cherry {
+
+	OpenGLTextureLoader::OpenGLTextureLoader()
+	{
+		CH_PROFILE_FUNCTION();
+
+		// The white placeholder every pending texture binds until its pixels arrive
+		m_Placeholder = Texture2D::Create(1, 1);
+		uint32_t whiteTextureData = 0xffffffff;
+		m_Placeholder->SetData(&whiteTextureData, sizeof(uint32_t));
+
+		// stbi's flip flag is global state shared with the synchronous path, which also sets it to 1
+		stbi_set_flip_vertically_on_load(1);
+	}
+
+	OpenGLTextureLoader::~OpenGLTextureLoader()
+	{
+		CH_PROFILE_FUNCTION();
+
+		// Finish the decodes first, they still push into m_Decoded
+		JobSystem::Wait(m_Decodes);
+
+		for (auto& image : m_Decoded)
+			stbi_image_free(image.Pixels);
+		for (auto& image : m_Uploading)
+			stbi_image_free(image.Pixels);
+
+		DestroyStagingBuffers();
+	}
+
+	REF(Texture2D) OpenGLTextureLoader::LoadAsyncImpl(const std::string& path)
+	{
+		CH_PROFILE_FUNCTION();
+
+		// Cooked textures have no decode step to hide, map and upload them right away
+		if (CookedTexture::HasUpToDateCooked(path))
+			return Texture2D::CreateUncached(path);
+
+		auto texture = SmartPointer::CreateRef<OpenGLTexture2D>(path, m_Placeholder);
+		std::weak_ptr<OpenGLTexture2D> weakTexture = texture;
+
+		m_PendingCount++;
+		JobSystem::Run(m_Decodes, [this, weakTexture, path]() { Decode(weakTexture, path); });
+		return texture;
+	}
+
+	void OpenGLTextureLoader::Decode(const std::weak_ptr<OpenGLTexture2D>& texture, const std::string& path)
+	{
+		CH_PROFILE_FUNCTION();
+		HeapAllocationScope heapAllocations;
+
+		// Dropped before a worker got to it
+		if (texture.expired())
+		{
+			m_PendingCount--;
+			return;
+		}
+
+		FileData file = VFS::Read(path);
+
+		int width, height, channels;
+		stbi_uc* data = nullptr;
+		if (file)
+		{
+			CH_PROFILE_SCOPE("stbi_load - OpenGLTextureLoader::Decode");
+			data = stbi_load_from_memory(file.GetBytes(), (int)file.GetSize(), &width, &height, &channels, 0);
+		}
+
+		if (!data || (channels != 3 && channels != 4))
+		{
+			CH_CORE_ERROR("Failed to load image '{0}', keeping placeholder", path);
+			if (data)
+				stbi_image_free(data);
+			m_PendingCount--;
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_DecodedMutex);
+			m_Decoded.push_back({ texture, data, (uint32_t)width, (uint32_t)height, (uint32_t)channels, 0 });
+		}
+		// Wakes an on-demand loop to upload it
+		Application::Get().GetFramePacer().RequestRedraw();
+	}
+
+	void OpenGLTextureLoader::ProcessUploadsImpl()
+	{
+		CH_PROFILE_FUNCTION();
+		// Only does work while textures are loading
+		HeapAllocationScope heapAllocations;
+
+		{
+			std::lock_guard<std::mutex> lock(m_DecodedMutex);
+			for (auto& image : m_Decoded)
+				m_Uploading.push_back(image);
+			m_Decoded.clear();
+		}
+
+		if (m_Uploading.empty())
+			return;
+
+		// Whatever doesn't fit in this frame's budget continues in the next one, so keep frames coming
+		Application::Get().GetFramePacer().RequestRedraw();
+
+		if (m_UploadBudget > m_StagingCapacity)
+		{
+			DestroyStagingBuffers();
+			CreateStagingBuffers(m_UploadBudget);
+		}
+
+		StagingBuffer& staging = m_StagingBuffers[m_StagingIndex];
+		if (staging.Fence)
+		{
+			// Never stall: if the GPU still reads this buffer, stream again next frame
+			GLenum status = glClientWaitSync(staging.Fence, 0, 0);
+			if (status == GL_TIMEOUT_EXPIRED)
+				return;
+
+			glDeleteSync(staging.Fence);
+			staging.Fence = nullptr;
+		}
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.RendererID);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		uint32_t used = 0;
+		for (auto it = m_Uploading.begin(); it != m_Uploading.end() && used < m_UploadBudget; )
+		{
+			auto texture = it->Texture.lock();
+			if (!texture)
+			{
+				stbi_image_free(it->Pixels);
+				it = m_Uploading.erase(it);
+				m_PendingCount--;
+				continue;
+			}
+
+			if (texture->GetRendererID() == 0)
+				texture->AllocateStorage(it->Width, it->Height, it->Channels);
+
+			uint32_t uploaded = UploadRows(*it, staging, used, m_UploadBudget - used);
+			used += uploaded;
+
+			if (it->RowsUploaded < it->Height)
+				break;
+
+			// Commands execute in order, so draws issued after this already sample the new pixels
+			texture->MarkLoaded();
+			stbi_image_free(it->Pixels);
+			it = m_Uploading.erase(it);
+			m_PendingCount--;
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		if (used > 0)
+		{
+			staging.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			m_StagingIndex = (m_StagingIndex + 1) % s_StagingBufferCount;
+		}
+	}
+
+	uint32_t OpenGLTextureLoader::UploadRows(DecodedImage& image, StagingBuffer& staging, uint32_t stagingOffset, uint32_t budget)
+	{
+		uint32_t rowBytes = image.Width * image.Channels;
+		uint32_t rows = std::min(budget / rowBytes, image.Height - image.RowsUploaded);
+		if (rows == 0)
+		{
+			// Continue next frame with a fresh budget, unless a single row is bigger than the whole budget
+			if (stagingOffset != 0)
+				return 0;
+			rows = 1;
+		}
+
+		auto texture = image.Texture.lock();
+		uint32_t bytes = rows * rowBytes;
+		const uint8_t* source = image.Pixels + (size_t)image.RowsUploaded * rowBytes;
+
+		if (stagingOffset + bytes <= m_StagingCapacity)
+		{
+			memcpy(staging.Mapped + stagingOffset, source, bytes);
+			glTextureSubImage2D(texture->GetRendererID(), 0, 0, image.RowsUploaded, image.Width, rows,
+				texture->GetDataFormat(), GL_UNSIGNED_BYTE, (const void*)(uintptr_t)stagingOffset);
+		}
+		else
+		{
+			// Oversized row: upload straight from client memory
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			glTextureSubImage2D(texture->GetRendererID(), 0, 0, image.RowsUploaded, image.Width, rows,
+				texture->GetDataFormat(), GL_UNSIGNED_BYTE, source);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.RendererID);
+		}
+
+		image.RowsUploaded += rows;
+		return bytes;
+	}
+
+	void OpenGLTextureLoader::CreateStagingBuffers(uint32_t capacity)
+	{
+		CH_PROFILE_FUNCTION();
+
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		for (auto& staging : m_StagingBuffers)
+		{
+			glCreateBuffers(1, &staging.RendererID);
+			glNamedBufferStorage(staging.RendererID, capacity, nullptr, flags);
+			staging.Mapped = (uint8_t*)glMapNamedBufferRange(staging.RendererID, 0, capacity, flags);
+		}
+		m_StagingCapacity = capacity;
+		m_StagingIndex = 0;
+	}
+
+	void OpenGLTextureLoader::DestroyStagingBuffers()
+	{
+		CH_PROFILE_FUNCTION();
+
+		for (auto& staging : m_StagingBuffers)
+		{
+			if (staging.Fence)
+			{
+				glClientWaitSync(staging.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+				glDeleteSync(staging.Fence);
+			}
+			if (staging.RendererID)
+			{
+				glUnmapNamedBuffer(staging.RendererID);
+				glDeleteBuffers(1, &staging.RendererID);
+			}
+			staging = StagingBuffer();
+		}
+		m_StagingCapacity = 0;
+	}
+}
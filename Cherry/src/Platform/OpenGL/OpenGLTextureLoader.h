@@ -0,0 +1,63 @@
+#pragma once
+#include "Cherry/Renderer/TextureLoader.h"
+#include "Cherry/Core/JobSystem.h"
+#include "Platform/OpenGL/OpenGLTexture.h"
+
+#include <array>
+#include <mutex>
+
+typedef struct __GLsync* GLsync;
+
+namespace Cherry {
+
+	class OpenGLTextureLoader : public TextureLoader
+	{
+	public:
+		OpenGLTextureLoader();
+		virtual ~OpenGLTextureLoader();
+
+	protected:
+		virtual REF(Texture2D) LoadAsyncImpl(const std::string& path) override;
+		virtual void ProcessUploadsImpl() override;
+		virtual uint32_t GetPendingCountImpl() const override { return m_PendingCount; }
+
+	private:
+		struct DecodedImage
+		{
+			std::weak_ptr<OpenGLTexture2D> Texture;
+			uint8_t* Pixels = nullptr;
+			uint32_t Width = 0, Height = 0, Channels = 0;
+			uint32_t RowsUploaded = 0;
+		};
+
+		// Staging buffers are used round-robin, one per frame in flight, each fenced after its uploads
+		struct StagingBuffer
+		{
+			uint32_t RendererID = 0;
+			uint8_t* Mapped = nullptr;
+			GLsync Fence = nullptr;
+		};
+
+		void Decode(const std::weak_ptr<OpenGLTexture2D>& texture, const std::string& path);
+		void CreateStagingBuffers(uint32_t capacity);
+		void DestroyStagingBuffers();
+
+		// Uploads as many rows of image as fit in the remaining budget, returns bytes consumed
+		uint32_t UploadRows(DecodedImage& image, StagingBuffer& staging, uint32_t stagingOffset, uint32_t budget);
+
+	private:
+		static constexpr uint32_t s_StagingBufferCount = 3;
+
+		REF(Texture2D) m_Placeholder;
+		JobCounter m_Decodes;
+
+		std::mutex m_DecodedMutex;
+		std::vector<DecodedImage> m_Decoded;	// Filled by decode jobs
+		std::vector<DecodedImage> m_Uploading;	// Render thread only
+		std::atomic<uint32_t> m_PendingCount = 0;
+
+		std::array<StagingBuffer, s_StagingBufferCount> m_StagingBuffers;
+		uint32_t m_StagingCapacity = 0;
+		uint32_t m_StagingIndex = 0;
+	};
+}
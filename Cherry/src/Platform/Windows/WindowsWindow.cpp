@@ -84,6 +84,21 @@ namespace Cherry {
 				data.EventCallback(event);
 			});
 
+		glfwSetWindowFocusCallback(m_Window, [](GLFWwindow* window, int focused)
+			{
+				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+				if (focused)
+				{
+					WindowFocusEvent event;
+					data.EventCallback(event);
+				}
+				else
+				{
+					WindowLostFocusEvent event;
+					data.EventCallback(event);
+				}
+			});
+
 		glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
 			{
 				WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
@@ -181,6 +196,12 @@ namespace Cherry {
 		m_Context->SwapBuffers();
 	}
 
+	void WindowsWindow::WaitEvents(double timeoutSeconds)
+	{
+		CH_PROFILE_FUNCTION();
+		glfwWaitEventsTimeout(timeoutSeconds);
+	}
+
 	void WindowsWindow::SetVSync(bool enabled)
 	{
 		CH_PROFILE_FUNCTION();
@@ -12,6 +12,7 @@ namespace Cherry
 		virtual ~WindowsWindow();
 
 		void OnUpdate() override;
+		void WaitEvents(double timeoutSeconds) override;
 		inline unsigned int GetWidth() const override { return m_Data.Width; }
 		inline unsigned int GetHeight() const override { return m_Data.Height; }
 		// Window attributes
@@ -0,0 +1,325 @@
+#include "AssetCooker.h"
+
+#include "AtlasPacker.h"
+#include "ShaderPreprocessor.h"
+
+#include "Cherry/Core/Hash.h"
+#include "Cherry/Core/JobSystem.h"
+#include "Cherry/Core/Log.h"
+#include "Cherry/Core/Pak.h"
+#include "Cherry/Core/VFS.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+
+namespace Cherry {
+
+	// Bump whenever a cooker's output changes for the same input
+	static constexpr uint64_t s_CookVersion = 1;
+
+	static std::string ToLower(std::string string)
+	{
+		std::transform(string.begin(), string.end(), string.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+		return string;
+	}
+
+	// The runtime finds a texture's cooked form by swapping its extension (see CookedTexture::GetCookedPath)
+	static std::string GetCookedTexturePath(const std::string& vfsPath)
+	{
+		return std::filesystem::path(vfsPath).replace_extension(".chtex").generic_string();
+	}
+
+	static bool ReadFile(const std::string& path, std::vector<uint8_t>& data)
+	{
+		std::ifstream in(path, std::ios::in | std::ios::binary);
+		if (!in)
+			return false;
+		data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	static bool WriteFile(const std::string& path, const std::vector<uint8_t>& data)
+	{
+		std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		out.write((const char*)data.data(), data.size());
+		return (bool)out;
+	}
+
+	AssetCooker::AssetCooker(const AssetCookSettings& settings)
+		: m_Settings(settings)
+	{
+		std::filesystem::path base = std::filesystem::path(m_Settings.AssetRoot).parent_path();
+		if (m_Settings.OutputPak.empty())
+			m_Settings.OutputPak = (base / "assets.chpak").string();
+		if (m_Settings.CacheDirectory.empty())
+			m_Settings.CacheDirectory = (base / ".cherrycook").string();
+
+		uint64_t keyInputs[] = { s_CookVersion, (uint64_t)m_Settings.Texture.Format, (uint64_t)m_Settings.Texture.GenerateMips };
+		m_SettingsHash = Hash::FNV1a(keyInputs, sizeof(keyInputs));
+	}
+
+	bool AssetCooker::Run()
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		std::error_code error;
+		std::filesystem::create_directories(m_Settings.CacheDirectory, error);
+		std::string cachePath = (std::filesystem::path(m_Settings.CacheDirectory) / "cache.txt").string();
+		if (!m_Settings.Force)
+			m_Cache.Load(cachePath);
+
+		std::vector<Asset> assets = Scan();
+		if (!CheckCookedNames(assets))
+			return false;
+
+		// The main thread cooks alongside the workers
+		uint32_t threads = m_Settings.Jobs ? m_Settings.Jobs : std::max(std::thread::hardware_concurrency(), 1u);
+		CH_CLIENT_INFO("Cooking {0} assets from '{1}' on {2} threads", assets.size(), m_Settings.AssetRoot, threads);
+		if (threads > 1)
+		{
+			JobSystem::Init(threads - 1);
+			JobCounter cooking;
+			for (const auto& asset : assets)
+				JobSystem::Run(cooking, [this, &asset]() { Process(asset); });
+			JobSystem::Wait(cooking);
+			JobSystem::Shutdown();
+		}
+		else
+		{
+			for (const auto& asset : assets)
+				Process(asset);
+		}
+
+		std::vector<std::string> live;
+		for (const auto& asset : assets)
+			live.push_back(asset.SourcePath);
+		size_t removed = m_Cache.Prune(live);
+
+		m_Cache.Save(cachePath);
+
+		// Nothing changed and the pak is there: done without touching it
+		bool success = m_FailedCount == 0;
+		if (success && (m_CookedCount > 0 || removed > 0 || !std::filesystem::exists(m_Settings.OutputPak, error)))
+			success = WritePak(assets);
+
+		float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+		CH_CLIENT_INFO("{0} cooked, {1} up to date, {2} failed in {3:.2f}s", m_CookedCount.load(), m_UpToDateCount.load(), m_FailedCount.load(), seconds);
+		return success;
+	}
+
+	std::vector<AssetCooker::Asset> AssetCooker::Scan() const
+	{
+		std::vector<Asset> assets;
+
+		std::filesystem::path root = m_Settings.AssetRoot;
+		std::filesystem::path base = root.parent_path();
+
+		std::error_code error;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(root, error))
+		{
+			if (!entry.is_regular_file())
+				continue;
+
+			std::string extension = ToLower(entry.path().extension().string());
+			// Loose cook outputs are never inputs
+			if (extension == ".chtex" || extension == ".chpak" || extension == ".atlasmap")
+				continue;
+
+			Asset asset;
+			asset.SourcePath = entry.path().lexically_normal().string();
+			asset.VFSPath = entry.path().lexically_relative(base).generic_string();
+
+			if (TextureCooker::IsCookable(asset.SourcePath))
+				asset.Type = AssetType::Texture;
+			else if (extension == ".glsl")
+				asset.Type = AssetType::Shader;
+			else if (extension == ".atlas")
+				asset.Type = AssetType::Atlas;
+			assets.push_back(asset);
+		}
+
+		// Stable pak layout and cache order between runs
+		std::sort(assets.begin(), assets.end(), [](const Asset& a, const Asset& b) { return a.VFSPath < b.VFSPath; });
+		return assets;
+	}
+
+	bool AssetCooker::CheckCookedNames(const std::vector<Asset>& assets) const
+	{
+		// Foo.png and Foo.jpg would both need Foo.chtex; pak paths ignore case, so neither may foo.tga
+		std::unordered_map<std::string, const Asset*> cookedNames;
+		bool unique = true;
+		for (const auto& asset : assets)
+		{
+			if (asset.Type != AssetType::Texture && asset.Type != AssetType::Atlas)
+				continue;
+
+			std::string cookedPath = GetCookedTexturePath(asset.VFSPath);
+			auto [it, inserted] = cookedNames.emplace(VFS::NormalizePath(cookedPath), &asset);
+			if (!inserted)
+			{
+				CH_CLIENT_ERROR("'{0}' and '{1}' both cook to '{2}', rename one of them", it->second->SourcePath, asset.SourcePath, cookedPath);
+				unique = false;
+			}
+		}
+		return unique;
+	}
+
+	uint64_t AssetCooker::ComputeKey(const Asset& asset, const std::vector<std::string>& dependencies)
+	{
+		uint64_t key = Hash::FNV1a(&m_SettingsHash, sizeof(m_SettingsHash));
+		key = Hash::FNV1a(asset.VFSPath, key);
+
+		uint64_t sourceHash = m_Cache.HashFile(asset.SourcePath);
+		key = Hash::FNV1a(&sourceHash, sizeof(sourceHash), key);
+		for (const auto& dependency : dependencies)
+		{
+			uint64_t dependencyHash = m_Cache.HashFile(dependency);
+			key = Hash::FNV1a(dependency, key);
+			key = Hash::FNV1a(&dependencyHash, sizeof(dependencyHash), key);
+		}
+		return key;
+	}
+
+	void AssetCooker::Process(const Asset& asset)
+	{
+		CookCache::Record record;
+		if (!m_Settings.Force && m_Cache.Find(asset.SourcePath, record) && record.Key == ComputeKey(asset, record.Dependencies))
+		{
+			bool outputsPresent = std::all_of(record.Outputs.begin(), record.Outputs.end(),
+				[](const CookCache::Output& output) { return std::filesystem::exists(output.CacheFile); });
+			if (outputsPresent)
+			{
+				m_UpToDateCount++;
+				return;
+			}
+		}
+
+		std::vector<CookedFile> outputs;
+		std::vector<std::string> dependencies;
+		if (!Cook(asset, outputs, dependencies))
+		{
+			CH_CLIENT_ERROR("Failed to cook '{0}'", asset.SourcePath);
+			m_FailedCount++;
+			return;
+		}
+
+		// Dependencies may have changed with the source, key on what was actually read
+		record = CookCache::Record();
+		record.Key = ComputeKey(asset, dependencies);
+		record.Dependencies = dependencies;
+
+		for (const auto& output : outputs)
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)Hash::FNV1a(output.VFSPath));
+			std::string cacheFile = (std::filesystem::path(m_Settings.CacheDirectory) / name).string();
+			if (!WriteFile(cacheFile, output.Data))
+			{
+				CH_CLIENT_ERROR("Could not write '{0}'", cacheFile);
+				m_FailedCount++;
+				return;
+			}
+			record.Outputs.push_back({ output.VFSPath, cacheFile });
+		}
+
+		m_Cache.Store(asset.SourcePath, record);
+		m_CookedCount++;
+		CH_CLIENT_TRACE("Cooked '{0}'", asset.VFSPath);
+	}
+
+	bool AssetCooker::Cook(const Asset& asset, std::vector<CookedFile>& outputs, std::vector<std::string>& dependencies) const
+	{
+		std::string cookedTexturePath = GetCookedTexturePath(asset.VFSPath);
+
+		switch (asset.Type)
+		{
+			case AssetType::Texture:
+			{
+				TextureCooker cooker(m_Settings.Texture);
+				CookedFile texture{ cookedTexturePath };
+				if (!cooker.Cook(asset.SourcePath, texture.Data))
+					return false;
+				outputs.push_back(std::move(texture));
+				return true;
+			}
+			case AssetType::Shader:
+			{
+				ShaderPreprocessor preprocessor;
+				std::string source;
+				if (!preprocessor.Process(asset.SourcePath, source))
+					return false;
+				dependencies = preprocessor.GetDependencies();
+				outputs.push_back({ asset.VFSPath, std::vector<uint8_t>(source.begin(), source.end()) });
+				return true;
+			}
+			case AssetType::Atlas:
+			{
+				AtlasPacker packer;
+				bool packed = packer.Pack(asset.SourcePath);
+				dependencies = packer.GetDependencies();
+				if (!packed)
+					return false;
+
+				// Atlases always carry alpha for their gutters
+				TextureCookSettings settings = m_Settings.Texture;
+				CookedTextureFormat format = settings.Format == CookedTextureFormat::BC1 || settings.Format == CookedTextureFormat::BC3
+					? CookedTextureFormat::BC3 : CookedTextureFormat::RGBA8;
+
+				CookedFile texture{ cookedTexturePath };
+				if (!TextureCooker(settings).CookImage(packer.GetImage(), format, texture.Data))
+					return false;
+				outputs.push_back(std::move(texture));
+
+				const std::string& map = packer.GetMap();
+				std::string mapPath = std::filesystem::path(asset.VFSPath).replace_extension(".atlasmap").generic_string();
+				outputs.push_back({ mapPath, std::vector<uint8_t>(map.begin(), map.end()) });
+				return true;
+			}
+			case AssetType::Raw:
+			{
+				CookedFile file{ asset.VFSPath };
+				if (!ReadFile(asset.SourcePath, file.Data))
+					return false;
+				outputs.push_back(std::move(file));
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool AssetCooker::WritePak(const std::vector<Asset>& assets)
+	{
+		PakWriter pak;
+		for (const auto& asset : assets)
+		{
+			CookCache::Record record;
+			if (!m_Cache.Find(asset.SourcePath, record))
+				continue;
+
+			for (const auto& output : record.Outputs)
+			{
+				std::vector<uint8_t> data;
+				if (!ReadFile(output.CacheFile, data))
+				{
+					CH_CLIENT_ERROR("Cached output '{0}' is missing, run with --force", output.CacheFile);
+					return false;
+				}
+
+				// Textures stay uncompressed so the runtime maps them without a copy
+				bool compress = ToLower(std::filesystem::path(output.VFSPath).extension().string()) != ".chtex";
+				if (!pak.Add(output.VFSPath, std::move(data), compress, PakSourceStamp::FromFile(asset.SourcePath)))
+					return false;
+			}
+		}
+
+		if (!pak.Write(m_Settings.OutputPak))
+			return false;
+
+		CH_CLIENT_INFO("Wrote '{0}' ({1} files)", m_Settings.OutputPak, pak.GetEntryCount());
+		return true;
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "CookCache.h"
+#include "TextureCooker.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace Cherry {
+
+	struct AssetCookSettings
+	{
+		std::string AssetRoot = "../MyShell/assets";
+		std::string OutputPak;			// Default: assets.chpak next to the asset root
+		std::string CacheDirectory;		// Default: .cherrycook next to the asset root
+		TextureCookSettings Texture;
+		uint32_t Jobs = 0;				// 0: every core
+		bool Force = false;
+	};
+
+	// Cooks every asset under the root into runtime formats and packs the results:
+	//   .png/.jpg/.tga/.bmp  ->  .chtex
+	//   .glsl                ->  preprocessed .glsl
+	//   .atlas               ->  packed .chtex + .atlasmap
+	//   anything else        ->  copied
+	// Each asset is keyed on the content hashes of its source, the files it pulled in last time and
+	// the cook settings; unchanged keys reuse the cached outputs. Assets cook in parallel.
+	class AssetCooker
+	{
+	public:
+		explicit AssetCooker(const AssetCookSettings& settings);
+
+		bool Run();
+	private:
+		enum class AssetType { Texture, Shader, Atlas, Raw };
+
+		struct Asset
+		{
+			std::string SourcePath;
+			std::string VFSPath;		// "assets/..." as the runtime asks for it
+			AssetType Type = AssetType::Raw;
+		};
+
+		struct CookedFile
+		{
+			std::string VFSPath;
+			std::vector<uint8_t> Data;
+		};
+
+		std::vector<Asset> Scan() const;
+		bool CheckCookedNames(const std::vector<Asset>& assets) const;
+		void Process(const Asset& asset);
+		bool Cook(const Asset& asset, std::vector<CookedFile>& outputs, std::vector<std::string>& dependencies) const;
+		uint64_t ComputeKey(const Asset& asset, const std::vector<std::string>& dependencies);
+		bool WritePak(const std::vector<Asset>& assets);
+	private:
+		AssetCookSettings m_Settings;
+		uint64_t m_SettingsHash = 0;
+		CookCache m_Cache;
+
+		std::atomic<uint32_t> m_CookedCount = 0, m_UpToDateCount = 0, m_FailedCount = 0;
+	};
+}
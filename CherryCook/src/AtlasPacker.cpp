@@ -0,0 +1,131 @@
+#include "AtlasPacker.h"
+
+#include "Cherry/Core/Log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+namespace Cherry {
+
+	// Transparent gutter so filtering and mips don't bleed between neighbours
+	static constexpr uint32_t s_Padding = 2;
+	static constexpr uint32_t s_MaxSize = 8192;
+
+	struct AtlasRect
+	{
+		uint32_t X = 0, Y = 0;
+	};
+
+	// Shelf packing into a fixed width; returns the height used
+	static uint32_t PackShelves(const std::vector<TextureCooker::Image>& images, const std::vector<size_t>& order, uint32_t width, std::vector<AtlasRect>& rects)
+	{
+		uint32_t x = 0, y = 0, shelfHeight = 0;
+		for (size_t index : order)
+		{
+			uint32_t w = images[index].Width + s_Padding * 2, h = images[index].Height + s_Padding * 2;
+			if (x + w > width)
+			{
+				y += shelfHeight;
+				x = 0;
+				shelfHeight = 0;
+			}
+			rects[index] = { x + s_Padding, y + s_Padding };
+			x += w;
+			shelfHeight = std::max(shelfHeight, h);
+		}
+		return y + shelfHeight;
+	}
+
+	bool AtlasPacker::Pack(const std::string& manifestPath)
+	{
+		m_Dependencies.clear();
+
+		std::ifstream manifest(manifestPath);
+		if (!manifest)
+		{
+			CH_CLIENT_ERROR("Could not open atlas manifest '{0}'", manifestPath);
+			return false;
+		}
+
+		std::vector<std::string> names;
+		std::vector<TextureCooker::Image> images;
+		std::filesystem::path directory = std::filesystem::path(manifestPath).parent_path();
+
+		std::string line;
+		while (std::getline(manifest, line))
+		{
+			line = line.substr(0, line.find('#'));
+			line.erase(0, line.find_first_not_of(" \t\r"));
+			line.erase(line.find_last_not_of(" \t\r") + 1);
+			if (line.empty())
+				continue;
+
+			std::string path = (directory / line).lexically_normal().string();
+			m_Dependencies.push_back(path);
+
+			TextureCooker::Image image;
+			if (!TextureCooker::LoadImage(path, 4, image))
+				return false;
+			names.push_back(line);
+			images.push_back(std::move(image));
+		}
+
+		if (images.empty())
+		{
+			CH_CLIENT_ERROR("Atlas manifest '{0}' lists no images", manifestPath);
+			return false;
+		}
+
+		// Tallest first keeps shelves tight
+		std::vector<size_t> order(images.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return images[a].Height > images[b].Height; });
+
+		uint64_t area = 0;
+		uint32_t widest = 0;
+		for (const auto& image : images)
+		{
+			area += (uint64_t)(image.Width + s_Padding * 2) * (image.Height + s_Padding * 2);
+			widest = std::max(widest, image.Width + s_Padding * 2);
+		}
+
+		// Smallest power of two width that holds the widest image and gives a roughly square result
+		uint32_t width = 1;
+		while (width < widest || (uint64_t)width * width < area)
+			width <<= 1;
+
+		std::vector<AtlasRect> rects(images.size());
+		uint32_t height = PackShelves(images, order, width, rects);
+		if (width > s_MaxSize || height > s_MaxSize)
+		{
+			CH_CLIENT_ERROR("Atlas '{0}' needs {1}x{2}, more than {3}", manifestPath, width, height, s_MaxSize);
+			return false;
+		}
+		// Whole 4x4 blocks for block compression
+		height = (height + 3) & ~3u;
+
+		m_Atlas.Width = width;
+		m_Atlas.Height = height;
+		m_Atlas.Channels = 4;
+		m_Atlas.Pixels.assign((size_t)width * height * 4, 0);
+
+		m_Map = "size " + std::to_string(width) + " " + std::to_string(height) + "\n";
+		for (size_t i = 0; i < images.size(); i++)
+		{
+			const auto& image = images[i];
+			for (uint32_t row = 0; row < image.Height; row++)
+			{
+				memcpy(&m_Atlas.Pixels[((size_t)(rects[i].Y + row) * width + rects[i].X) * 4],
+					&image.Pixels[(size_t)row * image.Width * 4], (size_t)image.Width * 4);
+			}
+
+			m_Map += names[i] + " " + std::to_string(rects[i].X) + " " + std::to_string(rects[i].Y) + " "
+				+ std::to_string(image.Width) + " " + std::to_string(image.Height) + "\n";
+		}
+
+		return true;
+	}
+}
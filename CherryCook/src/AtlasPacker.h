@@ -0,0 +1,26 @@
+#pragma once
+#include "TextureCooker.h"
+
+#include <string>
+#include <vector>
+
+namespace Cherry {
+
+	// Packs the images listed in a .atlas manifest (one path per line relative to the manifest,
+	// '#' starts a comment) into one RGBA texture with a shelf packer.
+	// The companion .atlasmap lists "size <width> <height>" then "<path> <x> <y> <width> <height>"
+	// per image, in pixels from the bottom-left corner like the texture data itself.
+	class AtlasPacker
+	{
+	public:
+		bool Pack(const std::string& manifestPath);
+
+		inline const TextureCooker::Image& GetImage() const { return m_Atlas; }
+		inline const std::string& GetMap() const { return m_Map; }
+		inline const std::vector<std::string>& GetDependencies() const { return m_Dependencies; }
+	private:
+		TextureCooker::Image m_Atlas;
+		std::string m_Map;
+		std::vector<std::string> m_Dependencies;
+	};
+}
@@ -0,0 +1,64 @@
+// CherryCook: offline asset cooker. Converts everything under an asset root into runtime formats
+// and packs the results into a .chpak the engine mounts at startup.
+//
+//   CherryCook [--format rgba8|rgb8|bc1|bc3] [--no-mips] [--force] [--jobs N]
+//              [--output assets.chpak] [--cache dir] [asset root]
+//
+// Without a root the MyShell assets are cooked. Only assets whose sources, includes or settings
+// changed since the last run are cooked again.
+
+#include "AssetCooker.h"
+
+#include "Cherry/Core/Log.h"
+
+#include <stb_image.h>
+
+#include <string>
+
+static bool ParseFormat(const std::string& name, Cherry::CookedTextureFormat& format)
+{
+	if (name == "rgba8")	{ format = Cherry::CookedTextureFormat::RGBA8; return true; }
+	if (name == "rgb8")		{ format = Cherry::CookedTextureFormat::RGB8;  return true; }
+	if (name == "bc1")		{ format = Cherry::CookedTextureFormat::BC1;   return true; }
+	if (name == "bc3")		{ format = Cherry::CookedTextureFormat::BC3;   return true; }
+	return false;
+}
+
+int main(int argc, char** argv)
+{
+	Cherry::Log::Init();
+
+	Cherry::AssetCookSettings settings;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--format" && hasValue)
+		{
+			if (!ParseFormat(argv[++i], settings.Texture.Format))
+			{
+				CH_CLIENT_ERROR("Unknown format '{0}'", argv[i]);
+				return 1;
+			}
+		}
+		else if (arg == "--no-mips")
+			settings.Texture.GenerateMips = false;
+		else if (arg == "--force")
+			settings.Force = true;
+		else if (arg == "--jobs" && hasValue)
+			settings.Jobs = (uint32_t)std::stoul(argv[++i]);
+		else if (arg == "--output" && hasValue)
+			settings.OutputPak = argv[++i];
+		else if (arg == "--cache" && hasValue)
+			settings.CacheDirectory = argv[++i];
+		else
+			settings.AssetRoot = arg;
+	}
+
+	// Stored bottom row first so the engine never flips at load time; stb's flag is global, set it once
+	stbi_set_flip_vertically_on_load(1);
+
+	Cherry::AssetCooker cooker(settings);
+	return cooker.Run() ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+#include "CookCache.h"
+
+#include "Cherry/Core/Hash.h"
+#include "Cherry/Core/Log.h"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+namespace Cherry {
+
+	// Tab separated lines:
+	//   file <path> <size> <time> <hash>
+	//   asset <path> <key>      followed by its
+	//   dep <path>
+	//   out <vfs path> <cache file>
+	//   end                     last line, so a cut-off file is caught
+	static constexpr const char* s_CacheHeader = "CherryCook cache 2";
+
+	template<typename T>
+	static bool ParseNumber(const std::string& text, T& value, int base = 10)
+	{
+		const char* end = text.data() + text.size();
+		auto [last, error] = std::from_chars(text.data(), end, value, base);
+		return error == std::errc() && last == end;
+	}
+
+	bool CookCache::Load(const std::string& path)
+	{
+		std::ifstream in(path);
+		if (!in)
+			return false;
+
+		std::string line;
+		if (!std::getline(in, line) || line != s_CacheHeader)
+		{
+			CH_CLIENT_WARN("Ignoring cook cache '{0}' from another version", path);
+			return false;
+		}
+
+		Record* current = nullptr;
+		bool valid = true, ended = false;
+		while (valid && !ended && std::getline(in, line))
+		{
+			std::vector<std::string> fields;
+			std::stringstream stream(line);
+			std::string field;
+			while (std::getline(stream, field, '\t'))
+				fields.push_back(field);
+			if (fields.empty())
+				continue;
+
+			if (fields[0] == "file" && fields.size() == 5)
+			{
+				FileStamp& stamp = m_Files[fields[1]];
+				valid = ParseNumber(fields[2], stamp.Size) && ParseNumber(fields[3], stamp.Time) && ParseNumber(fields[4], stamp.Hash, 16);
+			}
+			else if (fields[0] == "asset" && fields.size() == 3)
+			{
+				current = &m_Records[fields[1]];
+				valid = ParseNumber(fields[2], current->Key, 16);
+			}
+			else if (fields[0] == "dep" && fields.size() == 2 && current)
+				current->Dependencies.push_back(fields[1]);
+			else if (fields[0] == "out" && fields.size() == 3 && current)
+				current->Outputs.push_back({ fields[1], fields[2] });
+			else if (fields[0] == "end" && fields.size() == 1)
+				ended = true;
+			else
+				valid = false;
+		}
+
+		// A truncated or damaged cache could pass off stale outputs as current: start over instead
+		if (!valid || !ended)
+		{
+			CH_CLIENT_WARN("Cook cache '{0}' is corrupt, cooking everything", path);
+			m_Files.clear();
+			m_Records.clear();
+			return false;
+		}
+		return true;
+	}
+
+	bool CookCache::Save(const std::string& path) const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		std::ofstream out(path, std::ios::out | std::ios::trunc);
+		if (!out)
+		{
+			CH_CLIENT_ERROR("Could not write cook cache '{0}'", path);
+			return false;
+		}
+
+		out << s_CacheHeader << '\n';
+		for (const auto& [file, stamp] : m_Files)
+			out << "file\t" << file << '\t' << stamp.Size << '\t' << stamp.Time << '\t' << std::hex << stamp.Hash << std::dec << '\n';
+
+		for (const auto& [asset, record] : m_Records)
+		{
+			out << "asset\t" << asset << '\t' << std::hex << record.Key << std::dec << '\n';
+			for (const auto& dependency : record.Dependencies)
+				out << "dep\t" << dependency << '\n';
+			for (const auto& output : record.Outputs)
+				out << "out\t" << output.VFSPath << '\t' << output.CacheFile << '\n';
+		}
+		out << "end\n";
+		return (bool)out;
+	}
+
+	uint64_t CookCache::HashFile(const std::string& path)
+	{
+		std::error_code error;
+		uint64_t size = std::filesystem::file_size(path, error);
+		if (error)
+			return 0;
+		int64_t time = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			auto it = m_Files.find(path);
+			if (it != m_Files.end() && it->second.Size == size && it->second.Time == time)
+				return it->second.Hash;
+		}
+
+		std::ifstream in(path, std::ios::in | std::ios::binary);
+		std::vector<char> data(size);
+		in.read(data.data(), size);
+
+		// Empty files still need a nonzero identity
+		uint64_t hash = Hash::FNV1a(data.data(), data.size()) | 1;
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Files[path] = { size, time, hash };
+		return hash;
+	}
+
+	bool CookCache::Find(const std::string& asset, Record& record) const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		auto it = m_Records.find(asset);
+		if (it == m_Records.end())
+			return false;
+		record = it->second;
+		return true;
+	}
+
+	void CookCache::Store(const std::string& asset, const Record& record)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Records[asset] = record;
+	}
+
+	size_t CookCache::Prune(const std::vector<std::string>& liveAssets)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		std::unordered_set<std::string> live(liveAssets.begin(), liveAssets.end());
+		size_t removed = 0;
+		for (auto it = m_Records.begin(); it != m_Records.end(); )
+		{
+			if (live.count(it->first))
+			{
+				++it;
+				continue;
+			}
+			for (const auto& output : it->second.Outputs)
+			{
+				std::error_code error;
+				std::filesystem::remove(output.CacheFile, error);
+			}
+			it = m_Records.erase(it);
+			removed++;
+		}
+		return removed;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Cherry {
+
+	// Persistent record of the last cook: the content hash of every file read and, per asset, the
+	// key its outputs were cooked under. Thread-safe.
+	class CookCache
+	{
+	public:
+		struct Output
+		{
+			std::string VFSPath;
+			std::string CacheFile;
+		};
+
+		struct Record
+		{
+			uint64_t Key = 0;
+			std::vector<std::string> Dependencies;	// Beyond the source itself
+			std::vector<Output> Outputs;
+		};
+
+		bool Load(const std::string& path);
+		bool Save(const std::string& path) const;
+
+		// Content hash, re-read only when the file's size or timestamp changed; 0 if it doesn't exist
+		uint64_t HashFile(const std::string& path);
+
+		bool Find(const std::string& asset, Record& record) const;
+		void Store(const std::string& asset, const Record& record);
+
+		// Drops records of assets that no longer exist, returns how many
+		size_t Prune(const std::vector<std::string>& liveAssets);
+	private:
+		struct FileStamp
+		{
+			uint64_t Size = 0;
+			int64_t Time = 0;
+			uint64_t Hash = 0;
+		};
+
+		mutable std::mutex m_Mutex;
+		std::unordered_map<std::string, FileStamp> m_Files;
+		std::unordered_map<std::string, Record> m_Records;
+	};
+}
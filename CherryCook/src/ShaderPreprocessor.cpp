@@ -0,0 +1,97 @@
+#include "ShaderPreprocessor.h"
+
+#include "Cherry/Core/Log.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace Cherry {
+
+	static constexpr uint32_t s_MaxIncludeDepth = 16;
+
+	bool ShaderPreprocessor::Process(const std::string& path, std::string& output)
+	{
+		m_Dependencies.clear();
+		output.clear();
+		return ProcessFile(path, output, 0);
+	}
+
+	bool ShaderPreprocessor::ProcessFile(const std::string& path, std::string& output, uint32_t depth)
+	{
+		if (depth > s_MaxIncludeDepth)
+		{
+			CH_CLIENT_ERROR("'{0}': includes nested deeper than {1}", path, s_MaxIncludeDepth);
+			return false;
+		}
+
+		std::ifstream in(path, std::ios::in | std::ios::binary);
+		if (!in)
+		{
+			CH_CLIENT_ERROR("Could not open shader '{0}'", path);
+			return false;
+		}
+		std::stringstream buffer;
+		buffer << in.rdbuf();
+
+		std::string line;
+		bool inBlockComment = false;
+		while (std::getline(buffer, line))
+		{
+			// Strip comments, block comments may span lines
+			std::string code;
+			for (size_t i = 0; i < line.size(); i++)
+			{
+				if (inBlockComment)
+				{
+					if (line.compare(i, 2, "*/") == 0)
+					{
+						inBlockComment = false;
+						i++;
+					}
+					continue;
+				}
+				if (line.compare(i, 2, "//") == 0)
+					break;
+				if (line.compare(i, 2, "/*") == 0)
+				{
+					inBlockComment = true;
+					i++;
+					continue;
+				}
+				code += line[i];
+			}
+
+			while (!code.empty() && std::isspace((unsigned char)code.back()))
+				code.pop_back();
+			if (code.empty())
+				continue;
+
+			size_t first = code.find_first_not_of(" \t");
+			if (code.compare(first, 8, "#include") == 0)
+			{
+				size_t open = code.find('"', first), close = code.rfind('"');
+				if (open == std::string::npos || close <= open)
+				{
+					CH_CLIENT_ERROR("'{0}': malformed #include", path);
+					return false;
+				}
+
+				std::string include = (std::filesystem::path(path).parent_path() / code.substr(open + 1, close - open - 1)).lexically_normal().string();
+				if (std::find(m_Dependencies.begin(), m_Dependencies.end(), include) != m_Dependencies.end())
+					continue;
+				m_Dependencies.push_back(include);
+
+				if (!ProcessFile(include, output, depth + 1))
+					return false;
+				continue;
+			}
+
+			output += code;
+			output += '\n';
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Cherry {
+
+	// Resolves #include "file" (relative to the including file, each file once) and strips comments
+	// and blank lines, so the runtime loads a single self-contained source
+	class ShaderPreprocessor
+	{
+	public:
+		bool Process(const std::string& path, std::string& output);
+
+		// Every file pulled in by #include, for dependency tracking
+		inline const std::vector<std::string>& GetDependencies() const { return m_Dependencies; }
+	private:
+		bool ProcessFile(const std::string& path, std::string& output, uint32_t depth);
+	private:
+		std::vector<std::string> m_Dependencies;
+	};
+}
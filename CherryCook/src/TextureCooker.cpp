@@ -0,0 +1,309 @@
+#include "TextureCooker.h"
+
+#include "Cherry/Core/Log.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+
+namespace Cherry {
+
+	namespace {
+
+		struct Color565
+		{
+			uint16_t Packed;
+			uint8_t R, G, B;	// Expanded back to 8 bit, what the GPU will decode
+		};
+
+		Color565 PackColor565(uint8_t r, uint8_t g, uint8_t b)
+		{
+			uint16_t packed = (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+			uint8_t r5 = (packed >> 11) & 0x1f, g6 = (packed >> 5) & 0x3f, b5 = packed & 0x1f;
+			return { packed, (uint8_t)((r5 << 3) | (r5 >> 2)), (uint8_t)((g6 << 2) | (g6 >> 4)), (uint8_t)((b5 << 3) | (b5 >> 2)) };
+		}
+
+		// Bounding box endpoints, inset by 1/16 of the range to cut quantization error at the extremes
+		void EncodeColorBlock(const uint8_t block[16][4], uint8_t* out)
+		{
+			uint8_t minColor[3] = { 255, 255, 255 }, maxColor[3] = { 0, 0, 0 };
+			for (int i = 0; i < 16; i++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					minColor[c] = std::min(minColor[c], block[i][c]);
+					maxColor[c] = std::max(maxColor[c], block[i][c]);
+				}
+			}
+			for (int c = 0; c < 3; c++)
+			{
+				int inset = (maxColor[c] - minColor[c]) >> 4;
+				minColor[c] = (uint8_t)std::min(255, minColor[c] + inset);
+				maxColor[c] = (uint8_t)std::max(0, maxColor[c] - inset);
+			}
+
+			Color565 c0 = PackColor565(maxColor[0], maxColor[1], maxColor[2]);
+			Color565 c1 = PackColor565(minColor[0], minColor[1], minColor[2]);
+			if (c0.Packed < c1.Packed)
+				std::swap(c0, c1);
+
+			uint32_t indices = 0;
+			if (c0.Packed != c1.Packed)
+			{
+				// c0 > c1 selects the four color mode
+				int palette[4][3];
+				for (int c = 0; c < 3; c++)
+				{
+					int e0 = c == 0 ? c0.R : c == 1 ? c0.G : c0.B;
+					int e1 = c == 0 ? c1.R : c == 1 ? c1.G : c1.B;
+					palette[0][c] = e0;
+					palette[1][c] = e1;
+					palette[2][c] = (2 * e0 + e1) / 3;
+					palette[3][c] = (e0 + 2 * e1) / 3;
+				}
+
+				for (int i = 0; i < 16; i++)
+				{
+					int best = 0, bestDistance = INT_MAX;
+					for (int p = 0; p < 4; p++)
+					{
+						int dr = block[i][0] - palette[p][0], dg = block[i][1] - palette[p][1], db = block[i][2] - palette[p][2];
+						int distance = dr * dr + dg * dg + db * db;
+						if (distance < bestDistance)
+						{
+							bestDistance = distance;
+							best = p;
+						}
+					}
+					indices |= (uint32_t)best << (i * 2);
+				}
+			}
+
+			out[0] = (uint8_t)(c0.Packed & 0xff);
+			out[1] = (uint8_t)(c0.Packed >> 8);
+			out[2] = (uint8_t)(c1.Packed & 0xff);
+			out[3] = (uint8_t)(c1.Packed >> 8);
+			for (int i = 0; i < 4; i++)
+				out[4 + i] = (uint8_t)(indices >> (i * 8));
+		}
+
+		void EncodeAlphaBlock(const uint8_t block[16][4], uint8_t* out)
+		{
+			uint8_t minAlpha = 255, maxAlpha = 0;
+			for (int i = 0; i < 16; i++)
+			{
+				minAlpha = std::min(minAlpha, block[i][3]);
+				maxAlpha = std::max(maxAlpha, block[i][3]);
+			}
+
+			// a0 > a1 selects the eight value ramp
+			out[0] = maxAlpha;
+			out[1] = minAlpha;
+
+			uint64_t indices = 0;
+			if (maxAlpha != minAlpha)
+			{
+				int ramp[8];
+				ramp[0] = maxAlpha;
+				ramp[1] = minAlpha;
+				for (int i = 1; i < 7; i++)
+					ramp[i + 1] = ((7 - i) * maxAlpha + i * minAlpha) / 7;
+
+				for (int i = 0; i < 16; i++)
+				{
+					int best = 0, bestDistance = INT_MAX;
+					for (int p = 0; p < 8; p++)
+					{
+						int distance = std::abs(block[i][3] - ramp[p]);
+						if (distance < bestDistance)
+						{
+							bestDistance = distance;
+							best = p;
+						}
+					}
+					indices |= (uint64_t)best << (i * 3);
+				}
+			}
+
+			for (int i = 0; i < 6; i++)
+				out[2 + i] = (uint8_t)(indices >> (i * 8));
+		}
+	}
+
+	bool TextureCooker::IsCookable(const std::string& path)
+	{
+		std::string extension = std::filesystem::path(path).extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+		return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+	}
+
+	bool TextureCooker::LoadImage(const std::string& path, uint32_t channels, Image& image)
+	{
+		int width, height, sourceChannels;
+		stbi_uc* data = stbi_load(path.c_str(), &width, &height, &sourceChannels, (int)channels);
+		if (!data)
+		{
+			CH_CLIENT_ERROR("Failed to decode '{0}': {1}", path, stbi_failure_reason());
+			return false;
+		}
+
+		image.Width = width;
+		image.Height = height;
+		image.Channels = channels ? channels : sourceChannels;
+		image.Pixels.assign(data, data + (size_t)width * height * image.Channels);
+		stbi_image_free(data);
+		return true;
+	}
+
+	bool TextureCooker::Cook(const std::string& sourcePath, std::vector<uint8_t>& output) const
+	{
+		int width, height, channels;
+		if (!stbi_info(sourcePath.c_str(), &width, &height, &channels))
+		{
+			CH_CLIENT_ERROR("Failed to read '{0}'", sourcePath);
+			return false;
+		}
+
+		CookedTextureFormat format = m_Settings.Format;
+		if (format == CookedTextureFormat::None)
+			format = channels == 3 ? CookedTextureFormat::RGB8 : CookedTextureFormat::RGBA8;
+
+		Image image;
+		if (!LoadImage(sourcePath, format == CookedTextureFormat::RGB8 ? 3 : 4, image))
+			return false;
+
+		return CookImage(std::move(image), format, output);
+	}
+
+	bool TextureCooker::CookImage(Image image, CookedTextureFormat format, std::vector<uint8_t>& output) const
+	{
+		if (format == CookedTextureFormat::BC7)
+		{
+			CH_CLIENT_ERROR("BC7 encoding is not supported, cook as BC1 or BC3");
+			return false;
+		}
+		if (format == CookedTextureFormat::RGB8 && image.Channels != 3)
+		{
+			CH_CLIENT_ERROR("RGB8 needs a 3 channel image");
+			return false;
+		}
+
+		std::vector<std::vector<uint8_t>> levels;
+		std::vector<CookedTextureMip> mips;
+		while (true)
+		{
+			CookedTextureMip mip;
+			mip.Width = image.Width;
+			mip.Height = image.Height;
+			mip.Size = CookedTexture::GetMipSize(format, image.Width, image.Height);
+			mips.push_back(mip);
+
+			if (CookedTexture::IsCompressed(format))
+			{
+				levels.emplace_back();
+				EncodeBC(image, format, levels.back());
+			}
+			else
+				levels.push_back(image.Pixels);
+
+			if (!m_Settings.GenerateMips || (image.Width == 1 && image.Height == 1))
+				break;
+			image = Downsample(image);
+		}
+
+		Serialize(format, levels, mips, output);
+		return true;
+	}
+
+	TextureCooker::Image TextureCooker::Downsample(const Image& source)
+	{
+		Image result;
+		result.Width = std::max(1u, source.Width / 2);
+		result.Height = std::max(1u, source.Height / 2);
+		result.Channels = source.Channels;
+		result.Pixels.resize((size_t)result.Width * result.Height * result.Channels);
+
+		// 2x2 box filter, odd edges reuse the last row/column
+		for (uint32_t y = 0; y < result.Height; y++)
+		{
+			uint32_t y0 = std::min(y * 2, source.Height - 1), y1 = std::min(y * 2 + 1, source.Height - 1);
+			for (uint32_t x = 0; x < result.Width; x++)
+			{
+				uint32_t x0 = std::min(x * 2, source.Width - 1), x1 = std::min(x * 2 + 1, source.Width - 1);
+				for (uint32_t c = 0; c < source.Channels; c++)
+				{
+					uint32_t sum = source.Pixels[((size_t)y0 * source.Width + x0) * source.Channels + c]
+						+ source.Pixels[((size_t)y0 * source.Width + x1) * source.Channels + c]
+						+ source.Pixels[((size_t)y1 * source.Width + x0) * source.Channels + c]
+						+ source.Pixels[((size_t)y1 * source.Width + x1) * source.Channels + c];
+					result.Pixels[((size_t)y * result.Width + x) * result.Channels + c] = (uint8_t)((sum + 2) / 4);
+				}
+			}
+		}
+		return result;
+	}
+
+	void TextureCooker::EncodeBC(const Image& image, CookedTextureFormat format, std::vector<uint8_t>& out)
+	{
+		uint32_t blocksX = std::max(1u, (image.Width + 3) / 4);
+		uint32_t blocksY = std::max(1u, (image.Height + 3) / 4);
+		uint32_t blockBytes = CookedTexture::GetBlockBytes(format);
+		out.resize((size_t)blocksX * blocksY * blockBytes);
+
+		uint8_t* dst = out.data();
+		for (uint32_t by = 0; by < blocksY; by++)
+		{
+			for (uint32_t bx = 0; bx < blocksX; bx++)
+			{
+				// Gather the block, clamping at the edges of non multiple of 4 images
+				uint8_t block[16][4];
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					uint32_t x = std::min(bx * 4 + i % 4, image.Width - 1);
+					uint32_t y = std::min(by * 4 + i / 4, image.Height - 1);
+					const uint8_t* pixel = &image.Pixels[((size_t)y * image.Width + x) * image.Channels];
+					for (uint32_t c = 0; c < 4; c++)
+						block[i][c] = c < image.Channels ? pixel[c] : 255;
+				}
+
+				if (format == CookedTextureFormat::BC3)
+				{
+					EncodeAlphaBlock(block, dst);
+					EncodeColorBlock(block, dst + 8);
+				}
+				else
+					EncodeColorBlock(block, dst);
+				dst += blockBytes;
+			}
+		}
+	}
+
+	void TextureCooker::Serialize(CookedTextureFormat format, const std::vector<std::vector<uint8_t>>& levels, const std::vector<CookedTextureMip>& mips, std::vector<uint8_t>& output)
+	{
+		CookedTextureHeader header;
+		header.Format = format;
+		header.Width = mips[0].Width;
+		header.Height = mips[0].Height;
+		header.MipCount = (uint32_t)mips.size();
+		header.Flags = CookedTextureFlag_FlippedVertically;
+
+		// Level data starts 16 byte aligned so mapped pointers are aligned as well
+		std::vector<CookedTextureMip> table = mips;
+		uint64_t offset = sizeof(CookedTextureHeader) + table.size() * sizeof(CookedTextureMip);
+		for (auto& mip : table)
+		{
+			offset = (offset + 15) & ~15ull;
+			mip.Offset = offset;
+			offset += mip.Size;
+		}
+
+		output.assign(offset, 0);
+		memcpy(output.data(), &header, sizeof(header));
+		memcpy(output.data() + sizeof(header), table.data(), table.size() * sizeof(CookedTextureMip));
+		for (size_t level = 0; level < levels.size(); level++)
+			memcpy(output.data() + table[level].Offset, levels[level].data(), levels[level].size());
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "Cherry/Renderer/CookedTexture.h"
+
+#include <string>
+#include <vector>
+
+namespace Cherry {
+
+	struct TextureCookSettings
+	{
+		// RGBA8/RGB8 keep the source channel count, BC1/BC3 always encode 4 channels
+		CookedTextureFormat Format = CookedTextureFormat::None;	// None: RGBA8 or RGB8 by source channels
+		bool GenerateMips = true;
+	};
+
+	// Converts decoded images into .chtex bytes. Stateless and safe to use from several threads;
+	// expects stbi_set_flip_vertically_on_load(1) to have been set once at startup.
+	class TextureCooker
+	{
+	public:
+		// Bottom row first, tightly packed
+		struct Image
+		{
+			std::vector<uint8_t> Pixels;
+			uint32_t Width = 0, Height = 0, Channels = 0;
+		};
+
+		explicit TextureCooker(const TextureCookSettings& settings)
+			: m_Settings(settings) {}
+
+		bool Cook(const std::string& sourcePath, std::vector<uint8_t>& output) const;
+		bool CookImage(Image image, CookedTextureFormat format, std::vector<uint8_t>& output) const;
+
+		// channels 0 keeps the source's own count
+		static bool LoadImage(const std::string& path, uint32_t channels, Image& image);
+		static bool IsCookable(const std::string& path);
+	private:
+		static Image Downsample(const Image& source);
+		static void EncodeBC(const Image& image, CookedTextureFormat format, std::vector<uint8_t>& out);
+		static void Serialize(CookedTextureFormat format, const std::vector<std::vector<uint8_t>>& levels, const std::vector<CookedTextureMip>& mips, std::vector<uint8_t>& output);
+	private:
+		TextureCookSettings m_Settings;
+	};
+}
@@ -0,0 +1,206 @@
+// CherryTraceTool: reads the engine's binary .chtrace profiles, converts them to Chrome/Perfetto JSON
+// and prints where the time went.
+//
+//   CherryTraceTool <trace.chtrace> [--json out.json] [--from ms] [--to ms]
+//                   [--thread id|name]... [--top N] [--self]
+//   CherryTraceTool --overhead
+//
+// --from/--to are milliseconds from the start of the session and keep scopes starting in that range;
+// --thread may be repeated. The summary lists the N scopes with the most total (or --self) time.
+// --overhead measures what a CH_PROFILE_SCOPE costs on this machine instead.
+
+#include "TraceReader.h"
+#include "TraceSummary.h"
+
+#include "Cherry/Core/Log.h"
+#include "Cherry/Debug/Instrumentor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+static bool MatchesThread(const Cherry::TraceThread& thread, const std::vector<std::string>& filters)
+{
+	if (filters.empty())
+		return true;
+
+	for (const auto& filter : filters)
+	{
+		if (filter == thread.Name || filter == std::to_string(thread.ID))
+			return true;
+	}
+	return false;
+}
+
+static bool WriteJSON(const std::string& path, const std::vector<Cherry::TraceThread>& threads, int64_t startTime)
+{
+	std::FILE* file = std::fopen(path.c_str(), "wb");
+	if (!file)
+	{
+		CH_CLIENT_ERROR("Could not create '{0}'", path);
+		return false;
+	}
+
+	Cherry::JSONTraceWriter writer;
+	std::string& output = writer.GetOutput();
+	writer.Begin(startTime);
+	for (const auto& thread : threads)
+	{
+		if (!thread.Name.empty())
+			writer.WriteThreadName(thread.ID, thread.Name);
+
+		for (const auto& event : thread.Events)
+		{
+			writer.WriteEvent(event);
+			if (output.size() >= (1 << 20))
+			{
+				std::fwrite(output.data(), 1, output.size(), file);
+				output.clear();
+			}
+		}
+	}
+	writer.End();
+	std::fwrite(output.data(), 1, output.size(), file);
+	std::fclose(file);
+	return true;
+}
+
+static void PrintSummary(const std::vector<Cherry::ScopeStats>& stats, uint32_t top)
+{
+	auto ms = [](int64_t nanoseconds) { return (double)nanoseconds / 1e6; };
+
+	std::printf("%12s %12s %12s %10s %10s  %s\n", "total ms", "self ms", "count", "p50 ms", "p99 ms", "scope");
+	for (size_t i = 0; i < stats.size() && i < top; i++)
+	{
+		const auto& scope = stats[i];
+		std::printf("%12.3f %12.3f %12llu %10.4f %10.4f  %s\n", ms(scope.Total), ms(scope.Self),
+			(unsigned long long)scope.Count, ms(scope.P50), ms(scope.P99), scope.Name.c_str());
+	}
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define CH_NOINLINE __attribute__((noinline))
+#else
+	#define CH_NOINLINE __declspec(noinline)
+#endif
+
+static CH_NOINLINE void EmptyFunction() {}
+static CH_NOINLINE void ProfiledFunction() { CH_PROFILE_SCOPE("Overhead"); }
+static CH_NOINLINE uint64_t ReadClock() { return Cherry::ProfileClock::Now(); }
+
+// Nanoseconds per call of fn, median of batches small enough for the ring buffers to keep up
+template<typename Fn>
+static double MeasureCall(Fn fn)
+{
+	constexpr uint32_t batchSize = 4096, batchCount = 64;
+	std::vector<double> batches;
+	for (uint32_t batch = 0; batch < batchCount; batch++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < batchSize; i++)
+			fn();
+		batches.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / batchSize);
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	std::nth_element(batches.begin(), batches.begin() + batchCount / 2, batches.end());
+	return batches[batchCount / 2];
+}
+
+// Scope cost with and without a session. Two clock reads are the floor for any scope, so they are
+// reported apart from what the Instrumentor itself adds.
+static void MeasureOverhead()
+{
+	double call = MeasureCall(EmptyFunction);
+	double clock = MeasureCall(ReadClock) - call;
+	double inactive = MeasureCall(ProfiledFunction) - call;
+
+	// Flight recording keeps events in memory, so the file system stays out of the numbers
+	Cherry::Instrumentor::Get().BeginFlightRecording(1.0f);
+	double active = MeasureCall(ProfiledFunction) - call;
+	Cherry::Instrumentor::Get().EndSession();
+
+	std::printf("clock read              %6.1f ns\n", clock);
+	std::printf("scope, no session       %6.1f ns\n", inactive);
+	std::printf("scope, recording        %6.1f ns\n", active);
+	std::printf("  of which clock reads  %6.1f ns\n", 2.0 * clock);
+	std::printf("  of which recording    %6.1f ns\n", active - 2.0 * clock);
+}
+
+int main(int argc, char** argv)
+{
+	Cherry::Log::Init();
+
+	std::string input, jsonOutput;
+	double fromMs = 0.0, toMs = std::numeric_limits<double>::infinity();
+	std::vector<std::string> threadFilters;
+	uint32_t top = 20;
+	bool sortBySelf = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--json" && hasValue)
+			jsonOutput = argv[++i];
+		else if (arg == "--from" && hasValue)
+			fromMs = std::stod(argv[++i]);
+		else if (arg == "--to" && hasValue)
+			toMs = std::stod(argv[++i]);
+		else if (arg == "--thread" && hasValue)
+			threadFilters.push_back(argv[++i]);
+		else if (arg == "--top" && hasValue)
+			top = (uint32_t)std::stoul(argv[++i]);
+		else if (arg == "--self")
+			sortBySelf = true;
+		else if (arg == "--overhead")
+		{
+			MeasureOverhead();
+			return 0;
+		}
+		else
+			input = arg;
+	}
+
+	if (input.empty())
+	{
+		CH_CLIENT_ERROR("Usage: CherryTraceTool <trace.chtrace> [--json out.json] [--from ms] [--to ms] [--thread id|name]... [--top N] [--self] | --overhead");
+		return 1;
+	}
+
+	Cherry::TraceReader reader;
+	if (!reader.Load(input))
+		return 1;
+
+	int64_t from = reader.GetStartTime() + (int64_t)(fromMs * 1e6);
+	int64_t to = toMs == std::numeric_limits<double>::infinity() ? std::numeric_limits<int64_t>::max() : reader.GetStartTime() + (int64_t)(toMs * 1e6);
+
+	std::vector<Cherry::TraceThread> threads;
+	size_t eventCount = 0;
+	for (const auto& [id, thread] : reader.GetThreads())
+	{
+		if (!MatchesThread(thread, threadFilters))
+			continue;
+
+		Cherry::TraceThread& filtered = threads.emplace_back();
+		filtered.ID = thread.ID;
+		filtered.Name = thread.Name;
+		for (const auto& event : thread.Events)
+		{
+			if (event.Start >= from && event.Start <= to)
+				filtered.Events.push_back(event);
+		}
+		eventCount += filtered.Events.size();
+	}
+
+	CH_CLIENT_INFO("{0}: {1} events on {2} threads", input, eventCount, threads.size());
+
+	if (!jsonOutput.empty() && !WriteJSON(jsonOutput, threads, reader.GetStartTime()))
+		return 1;
+
+	PrintSummary(Cherry::SummarizeScopes(threads, sortBySelf), top);
+	return 0;
+}
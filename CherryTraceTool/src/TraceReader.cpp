@@ -0,0 +1,117 @@
+#include "TraceReader.h"
+
+#include "Cherry/Core/Log.h"
+#include "Cherry/Core/MappedFile.h"
+
+#include <cstring>
+
+namespace Cherry {
+
+	bool TraceReader::Load(const std::string& path)
+	{
+		MappedFile file(path);
+		if (!file.IsOpen())
+		{
+			CH_CLIENT_ERROR("Could not open trace '{0}'", path);
+			return false;
+		}
+
+		TraceHeader header;
+		if (file.GetSize() < sizeof(header))
+		{
+			CH_CLIENT_ERROR("'{0}' is too small to be a trace", path);
+			return false;
+		}
+		std::memcpy(&header, file.GetData(), sizeof(header));
+		if (header.Magic != TraceHeader::s_Magic || header.Version != TraceHeader::s_Version)
+		{
+			CH_CLIENT_ERROR("'{0}' is not a version {1} .chtrace", path, TraceHeader::s_Version);
+			return false;
+		}
+
+		m_StartTime = header.StartTime;
+		if (!Parse(file.GetData() + sizeof(header), file.GetData() + file.GetSize()))
+		{
+			// A session killed mid-write leaves a torn last record; everything before it is still good
+			CH_CLIENT_WARN("'{0}' is truncated or corrupt, reading what precedes the damage", path);
+		}
+		return true;
+	}
+
+	bool TraceReader::Parse(const uint8_t* data, const uint8_t* end)
+	{
+		while (data < end)
+		{
+			TraceRecord record = (TraceRecord)*data++;
+			switch (record)
+			{
+			case TraceRecord::String:
+			{
+				uint64_t id, length;
+				if (!Varint::Read(data, end, id) || !Varint::Read(data, end, length) || length > (uint64_t)(end - data))
+					return false;
+
+				m_Strings.emplace_back((const char*)data, (size_t)length);
+				data += length;
+				if (id >= m_StringByID.size())
+					m_StringByID.resize(id + 1, "");
+				m_StringByID[id] = m_Strings.back().c_str();
+				break;
+			}
+			case TraceRecord::Thread:
+			{
+				uint64_t threadID, nameID;
+				if (!Varint::Read(data, end, threadID) || !Varint::Read(data, end, nameID) || nameID >= m_StringByID.size())
+					return false;
+
+				TraceThread& thread = m_Threads[(uint32_t)threadID];
+				thread.ID = (uint32_t)threadID;
+				thread.Name = m_StringByID[nameID];
+				break;
+			}
+			case TraceRecord::Events:
+			{
+				uint64_t threadID, count;
+				if (!Varint::Read(data, end, threadID) || !Varint::Read(data, end, count))
+					return false;
+
+				TraceThread& thread = m_Threads[(uint32_t)threadID];
+				thread.ID = (uint32_t)threadID;
+				int64_t& previousStart = m_PreviousStarts[(uint32_t)threadID];
+				for (uint64_t i = 0; i < count; i++)
+				{
+					if (data >= end)
+						return false;
+					ProfileEventType type = (ProfileEventType)*data++;
+
+					uint64_t nameID;
+					int64_t delta;
+					if (!Varint::Read(data, end, nameID) || nameID >= m_StringByID.size() || !Varint::ReadSigned(data, end, delta))
+						return false;
+
+					TraceEvent event{ m_StringByID[nameID], 0, 0, (uint32_t)threadID, type };
+					previousStart += delta;
+					event.Start = m_StartTime + previousStart;
+					if (type == ProfileEventType::Counter)
+					{
+						if (!Varint::ReadSigned(data, end, event.End))
+							return false;
+					}
+					else
+					{
+						uint64_t duration;
+						if (!Varint::Read(data, end, duration))
+							return false;
+						event.End = event.Start + (int64_t)duration;
+					}
+					thread.Events.push_back(event);
+				}
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "Cherry/Debug/TraceWriter.h"
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Cherry {
+
+	struct TraceThread
+	{
+		uint32_t ID = 0;
+		std::string Name;
+		std::vector<TraceEvent> Events;		// Times absolute, in nanoseconds
+	};
+
+	// Loads a whole .chtrace into memory
+	class TraceReader
+	{
+	public:
+		bool Load(const std::string& path);
+
+		inline int64_t GetStartTime() const { return m_StartTime; }
+		inline const std::map<uint32_t, TraceThread>& GetThreads() const { return m_Threads; }
+
+	private:
+		bool Parse(const uint8_t* data, const uint8_t* end);
+
+	private:
+		int64_t m_StartTime = 0;
+		// Deque so event name pointers stay valid as strings are added
+		std::deque<std::string> m_Strings;
+		std::vector<const char*> m_StringByID;
+		std::map<uint32_t, TraceThread> m_Threads;
+		std::map<uint32_t, int64_t> m_PreviousStarts;
+	};
+}
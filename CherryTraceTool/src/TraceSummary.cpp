@@ -0,0 +1,80 @@
+#include "TraceSummary.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace Cherry {
+
+	static int64_t Percentile(std::vector<int64_t>& durations, double percentile)
+	{
+		size_t index = std::min(durations.size() - 1, (size_t)(percentile * (double)durations.size()));
+		std::nth_element(durations.begin(), durations.begin() + index, durations.end());
+		return durations[index];
+	}
+
+	std::vector<ScopeStats> SummarizeScopes(const std::vector<TraceThread>& threads, bool sortBySelf)
+	{
+		std::unordered_map<std::string, ScopeStats> stats;
+		std::unordered_map<std::string, std::vector<int64_t>> durations;
+
+		for (const auto& thread : threads)
+		{
+			std::vector<const TraceEvent*> scopes;
+			for (const auto& event : thread.Events)
+			{
+				if (event.Type == ProfileEventType::Scope)
+					scopes.push_back(&event);
+			}
+
+			// Parents before their children: earlier start first, longer first on ties
+			std::sort(scopes.begin(), scopes.end(), [](const TraceEvent* a, const TraceEvent* b)
+				{
+					return a->Start != b->Start ? a->Start < b->Start : a->End > b->End;
+				});
+
+			std::vector<int64_t> self(scopes.size());
+			std::vector<size_t> stack;
+			for (size_t i = 0; i < scopes.size(); i++)
+			{
+				const TraceEvent& scope = *scopes[i];
+				while (!stack.empty() && scopes[stack.back()]->End <= scope.Start)
+					stack.pop_back();
+
+				self[i] = scope.End - scope.Start;
+				if (!stack.empty())
+				{
+					// Only the part that overlaps the parent, in case clock skew lets a child poke out
+					const TraceEvent& parent = *scopes[stack.back()];
+					self[stack.back()] -= std::min(scope.End, parent.End) - scope.Start;
+				}
+				stack.push_back(i);
+			}
+
+			for (size_t i = 0; i < scopes.size(); i++)
+			{
+				ScopeStats& entry = stats[scopes[i]->Name];
+				entry.Count++;
+				entry.Total += scopes[i]->End - scopes[i]->Start;
+				entry.Self += self[i];
+				durations[scopes[i]->Name].push_back(scopes[i]->End - scopes[i]->Start);
+			}
+		}
+
+		std::vector<ScopeStats> result;
+		result.reserve(stats.size());
+		for (auto& [name, entry] : stats)
+		{
+			entry.Name = name;
+			std::vector<int64_t>& scopeDurations = durations[name];
+			entry.P50 = Percentile(scopeDurations, 0.50);
+			entry.P99 = Percentile(scopeDurations, 0.99);
+			result.push_back(std::move(entry));
+		}
+
+		std::sort(result.begin(), result.end(), [sortBySelf](const ScopeStats& a, const ScopeStats& b)
+			{
+				return sortBySelf ? a.Self > b.Self : a.Total > b.Total;
+			});
+		return result;
+	}
+}
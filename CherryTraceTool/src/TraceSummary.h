@@ -0,0 +1,21 @@
+#pragma once
+#include "TraceReader.h"
+
+#include <string>
+#include <vector>
+
+namespace Cherry {
+
+	struct ScopeStats
+	{
+		std::string Name;
+		uint64_t Count = 0;
+		int64_t Total = 0;		// Inclusive, nanoseconds
+		int64_t Self = 0;		// Total minus time in nested scopes on the same thread
+		int64_t P50 = 0;
+		int64_t P99 = 0;
+	};
+
+	// Per scope name across every thread, sorted by descending total (or self) time
+	std::vector<ScopeStats> SummarizeScopes(const std::vector<TraceThread>& threads, bool sortBySelf);
+}
@@ -124,6 +124,7 @@ public:
 		)";
 
 		m_FlatColorShader = Cherry::Shader::Create("FlatColor", flatColorShaderVertexSrc, flatColorShaderFragmentSrc);
+		m_FlatColorMaterial = Cherry::Material::Create(m_FlatColorShader);
 
 		auto textureShader = m_ShaderLibrary.Load("assets/shaders/Texture.glsl");
 
@@ -147,8 +148,8 @@ public:
 
 		glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(0.1f));
 
-		m_FlatColorShader->Bind();
-		m_FlatColorShader->SetFloat3("u_Color", m_SquareColor);
+		// Only re-uploaded when the color actually changes
+		m_FlatColorMaterial->SetFloat3("u_Color", m_SquareColor);
 
 		for (int y = 0; y < 20; y++)
 		{
@@ -156,7 +157,7 @@ public:
 			{
 				glm::vec3 pos(x * 0.11f, y * 0.11f, 0.0f);
 				glm::mat4 transform = glm::translate(glm::mat4(1.0f), pos) * scale;
-				Cherry::Renderer::Submit(m_FlatColorShader, m_SquareVA, transform);
+				Cherry::Renderer::Submit(m_FlatColorMaterial, m_SquareVA, transform);
 			}
 		}
 
@@ -190,6 +191,7 @@ private:
 	Cherry::SmartPointer::Ref<Cherry::VertexArray> m_VertexArray;
 
 	Cherry::SmartPointer::Ref<Cherry::Shader> m_FlatColorShader;
+	Cherry::SmartPointer::Ref<Cherry::Material> m_FlatColorMaterial;
 	Cherry::SmartPointer::Ref<Cherry::VertexArray> m_SquareVA;
 
 	Cherry::SmartPointer::Ref<Cherry::Texture2D> m_Texture, m_ChernoLogoTexture;
@@ -16,7 +16,7 @@ void Sandbox2D::OnAttach()
 {
     CH_PROFILE_FUNCTION();
 
-    m_CheckerboardTexture = Cherry::Texture2D::Create("assets/textures/Checkerboard.png");
+    m_CheckerboardTexture = Cherry::Texture2D::CreateAsync("assets/textures/Checkerboard.png");
 }
 
 void Sandbox2D::OnDetach()
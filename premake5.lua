@@ -74,8 +74,7 @@ project "Cherry"
 	{ 
 		"GLFW",
 		"Glad",
-		"ImGui",
-		"opengl32.lib"
+		"ImGui"
 	}
 
     -- Windows-specific settings
@@ -90,6 +89,19 @@ project "Cherry"
 			"GLFW_INCLUDE_NONE"
 		}
 
+		links { "opengl32.lib" }
+		removefiles { "%{prj.name}/src/Platform/Linux/**" }
+
+    -- Linux (gmake2): EGL/OSMesa for headless contexts are loaded at runtime, not linked
+    filter "system:linux"
+		defines
+		{
+			"CH_PLATFORM_LINUX",
+			"GLFW_INCLUDE_NONE"
+		}
+
+		removefiles { "%{prj.name}/src/Platform/Windows/**" }
+
 	filter "configurations:Debug"
 		defines "CH_DEBUG"
 		runtime "Debug"
@@ -101,7 +113,7 @@ project "Cherry"
 		optimize "on"
 
 	filter "configurations:Dist"
-		defines "CH_DIST"
+		defines { "CH_DIST", "CH_PROFILE=0" }
 		runtime "Release"
 		optimize "on"
 
@@ -134,6 +146,13 @@ project "MyShell"
 		"Cherry"
 	}
 
+	-- Cook textures before every build; up-to-date outputs are skipped
+	dependson { "CherryCook" }
+	prebuildcommands
+	{
+		"\"%{wks.location}bin/" .. outputdir .. "/CherryCook/CherryCook\" \"%{prj.location}assets\""
+	}
+
     -- Windows-specific settings
     filter "system:windows"
         systemversion "latest"
@@ -144,6 +163,15 @@ project "MyShell"
 			"CH_PLATFORM_WINDOWS"
 		}
 
+    -- Static libraries do not carry their dependencies with gmake2
+    filter "system:linux"
+		defines
+		{
+			"CH_PLATFORM_LINUX"
+		}
+
+		links { "GLFW", "Glad", "ImGui", "dl", "pthread" }
+
 	filter "configurations:Debug"
 		defines "CH_DEBUG"
 		runtime "Debug"
@@ -155,6 +183,133 @@ project "MyShell"
 		optimize "on"
 
 	filter "configurations:Dist"
-		defines "CH_DIST"
+		defines { "CH_DIST", "CH_PROFILE=0" }
 		runtime "Release"
-		optimize "on"
\ No newline at end of file
+		optimize "on"
+
+project "CherryCook"
+	location "CherryCook"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "on"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp"
+	}
+
+	includedirs
+	{
+		"Cherry/vendor/spdlog/include",
+		"Cherry/src",
+		"Cherry/vendor",
+		"%{IncludeDir.glm}",
+		"%{IncludeDir.stb_image}"
+	}
+
+	links
+	{
+		"Cherry"
+	}
+
+    -- Windows-specific settings
+    filter "system:windows"
+        systemversion "latest"
+        buildoptions { "/utf-8" }
+
+		defines
+		{
+			"CH_PLATFORM_WINDOWS"
+		}
+
+    -- Static libraries do not carry their dependencies with gmake2
+    filter "system:linux"
+		defines
+		{
+			"CH_PLATFORM_LINUX"
+		}
+
+		links { "GLFW", "Glad", "ImGui", "dl", "pthread" }
+
+	filter "configurations:Debug"
+		defines "CH_DEBUG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "CH_RELEASE"
+		runtime "Release"
+		optimize "on"
+
+	filter "configurations:Dist"
+		defines { "CH_DIST", "CH_PROFILE=0" }
+		runtime "Release"
+		optimize "on"
+
+project "CherryTraceTool"
+	location "CherryTraceTool"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "on"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/src/**.h",
+		"%{prj.name}/src/**.cpp"
+	}
+
+	includedirs
+	{
+		"Cherry/vendor/spdlog/include",
+		"Cherry/src",
+		"Cherry/vendor",
+		"%{IncludeDir.glm}"
+	}
+
+	links
+	{
+		"Cherry"
+	}
+
+    -- Windows-specific settings
+    filter "system:windows"
+        systemversion "latest"
+        buildoptions { "/utf-8" }
+
+		defines
+		{
+			"CH_PLATFORM_WINDOWS"
+		}
+
+    -- Static libraries do not carry their dependencies with gmake2
+    filter "system:linux"
+		defines
+		{
+			"CH_PLATFORM_LINUX"
+		}
+
+		links { "GLFW", "Glad", "ImGui", "dl", "pthread" }
+
+	filter "configurations:Debug"
+		defines "CH_DEBUG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "CH_RELEASE"
+		runtime "Release"
+		optimize "on"
+
+	filter "configurations:Dist"
+		defines { "CH_DIST", "CH_PROFILE=0" }
+		runtime "Release"
+		optimize "on"
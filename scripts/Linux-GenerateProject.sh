@@ -0,0 +1,3 @@
+#!/bin/sh
+cd "$(dirname "$0")/.."
+vendor/bin/premake/premake5 gmake2